@@ -8,7 +8,13 @@
  * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
  */
 #include <stdexcept>
-#include "api.h"
+#include "Api.h"
+
+#ifdef POWSYBL_POWERFACTORY_STUB_ENGINE
+
+#include "StubEngine.h"
+
+#else
 
 extern "C" {
 
@@ -17,10 +23,28 @@ typedef void (__cdecl *DESTROYAPI)(api::v2::Api*&);
 
 }
 
+#endif
+
 namespace powsybl {
 
 namespace powerfactory {
 
+#ifdef POWSYBL_POWERFACTORY_STUB_ENGINE
+
+// the synthetic engine is configured by the PowerFactory home, see StubConfig
+Api::Api(const std::string& powerFactoryHome)
+    : _api(stub::createApi(powerFactoryHome)) {
+}
+
+Api::~Api() {
+    for (auto object : _registry.getObjects()) {
+        _api->ReleaseObject(object);
+    }
+    stub::destroyApi(_api);
+}
+
+#else
+
 Api::Api(const std::string& powerFactoryHome) {
     _dllHandle = LoadLibraryEx(TEXT((powerFactoryHome + R"(\digapi.dll)").c_str()),
                                nullptr,
@@ -41,8 +65,7 @@ Api::Api(const std::string& powerFactoryHome) {
 Api::~Api() {
     if (_dllHandle) {
         // release objects
-        for (auto it = _objectToId.begin(); it != _objectToId.end(); it++) {
-            auto object = it->first;
+        for (auto object : _registry.getObjects()) {
             _api->ReleaseObject(object);
         }
 
@@ -55,30 +78,31 @@ Api::~Api() {
     }
 }
 
+#endif
+
 long Api::addObject(api::v2::DataObject* object) {
-    if (object) {
-        auto it = _objectToId.find(object);
-        if (it == _objectToId.end()) {
-            long id = _objectToId.size();
-            _objectToId.insert({object, id});
-            return id;
-        }
-        return it->second;
-    }
-    return -1;
+    return _registry.add(object);
+}
+
+void Api::addObjects(const std::vector<api::v2::DataObject*>& objects) {
+    _registry.addAll(objects);
 }
 
 long Api::getObjectId(api::v2::DataObject* object) const {
     if (object) {
-        auto it = _objectToId.find(object);
-        if (it == _objectToId.end()) {
+        long id = _registry.find(object);
+        if (id == -1) {
             throw std::runtime_error("Object not found");
         }
-        return it->second;
+        return id;
     }
     return -1;
 }
 
+api::v2::DataObject* Api::getObject(long id) const {
+    return _registry.get(id);
+}
+
 api::v2::DataObject* Api::activateProject(const std::string& projectName) {
     auto app = _api->GetApplication();
     api::Value nameVal(projectName.c_str());
@@ -91,15 +115,14 @@ api::v2::DataObject* Api::activateProject(const std::string& projectName) {
     return project;
 }
 
-std::vector<api::v2::DataObject*> Api::getChildren(const api::v2::DataObject& parent) {
+std::vector<api::v2::DataObject*> Api::getChildren(const api::v2::DataObject& parent, bool recursive) {
     std::vector<api::v2::DataObject*> children;
-    auto childrenVal= makeValueUniquePtr(parent.GetChildren(false));
+    auto childrenVal= makeValueUniquePtr(parent.GetChildren(recursive));
     children.reserve(childrenVal->VecGetSize());
     for (size_t i = 0; i < childrenVal->VecGetSize(); ++i) {
-        auto child = static_cast<api::v2::DataObject*>(childrenVal->VecGetDataObject(i));
-        addObject(child);
-        children.push_back(child);
+        children.push_back(static_cast<api::v2::DataObject*>(childrenVal->VecGetDataObject(i)));
     }
+    addObjects(children);
     return children;
 }
 
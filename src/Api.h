@@ -13,9 +13,11 @@
 #include <memory>
 #include <string>
 #include <vector>
-#include <map>
+#ifndef POWSYBL_POWERFACTORY_STUB_ENGINE
 #include <Windows.h>
+#endif
 #include "v2/Api.hpp"
+#include "ObjectRegistry.h"
 
 namespace powsybl {
 
@@ -49,20 +51,24 @@ public:
     }
 
     long addObject(api::v2::DataObject* object);
+    void addObjects(const std::vector<api::v2::DataObject*>& objects);
     long getObjectId(api::v2::DataObject* object) const;
+    api::v2::DataObject* getObject(long id) const;
 
-    std::vector<api::v2::DataObject*> getChildren(const api::v2::DataObject& parent);
+    std::vector<api::v2::DataObject*> getChildren(const api::v2::DataObject& parent, bool recursive = false);
     std::vector<std::string> getAttributeNames(const api::v2::DataObject& object) const;
 
     api::v2::DataObject* activateProject(const std::string& projectName);
 
 public:
+#ifndef POWSYBL_POWERFACTORY_STUB_ENGINE
     HINSTANCE _dllHandle;
+#endif
     api::v2::Api* _api;
 
     // data object pointer to long id only works because we are in default SetObjectReusingEnabled to true mode
     // so data object are only proxy on real object that are reused when asking for same object
-    std::map<api::v2::DataObject*, long> _objectToId;
+    ObjectRegistry _registry;
 };
 
 }
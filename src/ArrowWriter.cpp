@@ -0,0 +1,749 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file ArrowWriter.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include "ArrowWriter.h"
+#include "v2/Api.hpp"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+namespace {
+
+// minimal FlatBuffers table, enough to encode Arrow IPC messages
+struct FbTable;
+
+typedef std::shared_ptr<FbTable> FbTablePtr;
+
+struct FbField {
+    enum class Kind {
+        SCALAR,
+        STRING,
+        TABLE,
+        TABLE_VECTOR,
+        STRUCT_VECTOR,
+    };
+
+    FbField(int slot, Kind kind)
+        : _slot(slot),
+          _kind(kind) {
+    }
+
+    int _slot;
+    Kind _kind;
+    // inline size, an offset for everything but scalars
+    size_t _size = sizeof(uint32_t);
+    // scalar value, string characters or struct vector elements
+    std::vector<uint8_t> _bytes;
+    size_t _structSize = 0;
+    std::vector<FbTablePtr> _tables;
+};
+
+struct FbTable {
+    template<typename T>
+    FbTable& scalar(int slot, T value) {
+        FbField field(slot, FbField::Kind::SCALAR);
+        field._size = sizeof(T);
+        field._bytes.resize(sizeof(T));
+        std::memcpy(field._bytes.data(), &value, sizeof(T));
+        _fields.push_back(std::move(field));
+        return *this;
+    }
+
+    FbTable& string(int slot, const std::string& value) {
+        FbField field(slot, FbField::Kind::STRING);
+        field._bytes.assign(value.begin(), value.end());
+        _fields.push_back(std::move(field));
+        return *this;
+    }
+
+    FbTable& table(int slot, FbTablePtr table) {
+        FbField field(slot, FbField::Kind::TABLE);
+        field._tables.push_back(std::move(table));
+        _fields.push_back(std::move(field));
+        return *this;
+    }
+
+    FbTable& tables(int slot, std::vector<FbTablePtr> tables) {
+        FbField field(slot, FbField::Kind::TABLE_VECTOR);
+        field._tables = std::move(tables);
+        _fields.push_back(std::move(field));
+        return *this;
+    }
+
+    // all structs of Arrow IPC messages are made of int64 values
+    FbTable& structs(int slot, const std::vector<int64_t>& values, size_t valuesPerStruct) {
+        FbField field(slot, FbField::Kind::STRUCT_VECTOR);
+        field._structSize = valuesPerStruct * sizeof(int64_t);
+        field._bytes.resize(values.size() * sizeof(int64_t));
+        std::memcpy(field._bytes.data(), values.data(), field._bytes.size());
+        _fields.push_back(std::move(field));
+        return *this;
+    }
+
+    std::vector<FbField> _fields;
+};
+
+FbTablePtr fbTable() {
+    return std::make_shared<FbTable>();
+}
+
+size_t alignUp(size_t size, size_t alignment) {
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * Serializes FlatBuffers front to back: each table is followed by what it references, so that all offsets are
+ * positive, and its vtable just precedes it. Values are written little endian as the host is.
+ */
+class FbBuilder {
+public:
+    std::vector<uint8_t> finish(const FbTable& root) {
+        _buffer.assign(sizeof(uint32_t), 0);
+        patchOffset(0, writeTable(root));
+        return std::move(_buffer);
+    }
+
+private:
+    void pad(size_t alignment, size_t remainder = 0) {
+        while (_buffer.size() % alignment != remainder) {
+            _buffer.push_back(0);
+        }
+    }
+
+    template<typename T>
+    void append(T value) {
+        size_t pos = _buffer.size();
+        _buffer.resize(pos + sizeof(T));
+        std::memcpy(_buffer.data() + pos, &value, sizeof(T));
+    }
+
+    void patchOffset(size_t pos, size_t target) {
+        auto offset = (uint32_t) (target - pos);
+        std::memcpy(_buffer.data() + pos, &offset, sizeof(offset));
+    }
+
+    size_t writeTable(const FbTable& table) {
+        // fields are aligned on their size relative to the table start, itself aligned on the largest field
+        size_t size = sizeof(int32_t);
+        size_t alignment = sizeof(int32_t);
+        int maxSlot = -1;
+        std::vector<size_t> fieldOffsets;
+        for (const auto& field : table._fields) {
+            size = alignUp(size, field._size);
+            fieldOffsets.push_back(size);
+            size += field._size;
+            alignment = std::max(alignment, field._size);
+            maxSlot = std::max(maxSlot, field._slot);
+        }
+
+        std::vector<uint16_t> vtable(maxSlot + 3, 0);
+        vtable[0] = (uint16_t) (vtable.size() * sizeof(uint16_t));
+        vtable[1] = (uint16_t) size;
+        for (size_t i = 0; i < table._fields.size(); i++) {
+            vtable[table._fields[i]._slot + 2] = (uint16_t) fieldOffsets[i];
+        }
+        pad(sizeof(uint16_t));
+        size_t vtablePos = _buffer.size();
+        for (uint16_t entry : vtable) {
+            append(entry);
+        }
+
+        pad(alignment);
+        size_t tablePos = _buffer.size();
+        _buffer.resize(tablePos + size, 0);
+        auto vtableOffset = (int32_t) (tablePos - vtablePos);
+        std::memcpy(_buffer.data() + tablePos, &vtableOffset, sizeof(vtableOffset));
+        for (size_t i = 0; i < table._fields.size(); i++) {
+            const auto& field = table._fields[i];
+            if (field._kind == FbField::Kind::SCALAR) {
+                std::memcpy(_buffer.data() + tablePos + fieldOffsets[i], field._bytes.data(), field._size);
+            }
+        }
+
+        for (size_t i = 0; i < table._fields.size(); i++) {
+            const auto& field = table._fields[i];
+            size_t fieldPos = tablePos + fieldOffsets[i];
+            switch (field._kind) {
+                case FbField::Kind::SCALAR:
+                    break;
+
+                case FbField::Kind::STRING:
+                    pad(sizeof(uint32_t));
+                    patchOffset(fieldPos, _buffer.size());
+                    append((uint32_t) field._bytes.size());
+                    _buffer.insert(_buffer.end(), field._bytes.begin(), field._bytes.end());
+                    _buffer.push_back(0);
+                    break;
+
+                case FbField::Kind::TABLE:
+                    patchOffset(fieldPos, writeTable(*field._tables.front()));
+                    break;
+
+                case FbField::Kind::TABLE_VECTOR: {
+                    pad(sizeof(uint32_t));
+                    size_t vectorPos = _buffer.size();
+                    patchOffset(fieldPos, vectorPos);
+                    append((uint32_t) field._tables.size());
+                    _buffer.resize(_buffer.size() + field._tables.size() * sizeof(uint32_t), 0);
+                    for (size_t j = 0; j < field._tables.size(); j++) {
+                        size_t elementPos = vectorPos + sizeof(uint32_t) * (j + 1);
+                        patchOffset(elementPos, writeTable(*field._tables[j]));
+                    }
+                    break;
+                }
+
+                case FbField::Kind::STRUCT_VECTOR:
+                    // elements just after the length have to be aligned on int64
+                    pad(sizeof(int64_t), sizeof(uint32_t));
+                    patchOffset(fieldPos, _buffer.size());
+                    append((uint32_t) (field._bytes.size() / field._structSize));
+                    _buffer.insert(_buffer.end(), field._bytes.begin(), field._bytes.end());
+                    break;
+            }
+        }
+        return tablePos;
+    }
+
+    std::vector<uint8_t> _buffer;
+};
+
+// from Arrow format Schema.fbs and Message.fbs
+const int16_t METADATA_VERSION_V5 = 4;
+const int16_t ENDIANNESS_LITTLE = 0;
+const uint8_t HEADER_SCHEMA = 1;
+const uint8_t HEADER_RECORD_BATCH = 3;
+const uint8_t TYPE_INT = 2;
+const uint8_t TYPE_FLOATING_POINT = 3;
+const uint8_t TYPE_UTF8 = 5;
+const uint8_t TYPE_LIST = 12;
+const int16_t PRECISION_DOUBLE = 2;
+
+const uint32_t CONTINUATION_MARKER = 0xFFFFFFFF;
+
+// body buffers are 8 bytes aligned
+const size_t BUFFER_ALIGNMENT = 8;
+
+// Arrow field with its type and children of nested types
+struct ArrowField {
+    std::string _name;
+    bool _nullable;
+    uint8_t _typeType;
+    FbTablePtr _type;
+    std::vector<ArrowField> _children;
+
+    FbTablePtr toFb() const {
+        std::vector<FbTablePtr> children;
+        for (const auto& child : _children) {
+            children.push_back(child.toFb());
+        }
+        auto field = fbTable();
+        field->string(0, _name)
+            .scalar<uint8_t>(1, _nullable ? 1 : 0)
+            .scalar<uint8_t>(2, _typeType)
+            .table(3, _type)
+            .tables(5, std::move(children));
+        return field;
+    }
+};
+
+ArrowField intField(const std::string& name, bool nullable, int bitWidth) {
+    auto type = fbTable();
+    type->scalar<int32_t>(0, bitWidth).scalar<uint8_t>(1, 1);
+    return {name, nullable, TYPE_INT, type, {}};
+}
+
+ArrowField doubleField(const std::string& name, bool nullable) {
+    auto type = fbTable();
+    type->scalar<int16_t>(0, PRECISION_DOUBLE);
+    return {name, nullable, TYPE_FLOATING_POINT, type, {}};
+}
+
+ArrowField utf8Field(const std::string& name, bool nullable) {
+    return {name, nullable, TYPE_UTF8, fbTable(), {}};
+}
+
+ArrowField listField(const std::string& name, bool nullable, ArrowField child) {
+    return {name, nullable, TYPE_LIST, fbTable(), {std::move(child)}};
+}
+
+// what a field becomes in a record batch, buffers of its children excluded
+struct ArrowArray {
+    int64_t _length = 0;
+    int64_t _nullCount = 0;
+    std::vector<std::vector<uint8_t>> _buffers;
+    std::vector<ArrowArray> _children;
+};
+
+// validity bitmap is omitted when there is no null
+ArrowArray newArray(const std::vector<bool>& valid) {
+    ArrowArray array;
+    array._length = (int64_t) valid.size();
+    array._nullCount = std::count(valid.begin(), valid.end(), false);
+    std::vector<uint8_t> bitmap;
+    if (array._nullCount > 0) {
+        bitmap.resize((valid.size() + 7) / 8, 0);
+        for (size_t i = 0; i < valid.size(); i++) {
+            if (valid[i]) {
+                bitmap[i / 8] |= (uint8_t) (1 << (i % 8));
+            }
+        }
+    }
+    array._buffers.push_back(std::move(bitmap));
+    return array;
+}
+
+template<typename T>
+std::vector<uint8_t> toBytes(const std::vector<T>& values) {
+    std::vector<uint8_t> bytes(values.size() * sizeof(T));
+    if (!values.empty()) {
+        std::memcpy(bytes.data(), values.data(), bytes.size());
+    }
+    return bytes;
+}
+
+template<typename T>
+ArrowArray primitiveArray(const std::vector<T>& values, const std::vector<bool>& valid) {
+    ArrowArray array = newArray(valid);
+    array._buffers.push_back(toBytes(values));
+    return array;
+}
+
+ArrowArray utf8Array(const std::vector<int32_t>& offsets, const std::vector<uint8_t>& data, const std::vector<bool>& valid) {
+    ArrowArray array = newArray(valid);
+    array._buffers.push_back(toBytes(offsets));
+    array._buffers.push_back(data);
+    return array;
+}
+
+ArrowArray listArray(const std::vector<int32_t>& offsets, const std::vector<bool>& valid, ArrowArray child) {
+    ArrowArray array = newArray(valid);
+    array._buffers.push_back(toBytes(offsets));
+    array._children.push_back(std::move(child));
+    return array;
+}
+
+// matrices are lists of rows, rows being lists too as their column count is only known from the values
+ArrowField toArrowField(const std::string& name, int type) {
+    switch (type) {
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER:
+            return intField(name, true, 32);
+
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER64:
+        case api::v2::DataObject::AttributeType::TYPE_OBJECT:
+            return intField(name, true, 64);
+
+        case api::v2::DataObject::AttributeType::TYPE_DOUBLE:
+            return doubleField(name, true);
+
+        case api::v2::DataObject::AttributeType::TYPE_STRING:
+            return utf8Field(name, true);
+
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER_VEC:
+            return listField(name, true, intField("item", false, 32));
+
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER64_VEC:
+            return listField(name, true, intField("item", false, 64));
+
+        case api::v2::DataObject::AttributeType::TYPE_OBJECT_VEC:
+            return listField(name, true, intField("item", true, 64));
+
+        case api::v2::DataObject::AttributeType::TYPE_DOUBLE_VEC:
+            return listField(name, true, doubleField("item", false));
+
+        case api::v2::DataObject::AttributeType::TYPE_STRING_VEC:
+            return listField(name, true, utf8Field("item", false));
+
+        case api::v2::DataObject::AttributeType::TYPE_DOUBLE_MAT:
+            return listField(name, true, listField("item", false, doubleField("item", false)));
+
+        default:
+            throw std::runtime_error("Unsupported attribute type " + std::to_string(type));
+    }
+}
+
+ArrowArray toArrowArray(const ArrowColumn& column) {
+    switch (column._type) {
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER:
+            return primitiveArray(column._ints, column._valid);
+
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER64:
+        case api::v2::DataObject::AttributeType::TYPE_OBJECT:
+            return primitiveArray(column._longs, column._valid);
+
+        case api::v2::DataObject::AttributeType::TYPE_DOUBLE:
+            return primitiveArray(column._doubles, column._valid);
+
+        case api::v2::DataObject::AttributeType::TYPE_STRING:
+            return utf8Array(column._stringOffsets, column._chars, column._valid);
+
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER_VEC:
+            return listArray(column._offsets, column._valid,
+                             primitiveArray(column._ints, std::vector<bool>(column._ints.size(), true)));
+
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER64_VEC:
+            return listArray(column._offsets, column._valid,
+                             primitiveArray(column._longs, std::vector<bool>(column._longs.size(), true)));
+
+        case api::v2::DataObject::AttributeType::TYPE_OBJECT_VEC: {
+            // -1 is a null reference
+            std::vector<bool> itemValid;
+            itemValid.reserve(column._longs.size());
+            for (int64_t item : column._longs) {
+                itemValid.push_back(item != -1);
+            }
+            return listArray(column._offsets, column._valid, primitiveArray(column._longs, itemValid));
+        }
+
+        case api::v2::DataObject::AttributeType::TYPE_DOUBLE_VEC:
+            return listArray(column._offsets, column._valid,
+                             primitiveArray(column._doubles, std::vector<bool>(column._doubles.size(), true)));
+
+        case api::v2::DataObject::AttributeType::TYPE_STRING_VEC:
+            return listArray(column._offsets, column._valid,
+                             utf8Array(column._stringOffsets, column._chars, std::vector<bool>(column._stringOffsets.size() - 1, true)));
+
+        case api::v2::DataObject::AttributeType::TYPE_DOUBLE_MAT: {
+            // list of rows, values being stored row after row
+            std::vector<bool> rowValid(column._rowOffsets.size() - 1, true);
+            ArrowArray rowArray = listArray(column._rowOffsets, rowValid,
+                                            primitiveArray(column._doubles, std::vector<bool>(column._doubles.size(), true)));
+            return listArray(column._offsets, column._valid, std::move(rowArray));
+        }
+
+        default:
+            throw std::runtime_error("Unsupported attribute type " + std::to_string(column._type));
+    }
+}
+
+// nodes and buffers are listed depth first, as the fields of the schema
+void appendArray(const ArrowArray& array, std::vector<int64_t>& nodes, std::vector<int64_t>& buffers, std::vector<uint8_t>& body) {
+    nodes.push_back(array._length);
+    nodes.push_back(array._nullCount);
+    for (const auto& buffer : array._buffers) {
+        buffers.push_back((int64_t) body.size());
+        buffers.push_back((int64_t) buffer.size());
+        body.insert(body.end(), buffer.begin(), buffer.end());
+        body.resize(alignUp(body.size(), BUFFER_ALIGNMENT), 0);
+    }
+    for (const auto& child : array._children) {
+        appendArray(child, nodes, buffers, body);
+    }
+}
+
+// encapsulated message: continuation marker, metadata size, metadata padded so that the body is aligned, and body
+void writeMessage(std::ofstream& file, uint8_t headerType, FbTablePtr header, const std::vector<uint8_t>& body) {
+    FbTable message;
+    message.scalar<int16_t>(0, METADATA_VERSION_V5)
+        .scalar<uint8_t>(1, headerType)
+        .table(2, std::move(header))
+        .scalar<int64_t>(3, (int64_t) body.size());
+    std::vector<uint8_t> metadata = FbBuilder().finish(message);
+    metadata.resize(alignUp(metadata.size() + 2 * sizeof(uint32_t), BUFFER_ALIGNMENT) - 2 * sizeof(uint32_t), 0);
+
+    auto metadataSize = (int32_t) metadata.size();
+    file.write(reinterpret_cast<const char*>(&CONTINUATION_MARKER), sizeof(CONTINUATION_MARKER));
+    file.write(reinterpret_cast<const char*>(&metadataSize), sizeof(metadataSize));
+    file.write(reinterpret_cast<const char*>(metadata.data()), (std::streamsize) metadata.size());
+    file.write(reinterpret_cast<const char*>(body.data()), (std::streamsize) body.size());
+}
+
+}
+
+ArrowColumn::ArrowColumn(const std::string& name, int type)
+    : _name(name),
+      _type(type) {
+    clear();
+}
+
+void ArrowColumn::appendString(const std::string& value) {
+    _chars.insert(_chars.end(), value.begin(), value.end());
+    _stringOffsets.push_back((int32_t) _chars.size());
+}
+
+void ArrowColumn::appendNull() {
+    switch (_type) {
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER:
+            _ints.push_back(0);
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER64:
+        case api::v2::DataObject::AttributeType::TYPE_OBJECT:
+            _longs.push_back(0);
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_DOUBLE:
+            _doubles.push_back(0);
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_STRING:
+            _stringOffsets.push_back(_stringOffsets.back());
+            break;
+
+        default:
+            // vectors and matrices
+            _offsets.push_back(_offsets.back());
+            break;
+    }
+    _valid.push_back(false);
+}
+
+void ArrowColumn::clear() {
+    _valid.clear();
+    _ints.clear();
+    _longs.clear();
+    _doubles.clear();
+    _chars.clear();
+    _stringOffsets.assign(1, 0);
+    _offsets.assign(1, 0);
+    _rowOffsets.assign(1, 0);
+}
+
+ArrowWriter::ArrowWriter(const std::string& directory, size_t batchRowCount)
+    : _directory(directory),
+      _batchRowCount(std::max(batchRowCount, (size_t) 1)) {
+}
+
+ArrowWriter::Table& ArrowWriter::getTable(const std::string& className) {
+    auto it = _tables.find(className);
+    if (it == _tables.end()) {
+        throw std::runtime_error("Class '" + className + "' has not been declared");
+    }
+    return it->second;
+}
+
+void ArrowWriter::createClass(const std::string& name) {
+    if (_tables.find(name) == _tables.end()) {
+        _classNames.push_back(name);
+        _tables[name]._className = name;
+    }
+}
+
+void ArrowWriter::createAttribute(const std::string& className, const std::string& attributeName, int type, const std::string&) {
+    Table& table = getTable(className);
+    if (table._columnIndexes.find(attributeName) != table._columnIndexes.end()) {
+        return;
+    }
+    if (table._file) {
+        throw std::runtime_error("Attribute '" + attributeName + "' of class '" + className
+                                 + "' declared after the schema has been written");
+    }
+    table._columnIndexes.emplace(attributeName, table._columns.size());
+    table._columns.emplace_back(attributeName, type);
+}
+
+void ArrowWriter::createObject(long id, const std::string& className, long parentId) {
+    Table& table = getTable(className);
+    // values of the last row may still come until the next object is created
+    if (table._ids.size() >= _batchRowCount) {
+        writeBatch(table);
+    }
+    _rows[id] = {&table, table._ids.size()};
+    table._ids.push_back(id);
+    table._parentIds.push_back(parentId);
+}
+
+void ArrowWriter::setObjectParent(long id, long parentId) {
+    auto it = _rows.find(id);
+    if (it == _rows.end()) {
+        throw std::runtime_error("Object " + std::to_string(id) + " is not part of a batch being written");
+    }
+    it->second.first->_parentIds[it->second.second] = parentId;
+}
+
+ArrowColumn& ArrowWriter::getColumn(long objectId, const std::string& attributeName, int type) {
+    auto it = _rows.find(objectId);
+    if (it == _rows.end()) {
+        throw std::runtime_error("Object " + std::to_string(objectId) + " is not part of a batch being written");
+    }
+    Table& table = *it->second.first;
+    size_t row = it->second.second;
+    // columns are appended to, so values have to come just after the creation of their object
+    if (row + 1 != table._ids.size()) {
+        throw std::runtime_error("Values of object " + std::to_string(objectId) + " received after another object of class '"
+                                 + table._className + "'");
+    }
+    auto columnIt = table._columnIndexes.find(attributeName);
+    if (columnIt == table._columnIndexes.end()) {
+        throw std::runtime_error("Attribute '" + attributeName + "' has not been declared");
+    }
+    ArrowColumn& column = table._columns[columnIt->second];
+    if (column._type != type) {
+        throw std::runtime_error("Attribute '" + attributeName + "' has not been declared with type " + std::to_string(type));
+    }
+    if (column._valid.size() > row) {
+        throw std::runtime_error("Attribute '" + attributeName + "' of object " + std::to_string(objectId) + " set twice");
+    }
+    while (column._valid.size() < row) {
+        column.appendNull();
+    }
+    column._valid.push_back(true);
+    return column;
+}
+
+void ArrowWriter::setStringAttributeValue(long objectId, const std::string& attributeName, const std::string& value) {
+    getColumn(objectId, attributeName, api::v2::DataObject::AttributeType::TYPE_STRING).appendString(value);
+}
+
+void ArrowWriter::setIntAttributeValue(long objectId, const std::string& attributeName, int value) {
+    getColumn(objectId, attributeName, api::v2::DataObject::AttributeType::TYPE_INTEGER)._ints.push_back(value);
+}
+
+void ArrowWriter::setLongAttributeValue(long objectId, const std::string& attributeName, long value) {
+    getColumn(objectId, attributeName, api::v2::DataObject::AttributeType::TYPE_INTEGER64)._longs.push_back(value);
+}
+
+void ArrowWriter::setDoubleAttributeValue(long objectId, const std::string& attributeName, double value) {
+    getColumn(objectId, attributeName, api::v2::DataObject::AttributeType::TYPE_DOUBLE)._doubles.push_back(value);
+}
+
+void ArrowWriter::setObjectAttributeValue(long objectId, const std::string& attributeName, long otherObjectId) {
+    ArrowColumn& column = getColumn(objectId, attributeName, api::v2::DataObject::AttributeType::TYPE_OBJECT);
+    column._longs.push_back(otherObjectId);
+    // -1 is a null reference
+    if (otherObjectId == -1) {
+        column._valid.back() = false;
+    }
+}
+
+void ArrowWriter::setIntVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int>& value) {
+    ArrowColumn& column = getColumn(objectId, attributeName, api::v2::DataObject::AttributeType::TYPE_INTEGER_VEC);
+    column._ints.insert(column._ints.end(), value.begin(), value.end());
+    column._offsets.push_back((int32_t) column._ints.size());
+}
+
+void ArrowWriter::setLongVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& value) {
+    ArrowColumn& column = getColumn(objectId, attributeName, api::v2::DataObject::AttributeType::TYPE_INTEGER64_VEC);
+    column._longs.insert(column._longs.end(), value.begin(), value.end());
+    column._offsets.push_back((int32_t) column._longs.size());
+}
+
+void ArrowWriter::setDoubleVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<double>& value) {
+    ArrowColumn& column = getColumn(objectId, attributeName, api::v2::DataObject::AttributeType::TYPE_DOUBLE_VEC);
+    column._doubles.insert(column._doubles.end(), value.begin(), value.end());
+    column._offsets.push_back((int32_t) column._doubles.size());
+}
+
+void ArrowWriter::setStringVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<std::string>& value) {
+    ArrowColumn& column = getColumn(objectId, attributeName, api::v2::DataObject::AttributeType::TYPE_STRING_VEC);
+    for (const auto& item : value) {
+        column.appendString(item);
+    }
+    column._offsets.push_back((int32_t) column._stringOffsets.size() - 1);
+}
+
+void ArrowWriter::setObjectVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& otherObjectsIds) {
+    ArrowColumn& column = getColumn(objectId, attributeName, api::v2::DataObject::AttributeType::TYPE_OBJECT_VEC);
+    column._longs.insert(column._longs.end(), otherObjectsIds.begin(), otherObjectsIds.end());
+    column._offsets.push_back((int32_t) column._longs.size());
+}
+
+void ArrowWriter::setDoubleMatrixAttributeValue(long objectId, const std::string& attributeName, int rowCount, int columnCount, const std::vector<double>& value) {
+    ArrowColumn& column = getColumn(objectId, attributeName, api::v2::DataObject::AttributeType::TYPE_DOUBLE_MAT);
+    for (int row = 0; row < rowCount; row++) {
+        auto begin = value.begin() + (size_t) row * columnCount;
+        column._doubles.insert(column._doubles.end(), begin, begin + columnCount);
+        column._rowOffsets.push_back((int32_t) column._doubles.size());
+    }
+    column._offsets.push_back((int32_t) column._rowOffsets.size() - 1);
+}
+
+void ArrowWriter::writeSchema(Table& table) {
+    std::string fileName = _directory + "/" + table._className + ".arrows";
+    table._file = std::make_unique<std::ofstream>(fileName, std::ios::binary | std::ios::trunc);
+    if (!*table._file) {
+        throw std::runtime_error("Cannot open Arrow file '" + fileName + "'");
+    }
+
+    std::vector<FbTablePtr> fields;
+    fields.push_back(intField("id", false, 64).toFb());
+    fields.push_back(intField("parentId", true, 64).toFb());
+    for (const auto& column : table._columns) {
+        fields.push_back(toArrowField(column._name, column._type).toFb());
+    }
+    auto schema = fbTable();
+    schema->scalar<int16_t>(0, ENDIANNESS_LITTLE).tables(1, std::move(fields));
+    writeMessage(*table._file, HEADER_SCHEMA, schema, {});
+}
+
+void ArrowWriter::writeBatch(Table& table) {
+    if (!table._file) {
+        writeSchema(table);
+    }
+
+    size_t rowCount = table._ids.size();
+    std::vector<bool> parentValid;
+    parentValid.reserve(rowCount);
+    for (int64_t parentId : table._parentIds) {
+        parentValid.push_back(parentId != -1);
+    }
+    std::vector<ArrowArray> arrays;
+    arrays.push_back(primitiveArray(table._ids, std::vector<bool>(rowCount, true)));
+    arrays.push_back(primitiveArray(table._parentIds, parentValid));
+    for (auto& column : table._columns) {
+        // no value for the last rows
+        while (column._valid.size() < rowCount) {
+            column.appendNull();
+        }
+        arrays.push_back(toArrowArray(column));
+    }
+
+    std::vector<int64_t> nodes;
+    std::vector<int64_t> buffers;
+    std::vector<uint8_t> body;
+    for (const auto& array : arrays) {
+        appendArray(array, nodes, buffers, body);
+    }
+    auto recordBatch = fbTable();
+    recordBatch->scalar<int64_t>(0, (int64_t) rowCount)
+        .structs(1, nodes, 2)
+        .structs(2, buffers, 2);
+    writeMessage(*table._file, HEADER_RECORD_BATCH, recordBatch, body);
+    table._file->flush();
+
+    // only rows of the batch being built are kept in memory
+    for (int64_t id : table._ids) {
+        _rows.erase((long) id);
+    }
+    table._ids.clear();
+    table._parentIds.clear();
+    for (auto& column : table._columns) {
+        column.clear();
+    }
+}
+
+void ArrowWriter::flush() {
+    for (const auto& className : _classNames) {
+        Table& table = _tables.at(className);
+        if (!table._file) {
+            writeSchema(table);
+        }
+        if (!table._ids.empty()) {
+            writeBatch(table);
+        }
+
+        // end of stream
+        const uint32_t endOfStream[] = {CONTINUATION_MARKER, 0};
+        table._file->write(reinterpret_cast<const char*>(endOfStream), sizeof(endOfStream));
+        table._file->close();
+        if (!*table._file) {
+            throw std::runtime_error("Failed to write Arrow file '" + _directory + "/" + className + ".arrows'");
+        }
+        table._file.reset();
+    }
+}
+
+}
+
+}
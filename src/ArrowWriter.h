@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file ArrowWriter.h
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#ifndef POWSYBL_POWERFACTORY_DB_NATIVE_ARROWWRITER_H
+#define POWSYBL_POWERFACTORY_DB_NATIVE_ARROWWRITER_H
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <unordered_map>
+#include "DataObjectHandler.h"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+/**
+ * Values of an attribute for the rows of the record batch being built, in typed vectors laid out as Arrow buffers.
+ */
+struct ArrowColumn {
+    ArrowColumn(const std::string& name, int type);
+
+    void appendString(const std::string& value);
+
+    void appendNull();
+
+    void clear();
+
+    std::string _name;
+    int _type;
+    std::vector<bool> _valid;
+    // integer values and items of integer vectors
+    std::vector<int32_t> _ints;
+    // long values and object ids, and items of long and object vectors
+    std::vector<int64_t> _longs;
+    // double values, and items of double vectors and matrices
+    std::vector<double> _doubles;
+    // characters and offsets of string values and items of string vectors
+    std::vector<uint8_t> _chars;
+    std::vector<int32_t> _stringOffsets;
+    // offsets of vectors items, or of matrices rows
+    std::vector<int32_t> _offsets;
+    // offsets of matrices rows items
+    std::vector<int32_t> _rowOffsets;
+};
+
+/**
+ * Writes objects to Apache Arrow IPC stream files, one '<class name>.arrows' file per class in a directory, made of
+ * the schema and record batches of at most a given number of rows. Each table has an 'id' and a 'parentId' int64
+ * column, then one nullable column per attribute: int32, int64, float64 and utf8 for scalar values, int64 ids for
+ * object references, lists for vectors, and lists of rows for matrices, rows being lists too.
+ *
+ * A batch is written as soon as a class table is full, so only one batch per class is kept in memory. Values of an
+ * object have to follow its creation, and attributes of a class have to be declared before its first batch is written.
+ */
+class ArrowWriter : public DataObjectHandler {
+public:
+    explicit ArrowWriter(const std::string& directory, size_t batchRowCount = 65536);
+
+    void createClass(const std::string& name) override;
+
+    void createAttribute(const std::string& className, const std::string& attributeName, int type, const std::string& description) override;
+
+    void createObject(long id, const std::string& className, long parentId) override;
+
+    void setObjectParent(long id, long parentId) override;
+
+    void setStringAttributeValue(long objectId, const std::string& attributeName, const std::string& value) override;
+
+    void setIntAttributeValue(long objectId, const std::string& attributeName, int value) override;
+
+    void setLongAttributeValue(long objectId, const std::string& attributeName, long value) override;
+
+    void setDoubleAttributeValue(long objectId, const std::string& attributeName, double value) override;
+
+    void setObjectAttributeValue(long objectId, const std::string& attributeName, long otherObjectId) override;
+
+    void setIntVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int>& value) override;
+
+    void setLongVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& value) override;
+
+    void setDoubleVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<double>& value) override;
+
+    void setStringVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<std::string>& value) override;
+
+    void setObjectVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& otherObjectsIds) override;
+
+    void setDoubleMatrixAttributeValue(long objectId, const std::string& attributeName, int rowCount, int columnCount, const std::vector<double>& value) override;
+
+    void flush() override;
+
+private:
+    struct Table {
+        std::string _className;
+        std::vector<ArrowColumn> _columns;
+        std::unordered_map<std::string, size_t> _columnIndexes;
+        // rows of the batch being built
+        std::vector<int64_t> _ids;
+        std::vector<int64_t> _parentIds;
+        // opened when the schema is written, just before the first batch
+        std::unique_ptr<std::ofstream> _file;
+    };
+
+    Table& getTable(const std::string& className);
+
+    // column of the attribute, its value for the object being marked as valid and left to be appended
+    ArrowColumn& getColumn(long objectId, const std::string& attributeName, int type);
+
+    void writeSchema(Table& table);
+
+    void writeBatch(Table& table);
+
+    const std::string _directory;
+    const size_t _batchRowCount;
+    // in declaration order so that files are always written in the same order
+    std::vector<std::string> _classNames;
+    std::unordered_map<std::string, Table> _tables;
+    // table and row of each object of the batches being built
+    std::unordered_map<long, std::pair<Table*, size_t>> _rows;
+};
+
+}
+
+}
+
+#endif //POWSYBL_POWERFACTORY_DB_NATIVE_ARROWWRITER_H
@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file AttributeValue.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include "AttributeValue.h"
+#include "v2/Api.hpp"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+bool AttributeValue::operator==(const AttributeValue& other) const {
+    return _attributeName == other._attributeName
+           && _type == other._type
+           && _longs == other._longs
+           && _doubles == other._doubles
+           && _strings == other._strings
+           && _rowCount == other._rowCount
+           && _columnCount == other._columnCount;
+}
+
+bool isObjectReference(int type) {
+    return type == api::v2::DataObject::AttributeType::TYPE_OBJECT
+           || type == api::v2::DataObject::AttributeType::TYPE_OBJECT_VEC;
+}
+
+void emitValue(long objectId, const AttributeValue& value, DataObjectHandler& handler) {
+    switch (value._type) {
+        case api::v2::DataObject::AttributeType::TYPE_STRING:
+            handler.setStringAttributeValue(objectId, value._attributeName, value._strings.front());
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER:
+            handler.setIntAttributeValue(objectId, value._attributeName, (int) value._longs.front());
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER64:
+            handler.setLongAttributeValue(objectId, value._attributeName, (long) value._longs.front());
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_DOUBLE:
+            handler.setDoubleAttributeValue(objectId, value._attributeName, value._doubles.front());
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_OBJECT:
+            handler.setObjectAttributeValue(objectId, value._attributeName, (long) value._longs.front());
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER_VEC:
+            handler.setIntVectorAttributeValue(objectId, value._attributeName, std::vector<int>(value._longs.begin(), value._longs.end()));
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER64_VEC:
+            handler.setLongVectorAttributeValue(objectId, value._attributeName, value._longs);
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_DOUBLE_VEC:
+            handler.setDoubleVectorAttributeValue(objectId, value._attributeName, value._doubles);
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_STRING_VEC:
+            handler.setStringVectorAttributeValue(objectId, value._attributeName, value._strings);
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_OBJECT_VEC:
+            handler.setObjectVectorAttributeValue(objectId, value._attributeName, value._longs);
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_DOUBLE_MAT:
+            handler.setDoubleMatrixAttributeValue(objectId, value._attributeName, value._rowCount, value._columnCount, value._doubles);
+            break;
+
+        default:
+            throw std::runtime_error("Unsupported attribute type " + std::to_string(value._type));
+    }
+}
+
+void AttributeValueHandler::setStringAttributeValue(long objectId, const std::string& attributeName, const std::string& value) {
+    setAttributeValue(objectId, {attributeName, api::v2::DataObject::AttributeType::TYPE_STRING, {}, {}, {value}});
+}
+
+void AttributeValueHandler::setIntAttributeValue(long objectId, const std::string& attributeName, int value) {
+    setAttributeValue(objectId, {attributeName, api::v2::DataObject::AttributeType::TYPE_INTEGER, {value}, {}, {}});
+}
+
+void AttributeValueHandler::setLongAttributeValue(long objectId, const std::string& attributeName, long value) {
+    setAttributeValue(objectId, {attributeName, api::v2::DataObject::AttributeType::TYPE_INTEGER64, {value}, {}, {}});
+}
+
+void AttributeValueHandler::setDoubleAttributeValue(long objectId, const std::string& attributeName, double value) {
+    setAttributeValue(objectId, {attributeName, api::v2::DataObject::AttributeType::TYPE_DOUBLE, {}, {value}, {}});
+}
+
+void AttributeValueHandler::setObjectAttributeValue(long objectId, const std::string& attributeName, long otherObjectId) {
+    setAttributeValue(objectId, {attributeName, api::v2::DataObject::AttributeType::TYPE_OBJECT, {otherObjectId}, {}, {}});
+}
+
+void AttributeValueHandler::setIntVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int>& value) {
+    setAttributeValue(objectId, {attributeName, api::v2::DataObject::AttributeType::TYPE_INTEGER_VEC, {value.begin(), value.end()}, {}, {}});
+}
+
+void AttributeValueHandler::setLongVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& value) {
+    setAttributeValue(objectId, {attributeName, api::v2::DataObject::AttributeType::TYPE_INTEGER64_VEC, value, {}, {}});
+}
+
+void AttributeValueHandler::setDoubleVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<double>& value) {
+    setAttributeValue(objectId, {attributeName, api::v2::DataObject::AttributeType::TYPE_DOUBLE_VEC, {}, value, {}});
+}
+
+void AttributeValueHandler::setStringVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<std::string>& value) {
+    setAttributeValue(objectId, {attributeName, api::v2::DataObject::AttributeType::TYPE_STRING_VEC, {}, {}, value});
+}
+
+void AttributeValueHandler::setObjectVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& otherObjectsIds) {
+    setAttributeValue(objectId, {attributeName, api::v2::DataObject::AttributeType::TYPE_OBJECT_VEC, otherObjectsIds, {}, {}});
+}
+
+void AttributeValueHandler::setDoubleMatrixAttributeValue(long objectId, const std::string& attributeName, int rowCount, int columnCount, const std::vector<double>& value) {
+    setAttributeValue(objectId, {attributeName, api::v2::DataObject::AttributeType::TYPE_DOUBLE_MAT, {}, value, {}, rowCount, columnCount});
+}
+
+}
+
+}
@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file AttributeValue.h
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#ifndef POWSYBL_POWERFACTORY_DB_NATIVE_ATTRIBUTEVALUE_H
+#define POWSYBL_POWERFACTORY_DB_NATIVE_ATTRIBUTEVALUE_H
+
+#include "DataObjectHandler.h"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+/**
+ * Value of any type of attribute, kept to be sent later to a handler.
+ */
+struct AttributeValue {
+    std::string _attributeName;
+    int _type;
+    // integer, long and object values and vectors
+    std::vector<int64_t> _longs;
+    // double values, vectors and matrices
+    std::vector<double> _doubles;
+    // string values and vectors
+    std::vector<std::string> _strings;
+    int _rowCount = 0;
+    int _columnCount = 0;
+
+    bool operator==(const AttributeValue& other) const;
+    bool operator!=(const AttributeValue& other) const {
+        return !(*this == other);
+    }
+};
+
+bool isObjectReference(int type);
+
+void emitValue(long objectId, const AttributeValue& value, DataObjectHandler& handler);
+
+/**
+ * Base of handlers that keep attribute values instead of consuming them on the fly.
+ */
+class AttributeValueHandler : public DataObjectHandler {
+public:
+    void setStringAttributeValue(long objectId, const std::string& attributeName, const std::string& value) override;
+
+    void setIntAttributeValue(long objectId, const std::string& attributeName, int value) override;
+
+    void setLongAttributeValue(long objectId, const std::string& attributeName, long value) override;
+
+    void setDoubleAttributeValue(long objectId, const std::string& attributeName, double value) override;
+
+    void setObjectAttributeValue(long objectId, const std::string& attributeName, long otherObjectId) override;
+
+    void setIntVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int>& value) override;
+
+    void setLongVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& value) override;
+
+    void setDoubleVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<double>& value) override;
+
+    void setStringVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<std::string>& value) override;
+
+    void setObjectVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& otherObjectsIds) override;
+
+    void setDoubleMatrixAttributeValue(long objectId, const std::string& attributeName, int rowCount, int columnCount, const std::vector<double>& value) override;
+
+protected:
+    virtual void setAttributeValue(long objectId, AttributeValue&& value) = 0;
+};
+
+}
+
+}
+
+#endif //POWSYBL_POWERFACTORY_DB_NATIVE_ATTRIBUTEVALUE_H
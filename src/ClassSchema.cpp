@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file ClassSchema.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include "ClassSchema.h"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+namespace {
+
+std::string getDescription(Api& api, const api::v2::DataObject& object, const std::string& attributeName) {
+    auto descriptionValue = object.GetAttributeDescription(attributeName.c_str());
+    return descriptionValue ? api.makeValueUniquePtr(descriptionValue)->GetString() : std::string();
+}
+
+void addAttribute(Api& api, const api::v2::DataObject& object, const std::string& attributeName, bool fillDescription,
+                  ClassSchema& schema) {
+    int type = object.GetAttributeType(attributeName.c_str());
+    if (type != api::v2::DataObject::AttributeType::TYPE_INVALID) { // what does it mean?
+        std::string description = fillDescription ? getDescription(api, object, attributeName) : std::string();
+        schema._attributes.push_back({attributeName, type, description});
+    }
+}
+
+// descriptions are set on the cached attributes, as readers keep pointers to them
+const ClassSchema& getWithDescriptions(Api& api, const api::v2::DataObject& object, bool fillDescription,
+                                       ClassSchema& schema) {
+    if (fillDescription && !schema._hasDescriptions) {
+        for (auto& attribute : schema._attributes) {
+            attribute._description = getDescription(api, object, attribute._name);
+        }
+        schema._hasDescriptions = true;
+    }
+    return schema;
+}
+
+}
+
+const ClassSchema& SchemaCache::getClassSchema(Api& api, const api::v2::DataObject& object, const std::string& className,
+                                               bool fillDescription, const std::set<std::string>* attributeNames) {
+    auto it = _schemas.find(className);
+    if (it != _schemas.end()) {
+        return getWithDescriptions(api, object, fillDescription, it->second);
+    }
+
+    ClassSchema schema;
+    schema._className = className;
+    schema._hasDescriptions = fillDescription;
+
+    if (attributeNames) {
+        auto key = std::make_pair(className, *attributeNames);
+        auto itP = _partialSchemas.find(key);
+        if (itP != _partialSchemas.end()) {
+            return getWithDescriptions(api, object, fillDescription, itP->second);
+        }
+        // a type call per allowed attribute instead of listing all of them
+        schema._attributes.reserve(attributeNames->size());
+        for (const auto& attributeName : *attributeNames) {
+            addAttribute(api, object, attributeName, fillDescription, schema);
+        }
+        return _partialSchemas.emplace(std::move(key), std::move(schema)).first->second;
+    }
+
+    auto allAttributeNames = api.getAttributeNames(object);
+    schema._attributes.reserve(allAttributeNames.size());
+    for (const auto& attributeName : allAttributeNames) {
+        addAttribute(api, object, attributeName, fillDescription, schema);
+    }
+    return _schemas.emplace(className, std::move(schema)).first->second;
+}
+
+}
+
+}
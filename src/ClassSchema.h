@@ -0,0 +1,45 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file ClassSchema.h
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#ifndef POWSYBL_POWERFACTORY_DB_NATIVE_CLASSSCHEMA_H
+#define POWSYBL_POWERFACTORY_DB_NATIVE_CLASSSCHEMA_H
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include "Api.h"
+#include "DataObjectHandler.h"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+/**
+ * Attribute names, types and descriptions of each class, resolved from the first object of the class that is read,
+ * as all objects of a class share the same attributes. Can be kept across reads.
+ */
+class SchemaCache {
+public:
+    // if attribute names are given, only those are resolved, without listing all the attributes of the class, unless
+    // they are already known
+    const ClassSchema& getClassSchema(Api& api, const api::v2::DataObject& object, const std::string& className,
+                                      bool fillDescription, const std::set<std::string>* attributeNames = nullptr);
+
+private:
+    std::unordered_map<std::string, ClassSchema> _schemas;
+
+    // schemas limited to an attribute allowlist, by class and allowlist
+    std::map<std::pair<std::string, std::set<std::string>>, ClassSchema> _partialSchemas;
+};
+
+}
+
+}
+
+#endif //POWSYBL_POWERFACTORY_DB_NATIVE_CLASSSCHEMA_H
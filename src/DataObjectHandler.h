@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file DataObjectHandler.h
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#ifndef POWSYBL_POWERFACTORY_DB_NATIVE_DATAOBJECTHANDLER_H
+#define POWSYBL_POWERFACTORY_DB_NATIVE_DATAOBJECTHANDLER_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace powsybl {
+
+namespace powerfactory {
+
+struct AttributeSchema {
+    std::string _name;
+    int _type;
+    std::string _description;
+};
+
+struct ClassSchema {
+    std::string _className;
+    // attributes with a valid type only
+    std::vector<AttributeSchema> _attributes;
+    bool _hasDescriptions = false;
+};
+
+/**
+ * Receives classes, objects and attribute values as they are read from the PowerFactory API.
+ */
+class DataObjectHandler {
+public:
+    virtual ~DataObjectHandler() = default;
+
+    virtual void createClass(const std::string& name) = 0;
+
+    virtual void createAttribute(const std::string& className, const std::string& attributeName, int type, const std::string& description) = 0;
+
+    // all classes and attributes at once, before any object
+    virtual void createSchema(const std::vector<ClassSchema>& schemas) {
+        for (const auto& schema : schemas) {
+            createClass(schema._className);
+            for (const auto& attribute : schema._attributes) {
+                createAttribute(schema._className, attribute._name, attribute._type, attribute._description);
+            }
+        }
+    }
+
+    // parent is always created before its children, -1 for the root
+    virtual void createObject(long id, const std::string& className, long parentId) = 0;
+
+    // only used when an object moves, parent is otherwise given at creation
+    virtual void setObjectParent(long id, long parentId) = 0;
+
+    virtual void setStringAttributeValue(long objectId, const std::string& attributeName, const std::string& value) = 0;
+
+    virtual void setIntAttributeValue(long objectId, const std::string& attributeName, int value) = 0;
+
+    virtual void setLongAttributeValue(long objectId, const std::string& attributeName, long value) = 0;
+
+    virtual void setDoubleAttributeValue(long objectId, const std::string& attributeName, double value) = 0;
+
+    virtual void setObjectAttributeValue(long objectId, const std::string& attributeName, long otherObjectId) = 0;
+
+    virtual void setIntVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int>& value) = 0;
+
+    virtual void setLongVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& value) = 0;
+
+    virtual void setDoubleVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<double>& value) = 0;
+
+    virtual void setStringVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<std::string>& value) = 0;
+
+    virtual void setObjectVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& otherObjectsIds) = 0;
+
+    virtual void setDoubleMatrixAttributeValue(long objectId, const std::string& attributeName, int rowCount, int columnCount, const std::vector<double>& value) = 0;
+
+    // large integer, long and double vectors and double matrices can be streamed by slices of bounded size, instead of
+    // being set at once, if the handler supports it: begin, then appends of values in row major order, then end
+    virtual bool isChunkedValueSupported() const {
+        return false;
+    }
+
+    virtual void beginAttributeValue(long /*objectId*/, const std::string& /*attributeName*/, int /*type*/, int /*rowCount*/, int /*columnCount*/) {
+        throw std::runtime_error("Chunked attribute value not supported");
+    }
+
+    virtual void appendIntValues(const int* /*values*/, size_t /*count*/) {
+        throw std::runtime_error("Chunked attribute value not supported");
+    }
+
+    virtual void appendLongValues(const int64_t* /*values*/, size_t /*count*/) {
+        throw std::runtime_error("Chunked attribute value not supported");
+    }
+
+    virtual void appendDoubleValues(const double* /*values*/, size_t /*count*/) {
+        throw std::runtime_error("Chunked attribute value not supported");
+    }
+
+    virtual void endAttributeValue() {
+        throw std::runtime_error("Chunked attribute value not supported");
+    }
+
+    // only used by delta reads, following values replace all the values of the object
+    virtual void updateObject(long /*id*/) {
+        throw std::runtime_error("Object update not supported");
+    }
+
+    // only used by delta reads
+    virtual void deleteObject(long /*id*/) {
+        throw std::runtime_error("Object deletion not supported");
+    }
+
+    // called once the whole project has been read
+    virtual void flush() {
+    }
+};
+
+}
+
+}
+
+#endif //POWSYBL_POWERFACTORY_DB_NATIVE_DATAOBJECTHANDLER_H
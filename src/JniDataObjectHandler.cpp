@@ -0,0 +1,236 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file JniDataObjectHandler.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include "JniDataObjectHandler.h"
+#include "v2/Api.hpp"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+JniDataObjectHandler::JniDataObjectHandler(const jni::ComPowsyblPowerFactoryDbDataObjectBuilder& objectBuilder,
+                                           bool stringDictionary)
+    : _objectBuilder(objectBuilder),
+      _stringDictionary(stringDictionary && objectBuilder.isStringDictionarySupported()) {
+}
+
+JniDataObjectHandler::~JniDataObjectHandler() = default;
+
+int JniDataObjectHandler::getStringCode(const std::string& value) {
+    auto it = _stringCodes.find(value);
+    if (it == _stringCodes.end()) {
+        int code = (int) _stringCodes.size();
+        _stringCodes.emplace(value, code);
+        _objectBuilder.appendDictionaryString(value);
+        return code;
+    }
+    return it->second;
+}
+
+void JniDataObjectHandler::createClass(const std::string& name) {
+    _objectBuilder.createClass(name);
+}
+
+void JniDataObjectHandler::createAttribute(const std::string& className, const std::string& attributeName, int type, const std::string& description) {
+    _objectBuilder.createAttribute(className, attributeName, type, description);
+}
+
+void JniDataObjectHandler::createSchema(const std::vector<ClassSchema>& schemas) {
+    std::vector<std::string> classNames;
+    std::vector<int> attributeCounts;
+    std::vector<std::string> attributeNames;
+    std::vector<int> attributeTypes;
+    std::vector<std::string> attributeDescriptions;
+    for (const auto& schema : schemas) {
+        classNames.push_back(schema._className);
+        attributeCounts.push_back((int) schema._attributes.size());
+        for (const auto& attribute : schema._attributes) {
+            attributeNames.push_back(attribute._name);
+            attributeTypes.push_back(attribute._type);
+            attributeDescriptions.push_back(attribute._description);
+        }
+    }
+    _objectBuilder.createSchema(classNames, attributeCounts, attributeNames, attributeTypes, attributeDescriptions);
+}
+
+void JniDataObjectHandler::createObject(long id, const std::string& className, long parentId) {
+    _objectBuilder.createObject(id, className, parentId);
+}
+
+void JniDataObjectHandler::setObjectParent(long id, long parentId) {
+    _objectBuilder.setObjectParent(id, parentId);
+}
+
+void JniDataObjectHandler::updateObject(long id) {
+    _objectBuilder.updateObject(id);
+}
+
+void JniDataObjectHandler::deleteObject(long id) {
+    _objectBuilder.deleteObject(id);
+}
+
+void JniDataObjectHandler::setStringAttributeValue(long objectId, const std::string& attributeName, const std::string& value) {
+    if (_stringDictionary) {
+        _objectBuilder.setStringCodeAttributeValue(objectId, attributeName, getStringCode(value));
+    } else {
+        _objectBuilder.setStringAttributeValue(objectId, attributeName, value);
+    }
+}
+
+void JniDataObjectHandler::setIntAttributeValue(long objectId, const std::string& attributeName, int value) {
+    _objectBuilder.setIntAttributeValue(objectId, attributeName, value);
+}
+
+void JniDataObjectHandler::setLongAttributeValue(long objectId, const std::string& attributeName, long value) {
+    _objectBuilder.setLongAttributeValue(objectId, attributeName, value);
+}
+
+void JniDataObjectHandler::setDoubleAttributeValue(long objectId, const std::string& attributeName, double value) {
+    _objectBuilder.setDoubleAttributeValue(objectId, attributeName, value);
+}
+
+void JniDataObjectHandler::setObjectAttributeValue(long objectId, const std::string& attributeName, long otherObjectId) {
+    _objectBuilder.setObjectAttributeValue(objectId, attributeName, otherObjectId);
+}
+
+void JniDataObjectHandler::setIntVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int>& value) {
+    _objectBuilder.setIntVectorAttributeValue(objectId, attributeName, value);
+}
+
+void JniDataObjectHandler::setLongVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& value) {
+    _objectBuilder.setLongVectorAttributeValue(objectId, attributeName, value);
+}
+
+void JniDataObjectHandler::setDoubleVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<double>& value) {
+    _objectBuilder.setDoubleVectorAttributeValue(objectId, attributeName, value);
+}
+
+void JniDataObjectHandler::setStringVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<std::string>& value) {
+    if (_stringDictionary) {
+        std::vector<int> codes;
+        codes.reserve(value.size());
+        for (const auto& str : value) {
+            codes.push_back(getStringCode(str));
+        }
+        _objectBuilder.setStringCodeVectorAttributeValue(objectId, attributeName, codes);
+    } else {
+        _objectBuilder.setStringVectorAttributeValue(objectId, attributeName, value);
+    }
+}
+
+void JniDataObjectHandler::setObjectVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& otherObjectsIds) {
+    _objectBuilder.setObjectVectorAttributeValue(objectId, attributeName, otherObjectsIds);
+}
+
+void JniDataObjectHandler::setDoubleMatrixAttributeValue(long objectId, const std::string& attributeName, int rowCount, int columnCount, const std::vector<double>& value) {
+    _objectBuilder.setDoubleMatrixAttributeValue(objectId, attributeName, rowCount, columnCount, value);
+}
+
+bool JniDataObjectHandler::isChunkedValueSupported() const {
+    return _objectBuilder.isChunkedValueSupported();
+}
+
+void JniDataObjectHandler::beginAttributeValue(long objectId, const std::string& attributeName, int type, int rowCount, int columnCount) {
+    _objectBuilder.beginAttributeValue(objectId, attributeName, type, rowCount, columnCount);
+}
+
+void JniDataObjectHandler::appendIntValues(const int* values, size_t count) {
+    _objectBuilder.appendIntValues(values, count);
+}
+
+void JniDataObjectHandler::appendLongValues(const int64_t* values, size_t count) {
+    _objectBuilder.appendLongValues(values, count);
+}
+
+void JniDataObjectHandler::appendDoubleValues(const double* values, size_t count) {
+    _objectBuilder.appendDoubleValues(values, count);
+}
+
+void JniDataObjectHandler::endAttributeValue() {
+    _objectBuilder.endAttributeValue();
+}
+
+void JniDataObjectHandler::flush() {
+}
+
+BatchedJniDataObjectHandler::BatchedJniDataObjectHandler(const jni::ComPowsyblPowerFactoryDbDataObjectBuilder& objectBuilder, size_t batchSize,
+                                                         bool stringDictionary)
+    : JniDataObjectHandler(objectBuilder, stringDictionary),
+      _batchSize(batchSize),
+      _intColumns(batchSize),
+      _longColumns(batchSize),
+      _doubleColumns(batchSize),
+      _objectColumns(batchSize),
+      _stringCodeColumns(_stringDictionary ? batchSize : 0) {
+}
+
+int BatchedJniDataObjectHandler::getAttributeIndex(const std::string& attributeName) {
+    auto it = _attributeIndexes.find(attributeName);
+    if (it == _attributeIndexes.end()) {
+        int attributeIndex = (int) _attributeIndexes.size();
+        _attributeIndexes.insert({attributeName, attributeIndex});
+        _objectBuilder.createAttributeIndex(attributeIndex, attributeName);
+        return attributeIndex;
+    }
+    return it->second;
+}
+
+template<typename T>
+void BatchedJniDataObjectHandler::add(ValueColumns<T>& columns, int type, long objectId, const std::string& attributeName, T value) {
+    columns.add(objectId, getAttributeIndex(attributeName), value);
+    if (columns.size() >= _batchSize) {
+        flush(columns, type);
+    }
+}
+
+template<typename T>
+void BatchedJniDataObjectHandler::flush(ValueColumns<T>& columns, int type) {
+    if (columns.size() > 0) {
+        _objectBuilder.flushBatch(type, (int) columns.size(), columns._objectIds.data(), columns._attributeIndexes.data(),
+                                  columns._values.data(), sizeof(T));
+        columns.clear();
+    }
+}
+
+void BatchedJniDataObjectHandler::setStringAttributeValue(long objectId, const std::string& attributeName, const std::string& value) {
+    if (_stringDictionary) {
+        add<int32_t>(_stringCodeColumns, api::v2::DataObject::AttributeType::TYPE_STRING, objectId, attributeName, getStringCode(value));
+    } else {
+        JniDataObjectHandler::setStringAttributeValue(objectId, attributeName, value);
+    }
+}
+
+void BatchedJniDataObjectHandler::setIntAttributeValue(long objectId, const std::string& attributeName, int value) {
+    add<int32_t>(_intColumns, api::v2::DataObject::AttributeType::TYPE_INTEGER, objectId, attributeName, value);
+}
+
+void BatchedJniDataObjectHandler::setLongAttributeValue(long objectId, const std::string& attributeName, long value) {
+    add<int64_t>(_longColumns, api::v2::DataObject::AttributeType::TYPE_INTEGER64, objectId, attributeName, value);
+}
+
+void BatchedJniDataObjectHandler::setDoubleAttributeValue(long objectId, const std::string& attributeName, double value) {
+    add<double>(_doubleColumns, api::v2::DataObject::AttributeType::TYPE_DOUBLE, objectId, attributeName, value);
+}
+
+void BatchedJniDataObjectHandler::setObjectAttributeValue(long objectId, const std::string& attributeName, long otherObjectId) {
+    add<int64_t>(_objectColumns, api::v2::DataObject::AttributeType::TYPE_OBJECT, objectId, attributeName, otherObjectId);
+}
+
+void BatchedJniDataObjectHandler::flush() {
+    flush(_intColumns, api::v2::DataObject::AttributeType::TYPE_INTEGER);
+    flush(_longColumns, api::v2::DataObject::AttributeType::TYPE_INTEGER64);
+    flush(_doubleColumns, api::v2::DataObject::AttributeType::TYPE_DOUBLE);
+    flush(_objectColumns, api::v2::DataObject::AttributeType::TYPE_OBJECT);
+    flush(_stringCodeColumns, api::v2::DataObject::AttributeType::TYPE_STRING);
+    JniDataObjectHandler::flush();
+}
+
+}
+
+}
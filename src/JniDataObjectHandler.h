@@ -0,0 +1,176 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file JniDataObjectHandler.h
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#ifndef POWSYBL_POWERFACTORY_DB_NATIVE_JNIDATAOBJECTHANDLER_H
+#define POWSYBL_POWERFACTORY_DB_NATIVE_JNIDATAOBJECTHANDLER_H
+
+#include <map>
+#include <unordered_map>
+#include "DataObjectHandler.h"
+#include "jniwrapper.hpp"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+/**
+ * Forwards each value to the Java data object builder with one upcall per value. String values can be dictionary
+ * encoded: each distinct string is sent once, and values are sent as codes.
+ * Dictionary encoding and chunked values are only used if the builder supports them.
+ * Each upcall deletes the local references it creates before returning, so that several handlers can share the same
+ * JNI environment and interleave their upcalls without any local reference piling up over the traversal.
+ */
+class JniDataObjectHandler : public DataObjectHandler {
+public:
+    explicit JniDataObjectHandler(const jni::ComPowsyblPowerFactoryDbDataObjectBuilder& objectBuilder,
+                                  bool stringDictionary = false);
+
+    ~JniDataObjectHandler() override;
+
+    void createClass(const std::string& name) override;
+
+    void createAttribute(const std::string& className, const std::string& attributeName, int type, const std::string& description) override;
+
+    void createSchema(const std::vector<ClassSchema>& schemas) override;
+
+    void createObject(long id, const std::string& className, long parentId) override;
+
+    void setObjectParent(long id, long parentId) override;
+
+    void updateObject(long id) override;
+
+    void deleteObject(long id) override;
+
+    void setStringAttributeValue(long objectId, const std::string& attributeName, const std::string& value) override;
+
+    void setIntAttributeValue(long objectId, const std::string& attributeName, int value) override;
+
+    void setLongAttributeValue(long objectId, const std::string& attributeName, long value) override;
+
+    void setDoubleAttributeValue(long objectId, const std::string& attributeName, double value) override;
+
+    void setObjectAttributeValue(long objectId, const std::string& attributeName, long otherObjectId) override;
+
+    void setIntVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int>& value) override;
+
+    void setLongVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& value) override;
+
+    void setDoubleVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<double>& value) override;
+
+    void setStringVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<std::string>& value) override;
+
+    void setObjectVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& otherObjectsIds) override;
+
+    void setDoubleMatrixAttributeValue(long objectId, const std::string& attributeName, int rowCount, int columnCount, const std::vector<double>& value) override;
+
+    bool isChunkedValueSupported() const override;
+
+    void beginAttributeValue(long objectId, const std::string& attributeName, int type, int rowCount, int columnCount) override;
+
+    void appendIntValues(const int* values, size_t count) override;
+
+    void appendLongValues(const int64_t* values, size_t count) override;
+
+    void appendDoubleValues(const double* values, size_t count) override;
+
+    void endAttributeValue() override;
+
+    void flush() override;
+
+protected:
+    // code of the string in the dictionary, a new string being appended to the Java dictionary first
+    int getStringCode(const std::string& value);
+
+    const jni::ComPowsyblPowerFactoryDbDataObjectBuilder& _objectBuilder;
+
+    const bool _stringDictionary;
+    std::unordered_map<std::string, int> _stringCodes;
+};
+
+/**
+ * Columns of (object id, attribute index, value) records of a single attribute type.
+ */
+template<typename T>
+class ValueColumns {
+public:
+    explicit ValueColumns(size_t capacity) {
+        _objectIds.reserve(capacity);
+        _attributeIndexes.reserve(capacity);
+        _values.reserve(capacity);
+    }
+
+    void add(long objectId, int attributeIndex, T value) {
+        _objectIds.push_back(objectId);
+        _attributeIndexes.push_back(attributeIndex);
+        _values.push_back(value);
+    }
+
+    size_t size() const {
+        return _values.size();
+    }
+
+    void clear() {
+        _objectIds.clear();
+        _attributeIndexes.clear();
+        _values.clear();
+    }
+
+    std::vector<int64_t> _objectIds;
+    std::vector<int32_t> _attributeIndexes;
+    std::vector<T> _values;
+};
+
+/**
+ * Accumulates integer, long, double and object scalar values, and string codes with the dictionary, into native columns and hands them to the Java
+ * data object builder as direct byte buffers, with one flushBatch upcall each time a column reaches the batch size.
+ * String, vector and matrix values are still forwarded one by one. Only to be used with a builder supporting batches.
+ */
+class BatchedJniDataObjectHandler : public JniDataObjectHandler {
+public:
+    BatchedJniDataObjectHandler(const jni::ComPowsyblPowerFactoryDbDataObjectBuilder& objectBuilder, size_t batchSize,
+                                bool stringDictionary = false);
+
+    // batched as codes with the dictionary, one by one otherwise
+    void setStringAttributeValue(long objectId, const std::string& attributeName, const std::string& value) override;
+
+    void setIntAttributeValue(long objectId, const std::string& attributeName, int value) override;
+
+    void setLongAttributeValue(long objectId, const std::string& attributeName, long value) override;
+
+    void setDoubleAttributeValue(long objectId, const std::string& attributeName, double value) override;
+
+    void setObjectAttributeValue(long objectId, const std::string& attributeName, long otherObjectId) override;
+
+    void flush() override;
+
+private:
+    int getAttributeIndex(const std::string& attributeName);
+
+    template<typename T>
+    void add(ValueColumns<T>& columns, int type, long objectId, const std::string& attributeName, T value);
+
+    template<typename T>
+    void flush(ValueColumns<T>& columns, int type);
+
+    size_t _batchSize;
+
+    std::map<std::string, int> _attributeIndexes;
+
+    ValueColumns<int32_t> _intColumns;
+    ValueColumns<int64_t> _longColumns;
+    ValueColumns<double> _doubleColumns;
+    ValueColumns<int64_t> _objectColumns;
+    ValueColumns<int32_t> _stringCodeColumns;
+};
+
+}
+
+}
+
+#endif //POWSYBL_POWERFACTORY_DB_NATIVE_JNIDATAOBJECTHANDLER_H
@@ -0,0 +1,124 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file ObjectRegistry.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include "ObjectRegistry.h"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+namespace {
+
+size_t getSlotCount(size_t size) {
+    size_t slotCount = 16;
+    while (slotCount < size * 2) {
+        slotCount <<= 1;
+    }
+    return slotCount;
+}
+
+int getShift(size_t slotCount) {
+    int shift = 64;
+    while (slotCount > 1) {
+        slotCount >>= 1;
+        shift--;
+    }
+    return shift;
+}
+
+// Fibonacci hashing: multiplied by 2^64 divided by the golden ratio, the high bits are the slot. They depend on all
+// the bits of the pointer, including the high ones, whereas the low bits are always zero because of alignment.
+size_t hash(api::v2::DataObject* object, int shift) {
+    uint64_t h = (uint64_t) reinterpret_cast<uintptr_t>(object) * 0x9E3779B97F4A7C15ULL;
+    return (size_t) (h >> shift);
+}
+
+}
+
+ObjectRegistry::ObjectRegistry(size_t expectedSize)
+    : _slots(getSlotCount(expectedSize), -1),
+      _mask(_slots.size() - 1),
+      _shift(getShift(_slots.size())) {
+    _objects.reserve(expectedSize);
+}
+
+size_t ObjectRegistry::getSlot(api::v2::DataObject* object) const {
+    size_t slot = hash(object, _shift);
+    while (_slots[slot] != -1 && _objects[_slots[slot]] != object) {
+        slot = (slot + 1) & _mask;
+    }
+    return slot;
+}
+
+void ObjectRegistry::rehash(size_t slotCount) {
+    _slots.assign(slotCount, -1);
+    _mask = slotCount - 1;
+    _shift = getShift(slotCount);
+    for (size_t id = 0; id < _objects.size(); id++) {
+        _slots[getSlot(_objects[id])] = (long) id;
+    }
+}
+
+void ObjectRegistry::reserve(size_t size) {
+    _objects.reserve(size);
+    size_t slotCount = getSlotCount(size);
+    if (slotCount > _slots.size()) {
+        rehash(slotCount);
+    }
+}
+
+long ObjectRegistry::add(api::v2::DataObject* object) {
+    if (!object) {
+        return -1;
+    }
+    size_t slot = getSlot(object);
+    if (_slots[slot] != -1) {
+        return _slots[slot];
+    }
+    long id = (long) _objects.size();
+    _objects.push_back(object);
+    _slots[slot] = id;
+    if (_objects.size() * 2 > _slots.size()) {
+        rehash(_slots.size() * 2);
+    }
+    return id;
+}
+
+void ObjectRegistry::addAll(const std::vector<api::v2::DataObject*>& objects) {
+    // growing geometrically, reserving the exact size on each call would copy all objects each time a few are added
+    size_t size = _objects.size() + objects.size();
+    if (size > _objects.capacity()) {
+        reserve(std::max(size, 2 * _objects.capacity()));
+    }
+    for (auto object : objects) {
+        add(object);
+    }
+}
+
+long ObjectRegistry::find(api::v2::DataObject* object) const {
+    if (!object) {
+        return -1;
+    }
+    return _slots[getSlot(object)];
+}
+
+api::v2::DataObject* ObjectRegistry::get(long id) const {
+    if (id < 0 || (size_t) id >= _objects.size()) {
+        throw std::runtime_error("Object " + std::to_string(id) + " not found");
+    }
+    return _objects[id];
+}
+
+}
+
+}
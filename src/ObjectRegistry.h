@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file ObjectRegistry.h
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#ifndef POWSYBL_POWERFACTORY_DB_NATIVE_OBJECTREGISTRY_H
+#define POWSYBL_POWERFACTORY_DB_NATIVE_OBJECTREGISTRY_H
+
+#include <cstddef>
+#include <vector>
+
+namespace api {
+
+namespace v2 {
+
+class DataObject;
+
+}
+
+}
+
+namespace powsybl {
+
+namespace powerfactory {
+
+/**
+ * Assigns dense ids, in registration order, to data objects. Object to id lookup goes through an open addressing
+ * hash table with linear probing, id to object lookup is a direct vector access.
+ */
+class ObjectRegistry {
+public:
+    explicit ObjectRegistry(size_t expectedSize = 1024);
+
+    // id of the object, registered first if needed, -1 for a null object
+    long add(api::v2::DataObject* object);
+
+    void addAll(const std::vector<api::v2::DataObject*>& objects);
+
+    // -1 if the object is not registered
+    long find(api::v2::DataObject* object) const;
+
+    api::v2::DataObject* get(long id) const;
+
+    // avoids rehashing while the given number of objects is registered
+    void reserve(size_t size);
+
+    size_t size() const {
+        return _objects.size();
+    }
+
+    const std::vector<api::v2::DataObject*>& getObjects() const {
+        return _objects;
+    }
+
+private:
+    size_t getSlot(api::v2::DataObject* object) const;
+
+    void rehash(size_t slotCount);
+
+    std::vector<api::v2::DataObject*> _objects;
+
+    // id of the object in each slot, -1 for an empty slot, load factor is kept under 1/2
+    std::vector<long> _slots;
+    size_t _mask;
+    // 64 minus the number of bits of a slot index
+    int _shift;
+};
+
+}
+
+}
+
+#endif //POWSYBL_POWERFACTORY_DB_NATIVE_OBJECTREGISTRY_H
@@ -0,0 +1,334 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file ParallelRead.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include "AttributeValue.h"
+#include "ParallelRead.h"
+#include "ProjectReader.h"
+#include "Snapshot.h"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+namespace {
+
+std::string getLibrarySnapshotFile(const std::string& snapshotFile) {
+    return snapshotFile + ".library";
+}
+
+std::string getLibraryIndexFile(const std::string& snapshotFile) {
+    return snapshotFile + ".index";
+}
+
+// only keeps ids of created objects
+class ObjectIdCollector : public AttributeValueHandler {
+public:
+    void createClass(const std::string&) override {
+    }
+
+    void createAttribute(const std::string&, const std::string&, int, const std::string&) override {
+    }
+
+    void createObject(long id, const std::string&, long) override {
+        _ids.push_back(id);
+    }
+
+    void setObjectParent(long, long) override {
+    }
+
+    std::vector<long> _ids;
+
+protected:
+    void setAttributeValue(long, AttributeValue&&) override {
+    }
+};
+
+// worker ids to merged ids
+struct IdMapping {
+    // added to ids of the worker that are not library objects
+    long _offset = 0;
+    std::unordered_map<long, long> _libraryIds;
+    // library objects already merged from a previous worker
+    std::unordered_set<long> _skippedIds;
+
+    long map(long id) const {
+        if (id == -1) {
+            return -1;
+        }
+        auto it = _libraryIds.find(id);
+        return it != _libraryIds.end() ? it->second : _offset + id;
+    }
+
+    bool isSkipped(long id) const {
+        return _skippedIds.find(id) != _skippedIds.end();
+    }
+};
+
+/**
+ * Forwards to a handler with merged ids, skipping objects already merged. Classes and attributes are declared once
+ * whatever the number of snapshots replayed through it.
+ */
+class IdMappingDataObjectHandler : public DataObjectHandler {
+public:
+    IdMappingDataObjectHandler(DataObjectHandler& handler, bool forwardFlush)
+        : _handler(handler),
+          _forwardFlush(forwardFlush) {
+    }
+
+    void setMapping(const IdMapping* mapping) {
+        _mapping = mapping;
+    }
+
+    void createClass(const std::string& name) override {
+        if (_classNames.insert(name).second) {
+            _handler.createClass(name);
+        }
+    }
+
+    void createAttribute(const std::string& className, const std::string& attributeName, int type, const std::string& description) override {
+        if (_attributes.insert({className, attributeName}).second) {
+            _handler.createAttribute(className, attributeName, type, description);
+        }
+    }
+
+    void createObject(long id, const std::string& className, long parentId) override {
+        if (!_mapping->isSkipped(id)) {
+            _handler.createObject(_mapping->map(id), className, _mapping->map(parentId));
+        }
+    }
+
+    void setObjectParent(long id, long parentId) override {
+        if (!_mapping->isSkipped(id)) {
+            _handler.setObjectParent(_mapping->map(id), _mapping->map(parentId));
+        }
+    }
+
+    void setStringAttributeValue(long objectId, const std::string& attributeName, const std::string& value) override {
+        if (!_mapping->isSkipped(objectId)) {
+            _handler.setStringAttributeValue(_mapping->map(objectId), attributeName, value);
+        }
+    }
+
+    void setIntAttributeValue(long objectId, const std::string& attributeName, int value) override {
+        if (!_mapping->isSkipped(objectId)) {
+            _handler.setIntAttributeValue(_mapping->map(objectId), attributeName, value);
+        }
+    }
+
+    void setLongAttributeValue(long objectId, const std::string& attributeName, long value) override {
+        if (!_mapping->isSkipped(objectId)) {
+            _handler.setLongAttributeValue(_mapping->map(objectId), attributeName, value);
+        }
+    }
+
+    void setDoubleAttributeValue(long objectId, const std::string& attributeName, double value) override {
+        if (!_mapping->isSkipped(objectId)) {
+            _handler.setDoubleAttributeValue(_mapping->map(objectId), attributeName, value);
+        }
+    }
+
+    void setObjectAttributeValue(long objectId, const std::string& attributeName, long otherObjectId) override {
+        if (!_mapping->isSkipped(objectId)) {
+            _handler.setObjectAttributeValue(_mapping->map(objectId), attributeName, _mapping->map(otherObjectId));
+        }
+    }
+
+    void setIntVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int>& value) override {
+        if (!_mapping->isSkipped(objectId)) {
+            _handler.setIntVectorAttributeValue(_mapping->map(objectId), attributeName, value);
+        }
+    }
+
+    void setLongVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& value) override {
+        if (!_mapping->isSkipped(objectId)) {
+            _handler.setLongVectorAttributeValue(_mapping->map(objectId), attributeName, value);
+        }
+    }
+
+    void setDoubleVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<double>& value) override {
+        if (!_mapping->isSkipped(objectId)) {
+            _handler.setDoubleVectorAttributeValue(_mapping->map(objectId), attributeName, value);
+        }
+    }
+
+    void setStringVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<std::string>& value) override {
+        if (!_mapping->isSkipped(objectId)) {
+            _handler.setStringVectorAttributeValue(_mapping->map(objectId), attributeName, value);
+        }
+    }
+
+    void setObjectVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& otherObjectsIds) override {
+        if (!_mapping->isSkipped(objectId)) {
+            _idBuffer.clear();
+            for (auto otherObjectId : otherObjectsIds) {
+                _idBuffer.push_back(_mapping->map((long) otherObjectId));
+            }
+            _handler.setObjectVectorAttributeValue(_mapping->map(objectId), attributeName, _idBuffer);
+        }
+    }
+
+    void setDoubleMatrixAttributeValue(long objectId, const std::string& attributeName, int rowCount, int columnCount, const std::vector<double>& value) override {
+        if (!_mapping->isSkipped(objectId)) {
+            _handler.setDoubleMatrixAttributeValue(_mapping->map(objectId), attributeName, rowCount, columnCount, value);
+        }
+    }
+
+    void flush() override {
+        if (_forwardFlush) {
+            _handler.flush();
+        }
+    }
+
+private:
+    DataObjectHandler& _handler;
+    const bool _forwardFlush;
+    const IdMapping* _mapping = nullptr;
+    std::set<std::string> _classNames;
+    std::set<std::pair<std::string, std::string>> _attributes;
+    std::vector<int64_t> _idBuffer;
+};
+
+}
+
+std::vector<std::string> toWorkerArguments(const ReadOptions& options) {
+    std::vector<std::string> arguments;
+    if (options._breadthFirst) {
+        arguments.emplace_back("--breadth-first");
+    }
+    if (options._schemaFirst) {
+        arguments.emplace_back("--schema-first");
+    }
+    if (options._maxReferenceDepth > 0) {
+        arguments.insert(arguments.end(), {"--max-reference-depth", std::to_string(options._maxReferenceDepth)});
+    }
+    for (const auto& className : options._classNames) {
+        arguments.insert(arguments.end(), {"--class", className});
+    }
+    for (const auto& e : options._attributeNames) {
+        for (const auto& attributeName : e.second) {
+            arguments.insert(arguments.end(), {"--attribute", e.first, attributeName});
+        }
+    }
+    for (const auto& pattern : options._excludedSubtreePatterns) {
+        arguments.insert(arguments.end(), {"--exclude", pattern});
+    }
+    return arguments;
+}
+
+ReadOptions parseWorkerArguments(const std::vector<std::string>& arguments) {
+    ReadOptions options;
+    auto next = [&](size_t& i) -> const std::string& {
+        if (++i >= arguments.size()) {
+            throw std::runtime_error("Missing value for worker option '" + arguments[i - 1] + "'");
+        }
+        return arguments[i];
+    };
+    for (size_t i = 0; i < arguments.size(); i++) {
+        const std::string& argument = arguments[i];
+        if (argument == "--breadth-first") {
+            options._breadthFirst = true;
+        } else if (argument == "--schema-first") {
+            options._schemaFirst = true;
+        } else if (argument == "--max-reference-depth") {
+            options._maxReferenceDepth = std::stoi(next(i));
+        } else if (argument == "--class") {
+            options._classNames.insert(next(i));
+        } else if (argument == "--attribute") {
+            const std::string& className = next(i);
+            options._attributeNames[className].insert(next(i));
+        } else if (argument == "--exclude") {
+            options._excludedSubtreePatterns.push_back(next(i));
+        } else {
+            throw std::runtime_error("Unknown worker option '" + argument + "'");
+        }
+    }
+    return options;
+}
+
+void writeWorkerSnapshots(Api& api, const std::string& projectName, const std::string& snapshotFile,
+                          const ReadOptions& options) {
+    // referenced objects are always read, so that references of the project never dangle
+    ReadOptions workerOptions = options;
+    workerOptions._readReferences = true;
+
+    SnapshotWriter projectWriter(snapshotFile);
+    SnapshotWriter libraryWriter(getLibrarySnapshotFile(snapshotFile));
+    ObjectIdCollector libraryIds;
+    TeeDataObjectHandler libraryHandler(libraryWriter, libraryIds);
+    SchemaCache schemaCache;
+    readProjects(api, schemaCache, {projectName}, {&projectWriter}, libraryHandler, workerOptions);
+
+    // number of ids used by the worker, then one line per library object: id and full name
+    std::ofstream index(getLibraryIndexFile(snapshotFile));
+    index << api._registry.size() << '\n';
+    for (long id : libraryIds._ids) {
+        auto fullName = api.makeValueUniquePtr(api.getObject(id)->GetFullName());
+        index << id << ' ' << fullName->GetString() << '\n';
+    }
+    if (!index) {
+        throw std::runtime_error("Cannot write '" + getLibraryIndexFile(snapshotFile) + "'");
+    }
+}
+
+void mergeWorkerSnapshots(const std::vector<std::string>& snapshotFiles, const std::vector<DataObjectHandler*>& handlers,
+                          DataObjectHandler& libraryHandler) {
+    if (snapshotFiles.size() != handlers.size()) {
+        throw std::runtime_error("One handler is expected per snapshot");
+    }
+
+    // merged id of each library object, by full name
+    std::unordered_map<std::string, long> libraryIds;
+    IdMappingDataObjectHandler libraryMappingHandler(libraryHandler, false);
+    long offset = 0;
+    for (size_t i = 0; i < snapshotFiles.size(); i++) {
+        std::ifstream index(getLibraryIndexFile(snapshotFiles[i]));
+        long idCount;
+        if (!(index >> idCount)) {
+            throw std::runtime_error("Cannot read '" + getLibraryIndexFile(snapshotFiles[i]) + "'");
+        }
+        IdMapping mapping;
+        mapping._offset = offset;
+        long id;
+        std::string fullName;
+        while (index >> id && index.get() == ' ' && std::getline(index, fullName)) {
+            auto it = libraryIds.emplace(fullName, offset + id);
+            mapping._libraryIds.emplace(id, it.first->second);
+            if (!it.second) {
+                mapping._skippedIds.insert(id);
+            }
+        }
+
+        IdMappingDataObjectHandler projectMappingHandler(*handlers[i], true);
+        projectMappingHandler.setMapping(&mapping);
+        SnapshotReader(snapshotFiles[i]).read(projectMappingHandler);
+
+        libraryMappingHandler.setMapping(&mapping);
+        SnapshotReader(getLibrarySnapshotFile(snapshotFiles[i])).read(libraryMappingHandler);
+
+        offset += idCount;
+    }
+
+    libraryHandler.flush();
+}
+
+void removeWorkerSnapshots(const std::string& snapshotFile) {
+    std::remove(snapshotFile.c_str());
+    std::remove(getLibrarySnapshotFile(snapshotFile).c_str());
+    std::remove(getLibraryIndexFile(snapshotFile).c_str());
+}
+
+}
+
+}
@@ -0,0 +1,45 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file ParallelRead.h
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#ifndef POWSYBL_POWERFACTORY_DB_NATIVE_PARALLELREAD_H
+#define POWSYBL_POWERFACTORY_DB_NATIVE_PARALLELREAD_H
+
+#include "Api.h"
+#include "DataObjectHandler.h"
+#include "ReadOptions.h"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+// read options that change what a worker reads, as worker command line arguments
+std::vector<std::string> toWorkerArguments(const ReadOptions& options);
+
+ReadOptions parseWorkerArguments(const std::vector<std::string>& arguments);
+
+// reads a project in a worker process. Besides the project snapshot, objects outside of the project it references
+// are written to '<snapshot file>.library', and their full names to '<snapshot file>.index' so that they can be
+// matched across workers.
+void writeWorkerSnapshots(Api& api, const std::string& projectName, const std::string& snapshotFile,
+                          const ReadOptions& options);
+
+// replays worker snapshots as readProjects would have read them with a single engine: each project to its own
+// handler, and referenced objects outside of the projects once to the library handler, matched by full name. Ids are
+// renumbered so that they do not overlap between projects and library objects keep the same id in all projects.
+void mergeWorkerSnapshots(const std::vector<std::string>& snapshotFiles, const std::vector<DataObjectHandler*>& handlers,
+                          DataObjectHandler& libraryHandler);
+
+// removes all the files written by writeWorkerSnapshots
+void removeWorkerSnapshots(const std::string& snapshotFile);
+
+}
+
+}
+
+#endif //POWSYBL_POWERFACTORY_DB_NATIVE_PARALLELREAD_H
@@ -0,0 +1,431 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file Pipeline.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include <exception>
+#include <thread>
+#include "Pipeline.h"
+#include "v2/Api.hpp"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+namespace {
+
+// attempts before going to sleep, enough to cover the time the other thread needs to handle a record
+const int SPIN_COUNT = 256;
+
+// ready is retried under the lock once the waiting flag is published, so that a wake up cannot be missed
+template<typename Predicate>
+void spinThenBlock(Predicate ready, std::mutex& mutex, std::condition_variable& condition, std::atomic<bool>& waiting) {
+    for (int i = 0; i < SPIN_COUNT; i++) {
+        if (ready()) {
+            return;
+        }
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    waiting.store(true);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    condition.wait(lock, ready);
+    waiting.store(false);
+}
+
+void wakeUp(std::mutex& mutex, std::condition_variable& condition, std::atomic<bool>& waiting) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        condition.notify_one();
+    }
+}
+
+}
+
+class Pipeline::ProducerHandler : public DataObjectHandler {
+public:
+    ProducerHandler(Pipeline& pipeline, bool chunkedValueSupported)
+        : _pipeline(pipeline),
+          _chunkedValueSupported(chunkedValueSupported) {
+    }
+
+    void createClass(const std::string& name) override {
+        PipelineRecord record;
+        record._kind = PipelineRecord::Kind::CREATE_CLASS;
+        record._className = intern(name);
+        _pipeline.push(std::move(record));
+    }
+
+    void createAttribute(const std::string& className, const std::string& attributeName, int type, const std::string& description) override {
+        PipelineRecord record;
+        record._kind = PipelineRecord::Kind::CREATE_ATTRIBUTE;
+        record._className = intern(className);
+        record._attributeName = intern(attributeName);
+        record._type = type;
+        record._description = description;
+        _pipeline.push(std::move(record));
+    }
+
+    void createSchema(const std::vector<ClassSchema>& schemas) override {
+        PipelineRecord record;
+        record._kind = PipelineRecord::Kind::CREATE_SCHEMA;
+        record._schemas = schemas;
+        _pipeline.push(std::move(record));
+    }
+
+    void createObject(long id, const std::string& className, long parentId) override {
+        PipelineRecord record;
+        record._kind = PipelineRecord::Kind::CREATE_OBJECT;
+        record._id = id;
+        record._className = intern(className);
+        record._parentId = parentId;
+        _pipeline.push(std::move(record));
+    }
+
+    void setObjectParent(long id, long parentId) override {
+        PipelineRecord record;
+        record._kind = PipelineRecord::Kind::SET_OBJECT_PARENT;
+        record._id = id;
+        record._parentId = parentId;
+        _pipeline.push(std::move(record));
+    }
+
+    void setStringAttributeValue(long objectId, const std::string& attributeName, const std::string& value) override {
+        PipelineRecord record = createValue(objectId, attributeName, api::v2::DataObject::AttributeType::TYPE_STRING);
+        record._string = value;
+        _pipeline.push(std::move(record));
+    }
+
+    void setIntAttributeValue(long objectId, const std::string& attributeName, int value) override {
+        PipelineRecord record = createValue(objectId, attributeName, api::v2::DataObject::AttributeType::TYPE_INTEGER);
+        record._long = value;
+        _pipeline.push(std::move(record));
+    }
+
+    void setLongAttributeValue(long objectId, const std::string& attributeName, long value) override {
+        PipelineRecord record = createValue(objectId, attributeName, api::v2::DataObject::AttributeType::TYPE_INTEGER64);
+        record._long = value;
+        _pipeline.push(std::move(record));
+    }
+
+    void setDoubleAttributeValue(long objectId, const std::string& attributeName, double value) override {
+        PipelineRecord record = createValue(objectId, attributeName, api::v2::DataObject::AttributeType::TYPE_DOUBLE);
+        record._double = value;
+        _pipeline.push(std::move(record));
+    }
+
+    void setObjectAttributeValue(long objectId, const std::string& attributeName, long otherObjectId) override {
+        PipelineRecord record = createValue(objectId, attributeName, api::v2::DataObject::AttributeType::TYPE_OBJECT);
+        record._long = otherObjectId;
+        _pipeline.push(std::move(record));
+    }
+
+    void setIntVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int>& value) override {
+        PipelineRecord record = createValue(objectId, attributeName, api::v2::DataObject::AttributeType::TYPE_INTEGER_VEC);
+        record._ints = value;
+        _pipeline.push(std::move(record));
+    }
+
+    void setLongVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& value) override {
+        PipelineRecord record = createValue(objectId, attributeName, api::v2::DataObject::AttributeType::TYPE_INTEGER64_VEC);
+        record._longs = value;
+        _pipeline.push(std::move(record));
+    }
+
+    void setDoubleVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<double>& value) override {
+        PipelineRecord record = createValue(objectId, attributeName, api::v2::DataObject::AttributeType::TYPE_DOUBLE_VEC);
+        record._doubles = value;
+        _pipeline.push(std::move(record));
+    }
+
+    void setStringVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<std::string>& value) override {
+        PipelineRecord record = createValue(objectId, attributeName, api::v2::DataObject::AttributeType::TYPE_STRING_VEC);
+        record._strings = value;
+        _pipeline.push(std::move(record));
+    }
+
+    void setObjectVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& otherObjectsIds) override {
+        PipelineRecord record = createValue(objectId, attributeName, api::v2::DataObject::AttributeType::TYPE_OBJECT_VEC);
+        record._longs = otherObjectsIds;
+        _pipeline.push(std::move(record));
+    }
+
+    void setDoubleMatrixAttributeValue(long objectId, const std::string& attributeName, int rowCount, int columnCount, const std::vector<double>& value) override {
+        PipelineRecord record = createValue(objectId, attributeName, api::v2::DataObject::AttributeType::TYPE_DOUBLE_MAT);
+        record._rowCount = rowCount;
+        record._columnCount = columnCount;
+        record._doubles = value;
+        _pipeline.push(std::move(record));
+    }
+
+    // chunks are forwarded as they come, so that large values are not gathered on the producer side
+    bool isChunkedValueSupported() const override {
+        return _chunkedValueSupported;
+    }
+
+    void beginAttributeValue(long objectId, const std::string& attributeName, int type, int rowCount, int columnCount) override {
+        PipelineRecord record = createValue(objectId, attributeName, type);
+        record._kind = PipelineRecord::Kind::BEGIN_VALUE;
+        record._rowCount = rowCount;
+        record._columnCount = columnCount;
+        _pipeline.push(std::move(record));
+    }
+
+    void appendIntValues(const int* values, size_t count) override {
+        PipelineRecord record;
+        record._kind = PipelineRecord::Kind::APPEND_INT_VALUES;
+        record._ints.assign(values, values + count);
+        _pipeline.push(std::move(record));
+    }
+
+    void appendLongValues(const int64_t* values, size_t count) override {
+        PipelineRecord record;
+        record._kind = PipelineRecord::Kind::APPEND_LONG_VALUES;
+        record._longs.assign(values, values + count);
+        _pipeline.push(std::move(record));
+    }
+
+    void appendDoubleValues(const double* values, size_t count) override {
+        PipelineRecord record;
+        record._kind = PipelineRecord::Kind::APPEND_DOUBLE_VALUES;
+        record._doubles.assign(values, values + count);
+        _pipeline.push(std::move(record));
+    }
+
+    void endAttributeValue() override {
+        PipelineRecord record;
+        record._kind = PipelineRecord::Kind::END_VALUE;
+        _pipeline.push(std::move(record));
+    }
+
+    void updateObject(long id) override {
+        PipelineRecord record;
+        record._kind = PipelineRecord::Kind::UPDATE_OBJECT;
+        record._id = id;
+        _pipeline.push(std::move(record));
+    }
+
+    void deleteObject(long id) override {
+        PipelineRecord record;
+        record._kind = PipelineRecord::Kind::DELETE_OBJECT;
+        record._id = id;
+        _pipeline.push(std::move(record));
+    }
+
+    void flush() override {
+        PipelineRecord record;
+        record._kind = PipelineRecord::Kind::FLUSH;
+        _pipeline.push(std::move(record));
+    }
+
+private:
+    const std::string* intern(const std::string& name) {
+        return &*_pipeline._names.insert(name).first;
+    }
+
+    PipelineRecord createValue(long objectId, const std::string& attributeName, int type) {
+        PipelineRecord record;
+        record._kind = PipelineRecord::Kind::VALUE;
+        record._id = objectId;
+        record._attributeName = intern(attributeName);
+        record._type = type;
+        return record;
+    }
+
+    Pipeline& _pipeline;
+    const bool _chunkedValueSupported;
+};
+
+namespace {
+
+void emitValue(const PipelineRecord& record, DataObjectHandler& handler) {
+    const std::string& attributeName = *record._attributeName;
+    switch (record._type) {
+        case api::v2::DataObject::AttributeType::TYPE_STRING:
+            handler.setStringAttributeValue(record._id, attributeName, record._string);
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER:
+            handler.setIntAttributeValue(record._id, attributeName, (int) record._long);
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER64:
+            handler.setLongAttributeValue(record._id, attributeName, (long) record._long);
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_DOUBLE:
+            handler.setDoubleAttributeValue(record._id, attributeName, record._double);
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_OBJECT:
+            handler.setObjectAttributeValue(record._id, attributeName, (long) record._long);
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER_VEC:
+            handler.setIntVectorAttributeValue(record._id, attributeName, record._ints);
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER64_VEC:
+            handler.setLongVectorAttributeValue(record._id, attributeName, record._longs);
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_DOUBLE_VEC:
+            handler.setDoubleVectorAttributeValue(record._id, attributeName, record._doubles);
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_STRING_VEC:
+            handler.setStringVectorAttributeValue(record._id, attributeName, record._strings);
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_OBJECT_VEC:
+            handler.setObjectVectorAttributeValue(record._id, attributeName, record._longs);
+            break;
+
+        case api::v2::DataObject::AttributeType::TYPE_DOUBLE_MAT:
+            handler.setDoubleMatrixAttributeValue(record._id, attributeName, record._rowCount, record._columnCount, record._doubles);
+            break;
+
+        default:
+            throw std::runtime_error("Unsupported attribute type " + std::to_string(record._type));
+    }
+}
+
+}
+
+Pipeline::Pipeline(size_t capacity)
+    : _records(capacity) {
+}
+
+bool Pipeline::waitForPush(PipelineRecord&& record) {
+    bool pushed = false;
+    spinThenBlock([this, &record, &pushed]() {
+        pushed = _records.tryPush(std::move(record));
+        return pushed || _cancelled.load();
+    }, _mutex, _notFull, _producerWaiting);
+    if (pushed) {
+        wakeUp(_mutex, _notEmpty, _consumerWaiting);
+    }
+    return pushed;
+}
+
+void Pipeline::push(PipelineRecord&& record) {
+    if (!waitForPush(std::move(record))) {
+        throw std::runtime_error("Pipeline cancelled");
+    }
+}
+
+void Pipeline::pop(PipelineRecord& record) {
+    spinThenBlock([this, &record]() {
+        return _records.tryPop(record);
+    }, _mutex, _notEmpty, _consumerWaiting);
+    wakeUp(_mutex, _notFull, _producerWaiting);
+}
+
+void Pipeline::cancel() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _cancelled = true;
+    }
+    _notFull.notify_one();
+}
+
+void Pipeline::run(const std::function<void(DataObjectHandler&)>& reader, DataObjectHandler& handler) {
+    std::exception_ptr producerException;
+    bool chunkedValueSupported = handler.isChunkedValueSupported();
+    std::thread producer([this, &reader, &producerException, chunkedValueSupported]() {
+        try {
+            ProducerHandler producerHandler(*this, chunkedValueSupported);
+            reader(producerHandler);
+        } catch (...) {
+            producerException = std::current_exception();
+        }
+        // end record is always sent, unless consumer is already gone
+        waitForPush(PipelineRecord());
+    });
+
+    try {
+        PipelineRecord record;
+        bool end = false;
+        while (!end) {
+            pop(record);
+            switch (record._kind) {
+                case PipelineRecord::Kind::CREATE_CLASS:
+                    handler.createClass(*record._className);
+                    break;
+
+                case PipelineRecord::Kind::CREATE_ATTRIBUTE:
+                    handler.createAttribute(*record._className, *record._attributeName, record._type, record._description);
+                    break;
+
+                case PipelineRecord::Kind::CREATE_SCHEMA:
+                    handler.createSchema(record._schemas);
+                    break;
+
+                case PipelineRecord::Kind::CREATE_OBJECT:
+                    handler.createObject(record._id, *record._className, record._parentId);
+                    break;
+
+                case PipelineRecord::Kind::SET_OBJECT_PARENT:
+                    handler.setObjectParent(record._id, record._parentId);
+                    break;
+
+                case PipelineRecord::Kind::UPDATE_OBJECT:
+                    handler.updateObject(record._id);
+                    break;
+
+                case PipelineRecord::Kind::DELETE_OBJECT:
+                    handler.deleteObject(record._id);
+                    break;
+
+                case PipelineRecord::Kind::VALUE:
+                    emitValue(record, handler);
+                    break;
+
+                case PipelineRecord::Kind::BEGIN_VALUE:
+                    handler.beginAttributeValue(record._id, *record._attributeName, record._type, record._rowCount, record._columnCount);
+                    break;
+
+                case PipelineRecord::Kind::APPEND_INT_VALUES:
+                    handler.appendIntValues(record._ints.data(), record._ints.size());
+                    break;
+
+                case PipelineRecord::Kind::APPEND_LONG_VALUES:
+                    handler.appendLongValues(record._longs.data(), record._longs.size());
+                    break;
+
+                case PipelineRecord::Kind::APPEND_DOUBLE_VALUES:
+                    handler.appendDoubleValues(record._doubles.data(), record._doubles.size());
+                    break;
+
+                case PipelineRecord::Kind::END_VALUE:
+                    handler.endAttributeValue();
+                    break;
+
+                case PipelineRecord::Kind::FLUSH:
+                    handler.flush();
+                    break;
+
+                case PipelineRecord::Kind::END:
+                    end = true;
+                    break;
+            }
+        }
+    } catch (...) {
+        cancel();
+        producer.join();
+        throw;
+    }
+
+    producer.join();
+    if (producerException) {
+        std::rethrow_exception(producerException);
+    }
+}
+
+}
+
+}
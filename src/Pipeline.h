@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file Pipeline.h
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#ifndef POWSYBL_POWERFACTORY_DB_NATIVE_PIPELINE_H
+#define POWSYBL_POWERFACTORY_DB_NATIVE_PIPELINE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <unordered_set>
+#include "DataObjectHandler.h"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+/**
+ * Bounded lock-free ring buffer for exactly one producer thread and one consumer thread.
+ */
+template<typename T>
+class SpscRingBuffer {
+public:
+    explicit SpscRingBuffer(size_t capacity)
+        : _buffer(roundUpToPowerOfTwo(capacity)),
+          _mask(_buffer.size() - 1) {
+    }
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    bool tryPush(T&& value) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) == _buffer.size()) {
+            return false;
+        }
+        _buffer[head & _mask] = std::move(value);
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& value) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = std::move(_buffer[tail & _mask]);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static size_t roundUpToPowerOfTwo(size_t n) {
+        size_t size = 1;
+        while (size < n) {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    std::vector<T> _buffer;
+    const size_t _mask;
+    // on separate cache lines to avoid false sharing between producer and consumer
+    alignas(64) std::atomic<size_t> _head{0};
+    alignas(64) std::atomic<size_t> _tail{0};
+};
+
+struct PipelineRecord {
+    enum class Kind {
+        CREATE_CLASS,
+        CREATE_ATTRIBUTE,
+        CREATE_SCHEMA,
+        CREATE_OBJECT,
+        SET_OBJECT_PARENT,
+        UPDATE_OBJECT,
+        DELETE_OBJECT,
+        VALUE,
+        BEGIN_VALUE,
+        APPEND_INT_VALUES,
+        APPEND_LONG_VALUES,
+        APPEND_DOUBLE_VALUES,
+        END_VALUE,
+        FLUSH,
+        END,
+    };
+
+    Kind _kind = Kind::END;
+    long _id = -1;
+    long _parentId = -1;
+    // class and attribute names are interned by the pipeline for the whole run, so that records do not copy them
+    const std::string* _className = nullptr;
+    const std::string* _attributeName = nullptr;
+    std::string _description;
+    int _type = 0;
+    int _rowCount = 0;
+    int _columnCount = 0;
+    // scalar values are stored inline, vectors, matrices and chunks in the buffer of their type
+    int64_t _long = 0;
+    double _double = 0;
+    std::string _string;
+    std::vector<int> _ints;
+    std::vector<int64_t> _longs;
+    std::vector<double> _doubles;
+    std::vector<std::string> _strings;
+    std::vector<ClassSchema> _schemas;
+};
+
+/**
+ * Runs a reader, typically the PowerFactory API traversal, on its own thread and sends what it produces to a handler
+ * on the calling thread, so that reading and handling overlap. Records go through a bounded ring buffer so that a slow
+ * handler blocks the reader instead of growing memory. A thread that finds the buffer full, or empty, spins a little
+ * then sleeps until the other one wakes it up. Chunked values are forwarded chunk by chunk if the handler supports
+ * them.
+ */
+class Pipeline {
+public:
+    explicit Pipeline(size_t capacity);
+
+    void run(const std::function<void(DataObjectHandler&)>& reader, DataObjectHandler& handler);
+
+private:
+    class ProducerHandler;
+
+    // false if the consumer is gone, the record being dropped
+    bool waitForPush(PipelineRecord&& record);
+
+    void push(PipelineRecord&& record);
+
+    void pop(PipelineRecord& record);
+
+    void cancel();
+
+    SpscRingBuffer<PipelineRecord> _records;
+
+    // producer waiting for a free slot, consumer waiting for a record
+    std::mutex _mutex;
+    std::condition_variable _notFull;
+    std::condition_variable _notEmpty;
+    std::atomic<bool> _producerWaiting{false};
+    std::atomic<bool> _consumerWaiting{false};
+
+    // set by consumer when handler failed so that producer stops as soon as possible
+    std::atomic<bool> _cancelled{false};
+
+    // class and attribute names of the records, only added to by the producer
+    std::unordered_set<std::string> _names;
+};
+
+}
+
+}
+
+#endif //POWSYBL_POWERFACTORY_DB_NATIVE_PIPELINE_H
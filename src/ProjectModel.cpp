@@ -0,0 +1,191 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file ProjectModel.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include <algorithm>
+#include <unordered_set>
+#include "ProjectModel.h"
+#include "v2/Api.hpp"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+namespace {
+
+const char* const NAME_ATTRIBUTE = "loc_name";
+
+}
+
+void ProjectModel::createClass(const std::string& name) {
+    if (std::find(_classNames.begin(), _classNames.end(), name) == _classNames.end()) {
+        _classNames.push_back(name);
+    }
+}
+
+void ProjectModel::createAttribute(const std::string& className, const std::string& attributeName, int type, const std::string& description) {
+    _attributes.insert({{className, attributeName}, {type, description}});
+}
+
+void ProjectModel::createObject(long id, const std::string& className, long parentId) {
+    _objectIndexes.insert({id, _objects.size()});
+    _objects.push_back({id, className, parentId, {}});
+}
+
+void ProjectModel::setObjectParent(long id, long parentId) {
+    _objects.at(_objectIndexes.at(id))._parentId = parentId;
+}
+
+void ProjectModel::setAttributeValue(long objectId, AttributeValue&& value) {
+    _objects.at(_objectIndexes.at(objectId))._values.push_back(std::move(value));
+}
+
+void ProjectModel::flush() {
+    // attribute order may differ between a read and a snapshot replay
+    for (auto& object : _objects) {
+        std::sort(object._values.begin(), object._values.end(), [](const AttributeValue& v1, const AttributeValue& v2) {
+            return v1._attributeName < v2._attributeName;
+        });
+    }
+}
+
+void ProjectModel::declareClass(const std::string& className, DataObjectHandler& handler) const {
+    handler.createClass(className);
+    for (auto it = _attributes.lower_bound({className, ""}); it != _attributes.end() && it->first.first == className; ++it) {
+        handler.createAttribute(className, it->first.second, it->second._type, it->second._description);
+    }
+}
+
+void ProjectModel::emitValues(const ModelObject& object, DataObjectHandler& handler) const {
+    for (const auto& value : object._values) {
+        emitValue(object._id, value, handler);
+    }
+}
+
+void ProjectModel::replay(DataObjectHandler& handler) const {
+    for (const auto& className : _classNames) {
+        declareClass(className, handler);
+    }
+    for (const auto& object : _objects) {
+        handler.createObject(object._id, object._className, object._parentId);
+        emitValues(object, handler);
+    }
+    handler.flush();
+}
+
+std::vector<std::string> ProjectModel::computePaths() const {
+    std::vector<std::string> paths(_objects.size());
+    std::map<std::string, int> pathCounts;
+    // parents always come before their children
+    for (size_t i = 0; i < _objects.size(); i++) {
+        const auto& object = _objects[i];
+        std::string name;
+        for (const auto& value : object._values) {
+            if (value._attributeName == NAME_ATTRIBUTE && !value._strings.empty()) {
+                name = value._strings.front();
+                break;
+            }
+        }
+        std::string path;
+        if (object._parentId != -1) {
+            path = paths.at(_objectIndexes.at(object._parentId));
+        }
+        path += "\\" + name + "." + object._className;
+        // should not happen as names are unique among siblings of same class, but stay deterministic anyway
+        int count = pathCounts[path]++;
+        if (count > 0) {
+            path += "#" + std::to_string(count);
+        }
+        paths[i] = path;
+    }
+    return paths;
+}
+
+void ProjectModel::remapIds(const ProjectModel& previousModel) {
+    std::unordered_map<std::string, long> previousIds;
+    long nextId = 0;
+    auto previousPaths = previousModel.computePaths();
+    for (size_t i = 0; i < previousModel._objects.size(); i++) {
+        long id = previousModel._objects[i]._id;
+        previousIds.insert({previousPaths[i], id});
+        nextId = std::max(nextId, id + 1);
+    }
+
+    std::unordered_map<long, long> idMapping;
+    auto paths = computePaths();
+    for (size_t i = 0; i < _objects.size(); i++) {
+        auto it = previousIds.find(paths[i]);
+        idMapping.insert({_objects[i]._id, it != previousIds.end() ? it->second : nextId++});
+    }
+
+    // objects outside of the model are unknown to the previous model too, references to them cannot be kept
+    auto mapId = [&idMapping](long id) {
+        auto it = idMapping.find(id);
+        return it != idMapping.end() ? it->second : -1;
+    };
+
+    _objectIndexes.clear();
+    for (size_t i = 0; i < _objects.size(); i++) {
+        auto& object = _objects[i];
+        object._id = mapId(object._id);
+        if (object._parentId != -1) {
+            object._parentId = mapId(object._parentId);
+        }
+        for (auto& value : object._values) {
+            if (isObjectReference(value._type)) {
+                for (auto& otherObjectId : value._longs) {
+                    otherObjectId = mapId((long) otherObjectId);
+                }
+            }
+        }
+        _objectIndexes.insert({object._id, i});
+    }
+}
+
+void ProjectModel::emitDelta(const ProjectModel& previousModel, DataObjectHandler& handler) const {
+    // deleted objects, children first
+    for (auto it = previousModel._objects.rbegin(); it != previousModel._objects.rend(); ++it) {
+        if (_objectIndexes.find(it->_id) == _objectIndexes.end()) {
+            handler.deleteObject(it->_id);
+        }
+    }
+
+    // classes are declared once, on first created or updated object of the class
+    std::unordered_set<std::string> declaredClassNames;
+    auto declare = [&](const std::string& className) {
+        if (declaredClassNames.insert(className).second) {
+            declareClass(className, handler);
+        }
+    };
+
+    for (const auto& object : _objects) {
+        auto it = previousModel._objectIndexes.find(object._id);
+        if (it == previousModel._objectIndexes.end()) {
+            declare(object._className);
+            handler.createObject(object._id, object._className, object._parentId);
+            emitValues(object, handler);
+        } else {
+            // same path so same class
+            const auto& previousObject = previousModel._objects[it->second];
+            if (object._values != previousObject._values) {
+                declare(object._className);
+                handler.updateObject(object._id);
+                emitValues(object, handler);
+            }
+            if (object._parentId != previousObject._parentId && object._parentId != -1) {
+                handler.setObjectParent(object._id, object._parentId);
+            }
+        }
+    }
+
+    handler.flush();
+}
+
+}
+
+}
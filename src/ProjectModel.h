@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file ProjectModel.h
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#ifndef POWSYBL_POWERFACTORY_DB_NATIVE_PROJECTMODEL_H
+#define POWSYBL_POWERFACTORY_DB_NATIVE_PROJECTMODEL_H
+
+#include <map>
+#include <unordered_map>
+#include "AttributeValue.h"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+struct ModelObject {
+    long _id;
+    std::string _className;
+    long _parentId = -1;
+    // sorted by attribute name once the model is complete
+    std::vector<AttributeValue> _values;
+};
+
+struct ModelAttribute {
+    int _type;
+    std::string _description;
+};
+
+/**
+ * In memory copy of a project, used to compute the difference between two reads.
+ */
+class ProjectModel : public AttributeValueHandler {
+public:
+    void createClass(const std::string& name) override;
+
+    void createAttribute(const std::string& className, const std::string& attributeName, int type, const std::string& description) override;
+
+    void createObject(long id, const std::string& className, long parentId) override;
+
+    void setObjectParent(long id, long parentId) override;
+
+    void flush() override;
+
+    /**
+     * Send the whole model to a handler.
+     */
+    void replay(DataObjectHandler& handler) const;
+
+    /**
+     * Renumber objects of this model so that objects also present in previous model, identified by their path of
+     * names from the root, keep the id they had there. New objects get ids after the highest previous one. Objects
+     * outside of the project, like types of global libraries, are matched the same way when both models have been read
+     * with their reference closure, references to objects that are not part of this model are set to -1.
+     */
+    void remapIds(const ProjectModel& previousModel);
+
+    /**
+     * Send to a handler what changed since previous model, which must share ids with this one: created objects
+     * with all their values, updated objects with all their new values, and deleted objects. Classes of created
+     * and updated objects are declared once, with all their attributes.
+     */
+    void emitDelta(const ProjectModel& previousModel, DataObjectHandler& handler) const;
+
+protected:
+    void setAttributeValue(long objectId, AttributeValue&& value) override;
+
+private:
+    std::vector<std::string> computePaths() const;
+
+    void declareClass(const std::string& className, DataObjectHandler& handler) const;
+
+    void emitValues(const ModelObject& object, DataObjectHandler& handler) const;
+
+    std::vector<std::string> _classNames;
+    std::map<std::pair<std::string, std::string>, ModelAttribute> _attributes;
+    // in traversal order so that parents come before children
+    std::vector<ModelObject> _objects;
+    std::unordered_map<long, size_t> _objectIndexes;
+};
+
+}
+
+}
+
+#endif //POWSYBL_POWERFACTORY_DB_NATIVE_PROJECTMODEL_H
@@ -0,0 +1,674 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file ProjectReader.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include "ProjectReader.h"
+#include "ReadProgress.h"
+#include "ReadStats.h"
+#include "Snapshot.h"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+const char* const NAME_ATTRIBUTE = "loc_name";
+
+struct TraversalItem {
+    api::v2::DataObject* _object;
+    // closest included ancestor
+    long _parentId;
+    std::string _parentPath;
+};
+
+// attributes of a class to read, according to read options
+std::vector<const AttributeSchema*> getReadAttributes(const ClassSchema& schema, const ReadOptions& options) {
+    std::vector<const AttributeSchema*> attributes;
+    auto includedAttributeNames = options.getAttributeNames(schema._className);
+    for (const auto& attribute : schema._attributes) {
+        if (!includedAttributeNames || includedAttributeNames->find(attribute._name) != includedAttributeNames->end()) {
+            attributes.push_back(&attribute);
+        }
+    }
+    return attributes;
+}
+
+// per class attributes to read, an entry existing once the class and its attributes have been declared to the handler
+typedef std::unordered_map<std::string, std::vector<const AttributeSchema*>> ClassAttributes;
+
+// what is needed to read objects to a handler, classes being declared once per handler
+struct ReadContext {
+    ReadContext(Api& api, SchemaCache& schemaCache, DataObjectHandler& handler, const ReadOptions& options,
+                bool fillDescription = false)
+        : _api(api),
+          _schemaCache(schemaCache),
+          _handler(handler),
+          _options(options),
+          _fillDescription(fillDescription),
+          _chunkSize(options._chunkSize > 0 && handler.isChunkedValueSupported() ? (size_t) options._chunkSize : SIZE_MAX) {
+    }
+
+    bool isCreated(long id) const {
+        return id >= 0 && (size_t) id < _created.size() && _created[id];
+    }
+
+    void addReference(long id) {
+        if (_references && id != -1) {
+            _references->push_back(id);
+        }
+    }
+
+    Api& _api;
+    SchemaCache& _schemaCache;
+    DataObjectHandler& _handler;
+    const ReadOptions& _options;
+    bool _fillDescription;
+    ClassAttributes _classAttributes;
+    // indexed by object id
+    std::vector<bool> _created;
+    // when not null, collects ids of objects referenced by object attributes
+    std::vector<int64_t>* _references = nullptr;
+    // roots of the subtrees skipped by the traversal because of excluded subtree patterns
+    std::unordered_set<api::v2::DataObject*> _excludedSubtrees;
+    // numeric vectors and matrices larger than this are streamed by slices
+    const size_t _chunkSize;
+
+    // reused from one attribute to the next so that vectors and matrices stop allocating once buffers have grown,
+    // handlers do not keep references to values
+    std::vector<int> _intBuffer;
+    std::vector<int64_t> _longBuffer;
+    std::vector<double> _doubleBuffer;
+    std::vector<std::string> _stringBuffer;
+
+    // vector and matrix attributes the engine cannot return in a single call, read cell by cell
+    std::unordered_set<const AttributeSchema*> _cellByCellAttributes;
+};
+
+int getRowCount(api::v2::DataObject* object, const std::string& attributeName) {
+    int rowCount;
+    int columnCount;
+    object->GetAttributeSize(attributeName.c_str(), rowCount, columnCount);
+    return rowCount;
+}
+
+// error of GetAttribute for a vector or matrix attribute the engine cannot return in a single call
+const int UNSUPPORTED_VALUE_ERROR = 2;
+
+// whole vector or matrix in a single call, the attribute name being resolved once instead of once per cell. A null
+// result means that this value has to be read cell by cell, the attribute being read cell by cell for all the
+// following objects only if the engine does not support whole values for it, an empty value for instance being null.
+ValueUniquePtr getWholeValue(ReadContext& context, api::v2::DataObject* object, const AttributeSchema& attribute,
+                             api::Value::Type expectedType) {
+    if (context._cellByCellAttributes.find(&attribute) == context._cellByCellAttributes.end()) {
+        int error = 0;
+        auto value = context._api.makeValueUniquePtr(object->GetAttribute(attribute._name.c_str(), &error));
+        if (error == 0 && value && value->GetType() == expectedType) {
+            return value;
+        }
+        if (error == UNSUPPORTED_VALUE_ERROR) {
+            // do not try again
+            context._cellByCellAttributes.insert(&attribute);
+        }
+    }
+    return context._api.makeValueUniquePtr(nullptr);
+}
+
+// reads a vector from a single call if the engine supports it, cell by cell otherwise. Values are given to emitChunk
+// by slices of at most chunkSize values, once beginVector has been given the size of the vector.
+template<typename T, typename WholeGetter, typename CellGetter, typename BeginVector, typename EmitChunk>
+void readVector(ReadContext& context, api::v2::DataObject* object, const AttributeSchema& attribute, std::vector<T>& values,
+                size_t chunkSize, WholeGetter wholeGetter, CellGetter cellGetter, BeginVector beginVector, EmitChunk emitChunk) {
+    auto value = getWholeValue(context, object, attribute, api::Value::VECTOR);
+    size_t size = value ? value->VecGetSize() : (size_t) std::max(getRowCount(object, attribute._name), 0);
+    beginVector(size);
+    values.clear();
+    values.reserve(std::min(size, chunkSize));
+    for (size_t i = 0; i < size; i++) {
+        values.push_back(value ? wholeGetter(*value, i) : cellGetter((int) i));
+        if (values.size() == chunkSize) {
+            emitChunk(values);
+            values.clear();
+        }
+    }
+    if (!values.empty()) {
+        emitChunk(values);
+    }
+}
+
+// numeric vectors larger than the chunk size are streamed, so that memory stays bounded by the chunk size
+template<typename T, typename WholeGetter, typename CellGetter, typename Setter, typename Appender>
+void readNumericVector(ReadContext& context, api::v2::DataObject* object, long id, const AttributeSchema& attribute,
+                       std::vector<T>& values, WholeGetter wholeGetter, CellGetter cellGetter, Setter setter, Appender appender) {
+    bool chunked = false;
+    readVector(context, object, attribute, values, context._chunkSize, wholeGetter, cellGetter,
+               [&](size_t size) {
+                   chunked = size > context._chunkSize;
+                   if (chunked) {
+                       context._handler.beginAttributeValue(id, attribute._name, attribute._type, (int) size, 1);
+                   }
+               },
+               [&](const std::vector<T>& chunk) {
+                   if (chunked) {
+                       appender(chunk.data(), chunk.size());
+                   } else {
+                       setter(chunk);
+                   }
+               });
+    if (chunked) {
+        context._handler.endAttributeValue();
+    }
+}
+
+void readValues(ReadContext& context, api::v2::DataObject* object, long id, const AttributeSchema& attribute) {
+    Api& api = context._api;
+    DataObjectHandler& handler = context._handler;
+    const std::string& attributeName = attribute._name;
+    const char* name = attributeName.c_str();
+
+    // set attribute value to object
+    switch (attribute._type) {
+        case api::v2::DataObject::AttributeType::TYPE_STRING: {
+            auto value = api.makeValueUniquePtr(object->GetAttributeString(name));
+            if (value) {
+                handler.setStringAttributeValue(id, attributeName, value->GetString());
+            }
+            break;
+        }
+
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER: {
+            int value = object->GetAttributeInt(name);
+            handler.setIntAttributeValue(id, attributeName, value);
+            break;
+        }
+
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER64: {
+            long value = object->GetAttributeInt64(name);
+            handler.setLongAttributeValue(id, attributeName, value);
+            break;
+        }
+
+        case api::v2::DataObject::AttributeType::TYPE_DOUBLE: {
+            double value = object->GetAttributeDouble(name);
+            handler.setDoubleAttributeValue(id, attributeName, value);
+            break;
+        }
+
+        case api::v2::DataObject::AttributeType::TYPE_OBJECT: {
+            auto otherObject = object->GetAttributeObject(name);
+            long otherId = api.addObject(otherObject);
+            context.addReference(otherId);
+            handler.setObjectAttributeValue(id, attributeName, otherId);
+            break;
+        }
+
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER_VEC: {
+            readNumericVector(context, object, id, attribute, context._intBuffer,
+                              [](const api::Value& value, size_t i) { return value.VecGetInteger(i); },
+                              [&](int row) { return object->GetAttributeInt(name, row, 0); },
+                              [&](const std::vector<int>& values) { handler.setIntVectorAttributeValue(id, attributeName, values); },
+                              [&](const int* values, size_t count) { handler.appendIntValues(values, count); });
+            break;
+        }
+
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER64_VEC: {
+            readNumericVector(context, object, id, attribute, context._longBuffer,
+                              [](const api::Value& value, size_t i) { return (int64_t) value.VecGetInteger64(i); },
+                              [&](int row) { return (int64_t) object->GetAttributeInt64(name, row, 0); },
+                              [&](const std::vector<int64_t>& values) { handler.setLongVectorAttributeValue(id, attributeName, values); },
+                              [&](const int64_t* values, size_t count) { handler.appendLongValues(values, count); });
+            break;
+        }
+
+        case api::v2::DataObject::AttributeType::TYPE_DOUBLE_VEC: {
+            readNumericVector(context, object, id, attribute, context._doubleBuffer,
+                              [](const api::Value& value, size_t i) { return value.VecGetDouble(i); },
+                              [&](int row) { return object->GetAttributeDouble(name, row, 0); },
+                              [&](const std::vector<double>& values) { handler.setDoubleVectorAttributeValue(id, attributeName, values); },
+                              [&](const double* values, size_t count) { handler.appendDoubleValues(values, count); });
+            break;
+        }
+
+        case api::v2::DataObject::AttributeType::TYPE_STRING_VEC: {
+            // not streamed, strings and references are not the large vectors
+            readVector(context, object, attribute, context._stringBuffer, SIZE_MAX,
+                       [](const api::Value& value, size_t i) {
+                           const char* str = value.VecGetString(i);
+                           return std::string(str ? str : "");
+                       },
+                       [&](int row) {
+                           auto value = api.makeValueUniquePtr(object->GetAttributeString(name, row));
+                           return std::string(value ? value->GetString() : "");
+                       },
+                       [](size_t) {},
+                       [&](const std::vector<std::string>& values) { handler.setStringVectorAttributeValue(id, attributeName, values); });
+            break;
+        }
+
+        case api::v2::DataObject::AttributeType::TYPE_OBJECT_VEC: {
+            readVector(context, object, attribute, context._longBuffer, SIZE_MAX,
+                       [&](const api::Value& value, size_t i) {
+                           return (int64_t) api.addObject(static_cast<api::v2::DataObject*>(value.VecGetDataObject(i)));
+                       },
+                       [&](int row) { return (int64_t) api.addObject(object->GetAttributeObject(name, row)); },
+                       [](size_t) {},
+                       [&](const std::vector<int64_t>& values) {
+                           for (auto otherId : values) {
+                               context.addReference((long) otherId);
+                           }
+                           handler.setObjectVectorAttributeValue(id, attributeName, values);
+                       });
+            break;
+        }
+
+        case api::v2::DataObject::AttributeType::TYPE_DOUBLE_MAT: {
+            int rowCount = 0;
+            int columnCount = 0;
+            auto value = getWholeValue(context, object, attribute, api::Value::MATRIX);
+            if (value) {
+                rowCount = (int) value->MatGetRowCount();
+                columnCount = (int) value->MatGetColCount();
+            } else {
+                object->GetAttributeSize(name, rowCount, columnCount);
+            }
+            if (rowCount > 0 && columnCount > 0) {
+                size_t size = (size_t) rowCount * columnCount;
+                bool chunked = size > context._chunkSize;
+                if (chunked) {
+                    handler.beginAttributeValue(id, attributeName, attribute._type, rowCount, columnCount);
+                }
+                auto& values = context._doubleBuffer;
+                values.clear();
+                values.reserve(std::min(size, context._chunkSize));
+                for (int row = 0; row < rowCount; row++) {
+                    for (int col = 0; col < columnCount; col++) {
+                        values.push_back(value ? value->MatGetDouble(row, col) : object->GetAttributeDouble(name, row, col));
+                        if (chunked && values.size() == context._chunkSize) {
+                            handler.appendDoubleValues(values.data(), values.size());
+                            values.clear();
+                        }
+                    }
+                }
+                if (chunked) {
+                    if (!values.empty()) {
+                        handler.appendDoubleValues(values.data(), values.size());
+                    }
+                    handler.endAttributeValue();
+                } else {
+                    handler.setDoubleMatrixAttributeValue(id, attributeName, rowCount, columnCount, values);
+                }
+            }
+            break;
+        }
+
+        default:
+            throw std::runtime_error("Unsupported attribute type " + std::to_string(attribute._type));
+    }
+}
+
+// creates an object of an included class with its attribute values, and returns its id
+long readObject(ReadContext& context, api::v2::DataObject* object, const std::string& className, long parentId) {
+    ReadStats* stats = context._options._stats;
+    auto start = ReadStats::start(stats);
+
+    // class and attributes are declared once, on first object of the class
+    auto itA = context._classAttributes.find(className);
+    if (itA == context._classAttributes.end()) {
+        const auto& schema = context._schemaCache.getClassSchema(context._api, *object, className, context._fillDescription,
+                                                                 context._options.getAttributeNames(className));
+        itA = context._classAttributes.emplace(className, getReadAttributes(schema, context._options)).first;
+        context._handler.createClass(className);
+        for (const auto* attribute : itA->second) {
+            context._handler.createAttribute(className, attribute->_name, attribute->_type, attribute->_description);
+        }
+    }
+
+    // create object
+    long id = context._api.getObjectId(object);
+    context._handler.createObject(id, className, parentId);
+    if ((size_t) id >= context._created.size()) {
+        context._created.resize(id + 1);
+    }
+    context._created[id] = true;
+
+    for (const auto* attribute : itA->second) {
+        auto attributeStart = ReadStats::start(stats);
+        readValues(context, object, id, *attribute);
+        if (stats) {
+            stats->addAttributeRead(attribute->_type, attributeStart);
+        }
+    }
+
+    if (stats) {
+        stats->addObject(className, start);
+    }
+    if (context._options._progress) {
+        context._options._progress->_attributeCount.fetch_add(itA->second.size(), std::memory_order_relaxed);
+    }
+    return id;
+}
+
+void checkCancelled(const ReadOptions& options) {
+    if (options._progress) {
+        options._progress->checkCancelled();
+    }
+}
+
+void traverse(ReadContext& context, api::v2::DataObject* root) {
+    Api& api = context._api;
+    const ReadOptions& options = context._options;
+    ReadStats* stats = options._stats;
+    ReadProgress* progress = options._progress;
+
+    // explicit stack (depth first) or queue (breadth first) instead of recursion so that deep hierarchies cannot
+    // overflow the native stack, in both orders a parent is always created before its children
+    std::deque<TraversalItem> items;
+    items.push_back({root, -1, ""});
+    while (!items.empty()) {
+        checkCancelled(options);
+        if (progress) {
+            progress->_pendingCount.store(items.size() - 1, std::memory_order_relaxed);
+            progress->_objectCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        TraversalItem item;
+        if (options._breadthFirst) {
+            item = std::move(items.front());
+            items.pop_front();
+        } else {
+            item = std::move(items.back());
+            items.pop_back();
+        }
+        auto object = item._object;
+
+        auto start = ReadStats::start(stats);
+        std::string className = api.makeValueUniquePtr(object->GetClassNameA())->GetString();
+        if (stats) {
+            stats->addPhase(ReadStats::Phase::GET_CLASS_NAME, start);
+        }
+
+        // path is only needed to match excluded subtrees
+        std::string path;
+        if (!options._excludedSubtreePatterns.empty()) {
+            auto name = api.makeValueUniquePtr(object->GetAttributeString(NAME_ATTRIBUTE));
+            path = item._parentPath + "\\" + (name ? name->GetString() : "") + "." + className;
+            if (options.isSubtreeExcluded(path)) {
+                context._excludedSubtrees.insert(object);
+                continue;
+            }
+        }
+
+        // objects of classes that are not included are skipped without any attribute call, their children are
+        // attached to the closest included ancestor
+        long id = item._parentId;
+        if (options.isClassIncluded(className)) {
+            id = readObject(context, object, className, item._parentId);
+        }
+
+        start = ReadStats::start(stats);
+        auto children = api.getChildren(*object);
+        if (stats) {
+            stats->addPhase(ReadStats::Phase::GET_CHILDREN, start);
+        }
+        if (options._breadthFirst) {
+            for (auto itC = children.begin(); itC != children.end(); ++itC) {
+                items.push_back({*itC, id, path});
+            }
+        } else {
+            // reversed so that children are popped in their natural order
+            for (auto itC = children.rbegin(); itC != children.rend(); ++itC) {
+                items.push_back({*itC, id, path});
+            }
+        }
+    }
+    if (progress) {
+        progress->_pendingCount.store(0, std::memory_order_relaxed);
+    }
+}
+
+// true if the object is in a subtree skipped by the traversal of the source context, so that the parent chain is only
+// walked when some subtrees have been excluded
+bool isInExcludedSubtree(Api& api, const ReadContext& sourceContext, api::v2::DataObject* object) {
+    if (sourceContext._excludedSubtrees.empty()) {
+        return false;
+    }
+    for (auto ancestor = object; ancestor; ancestor = ancestor->GetParent()) {
+        if (sourceContext._excludedSubtrees.find(ancestor) != sourceContext._excludedSubtrees.end()) {
+            return true;
+        }
+        // released with the engine, as children are
+        api.addObject(ancestor);
+    }
+    return false;
+}
+
+// reads to a context, breadth first, the objects referenced from a source context that none of both has created,
+// then what they reference themselves, up to a maximum depth (zero means no limit). Ids come from the registry, so each
+// object is read once whatever the number of references to it. Objects outside of the project have no parent. Objects
+// of the project that the traversal skipped, because of their class or of an excluded subtree, are not read.
+void readReferencedObjects(ReadContext& sourceContext, ReadContext& context, int maxDepth) {
+    Api& api = context._api;
+    std::deque<std::pair<long, int>> objectIds;
+    std::unordered_set<long> queuedIds;
+    auto enqueue = [&](long id, int depth) {
+        if (!sourceContext.isCreated(id) && !context.isCreated(id) && (maxDepth <= 0 || depth <= maxDepth)
+            && queuedIds.insert(id).second) {
+            objectIds.push_back({id, depth});
+        }
+    };
+
+    std::vector<int64_t> sourceReferences;
+    sourceReferences.swap(*sourceContext._references);
+    for (auto id : sourceReferences) {
+        enqueue((long) id, 1);
+    }
+
+    std::vector<int64_t> references;
+    std::vector<int64_t>* previousReferences = context._references;
+    context._references = &references;
+    while (!objectIds.empty()) {
+        checkCancelled(context._options);
+        long id = objectIds.front().first;
+        int depth = objectIds.front().second;
+        objectIds.pop_front();
+        auto object = api.getObject(id);
+        std::string className = api.makeValueUniquePtr(object->GetClassNameA())->GetString();
+        if (!context._options.isClassIncluded(className) || isInExcludedSubtree(api, sourceContext, object)) {
+            continue;
+        }
+        readObject(context, object, className, -1);
+        for (auto referenceId : references) {
+            enqueue((long) referenceId, depth + 1);
+        }
+        references.clear();
+    }
+    context._references = previousReferences;
+}
+
+// modification time stamp maintained by PowerFactory on each object, the one of a project being the one of its last
+// modified, created or deleted object
+const char* const MODIFICATION_TIME_STAMP_ATTRIBUTE = "tstamp";
+
+// empty if the project has no modification time stamp, so that it is not cached
+std::string computeProjectFingerprint(api::v2::DataObject* project, const std::string& projectName,
+                                      const ReadOptions& options) {
+    int64_t timeStamp = getProjectTimeStamp(project);
+    if (timeStamp == -1) {
+        return "";
+    }
+
+    // FNV-1a
+    std::string key = projectName + '|' + std::to_string(timeStamp) + '|' + options.getFilterKey();
+    uint64_t hash = 14695981039346656037ULL;
+    for (char c : key) {
+        hash ^= (unsigned char) c;
+        hash *= 1099511628211ULL;
+    }
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", (unsigned long long) hash);
+    return hex;
+}
+
+std::string getSnapshotCacheFileName(const std::string& cacheDir, const std::string& projectName, const std::string& fingerprint) {
+    std::string fileName;
+    for (char c : projectName) {
+        fileName += std::isalnum((unsigned char) c) || c == '-' || c == '_' ? c : '_';
+    }
+    return cacheDir + "/" + fileName + "-" + fingerprint + ".pfdb";
+}
+
+bool fileExists(const std::string& fileName) {
+    return std::ifstream(fileName).good();
+}
+
+// declares in a single call the schema of all included classes found under the project, so that the handler knows
+// the whole dictionary before any object. Classes only found in excluded subtrees are declared too.
+void declareSchema(ReadContext& context, api::v2::DataObject* project) {
+    Api& api = context._api;
+    std::vector<api::v2::DataObject*> objects = api.getChildren(*project, true);
+    objects.insert(objects.begin(), project);
+    std::vector<ClassSchema> schemas;
+    for (auto object : objects) {
+        std::string className = api.makeValueUniquePtr(object->GetClassNameA())->GetString();
+        if (!context._options.isClassIncluded(className)
+            || context._classAttributes.find(className) != context._classAttributes.end()) {
+            continue;
+        }
+        const auto& schema = context._schemaCache.getClassSchema(api, *object, className, context._fillDescription,
+                                                                 context._options.getAttributeNames(className));
+        auto attributes = getReadAttributes(schema, context._options);
+        ClassSchema readSchema;
+        readSchema._className = className;
+        readSchema._hasDescriptions = schema._hasDescriptions;
+        for (const auto* attribute : attributes) {
+            readSchema._attributes.push_back(*attribute);
+        }
+        schemas.push_back(std::move(readSchema));
+        context._classAttributes.emplace(className, std::move(attributes));
+    }
+    context._handler.createSchema(schemas);
+}
+
+void readProject(ReadContext& context, api::v2::DataObject* project) {
+    if (context._options._schemaFirst) {
+        declareSchema(context, project);
+    }
+    traverse(context, project);
+}
+
+void readProject(Api& api, SchemaCache& schemaCache, DataObjectHandler& handler, api::v2::DataObject* project,
+                 const ReadOptions& options) {
+    ReadContext context(api, schemaCache, handler, options);
+    std::vector<int64_t> references;
+    if (options._readReferences) {
+        context._references = &references;
+    }
+    readProject(context, project);
+    if (options._readReferences) {
+        readReferencedObjects(context, context, options._maxReferenceDepth);
+    }
+
+    handler.flush();
+}
+
+void readProject(Api& api, SchemaCache& schemaCache, DataObjectHandler& handler, api::v2::DataObject* project,
+                 const std::string& projectName, const ReadOptions& options) {
+    std::string fingerprint = options._cacheDir.empty() ? "" : computeProjectFingerprint(project, projectName, options);
+    if (fingerprint.empty()) {
+        readProject(api, schemaCache, handler, project, options);
+        return;
+    }
+
+    std::string snapshotFile = getSnapshotCacheFileName(options._cacheDir, projectName, fingerprint);
+    if (fileExists(snapshotFile)) {
+        SnapshotReader(snapshotFile).read(handler, options);
+    } else {
+        // write to a temporary file first so that a failed read never leaves a truncated snapshot in the cache, the
+        // temporary file being removed too
+        std::string tmpSnapshotFile = snapshotFile + ".tmp";
+        try {
+            SnapshotWriter writer(tmpSnapshotFile);
+            TeeDataObjectHandler teeHandler(handler, writer);
+            readProject(api, schemaCache, teeHandler, project, options);
+        } catch (...) {
+            std::remove(tmpSnapshotFile.c_str());
+            throw;
+        }
+        std::remove(snapshotFile.c_str());
+        if (std::rename(tmpSnapshotFile.c_str(), snapshotFile.c_str()) != 0) {
+            throw std::runtime_error("Cannot store snapshot '" + snapshotFile + "' in cache");
+        }
+    }
+}
+
+int64_t getProjectTimeStamp(api::v2::DataObject* project) {
+    switch (project->GetAttributeType(MODIFICATION_TIME_STAMP_ATTRIBUTE)) {
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER:
+            return project->GetAttributeInt(MODIFICATION_TIME_STAMP_ATTRIBUTE);
+
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER64:
+            return project->GetAttributeInt64(MODIFICATION_TIME_STAMP_ATTRIBUTE);
+
+        default:
+            return -1;
+    }
+}
+
+void readAttributes(Api& api, SchemaCache& schemaCache, DataObjectHandler& handler, api::v2::DataObject* object,
+                    const std::vector<std::string>& attributeNames) {
+    std::string className = api.makeValueUniquePtr(object->GetClassNameA())->GetString();
+    const auto& schema = schemaCache.getClassSchema(api, *object, className, false);
+    ReadOptions options;
+    ReadContext context(api, schemaCache, handler, options);
+    long id = api.getObjectId(object);
+    for (const auto& attributeName : attributeNames) {
+        auto it = std::find_if(schema._attributes.begin(), schema._attributes.end(), [&](const AttributeSchema& attribute) {
+            return attribute._name == attributeName;
+        });
+        if (it == schema._attributes.end()) {
+            throw std::runtime_error("Attribute '" + attributeName + "' not found in class '" + className + "'");
+        }
+        readValues(context, object, id, *it);
+    }
+}
+
+void readProjects(Api& api, SchemaCache& schemaCache, const std::vector<std::string>& projectNames,
+                  const std::vector<DataObjectHandler*>& handlers, DataObjectHandler& libraryHandler,
+                  const ReadOptions& options) {
+    if (projectNames.size() != handlers.size()) {
+        throw std::runtime_error("One handler is expected per project");
+    }
+
+    ReadContext libraryContext(api, schemaCache, libraryHandler, options);
+
+    for (size_t i = 0; i < projectNames.size(); i++) {
+        auto project = api.activateProject(projectNames[i]);
+
+        std::vector<int64_t> references;
+        ReadContext context(api, schemaCache, *handlers[i], options);
+        context._references = &references;
+        readProject(context, project);
+        context._handler.flush();
+
+        // referenced objects not found in the project, and what they reference themselves, go to the library
+        readReferencedObjects(context, libraryContext, options._maxReferenceDepth);
+    }
+
+    libraryHandler.flush();
+}
+
+}
+
+}
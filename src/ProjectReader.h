@@ -0,0 +1,49 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file ProjectReader.h
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#ifndef POWSYBL_POWERFACTORY_DB_NATIVE_PROJECTREADER_H
+#define POWSYBL_POWERFACTORY_DB_NATIVE_PROJECTREADER_H
+
+#include "Api.h"
+#include "ClassSchema.h"
+#include "DataObjectHandler.h"
+#include "ReadOptions.h"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+// reads the active project to the handler, and flushes it
+void readProject(Api& api, SchemaCache& schemaCache, DataObjectHandler& handler, api::v2::DataObject* project,
+                 const ReadOptions& options = ReadOptions());
+
+// same as above but going through the snapshot cache if the options define one
+void readProject(Api& api, SchemaCache& schemaCache, DataObjectHandler& handler, api::v2::DataObject* project,
+                 const std::string& projectName, const ReadOptions& options);
+
+// modification time stamp of the project, changing with any of its objects, read as a single attribute whatever the
+// size of the project. -1 if the project has none.
+int64_t getProjectTimeStamp(api::v2::DataObject* project);
+
+// reads the given attributes of a single object, without declaring classes and attributes nor creating the object
+void readAttributes(Api& api, SchemaCache& schemaCache, DataObjectHandler& handler, api::v2::DataObject* object,
+                    const std::vector<std::string>& attributeNames);
+
+// reads each project to its own handler with a single engine. Objects outside of the projects that are referenced by
+// object attributes, typically types of global libraries, are read once to the library handler, and referenced with
+// the same id from all projects.
+void readProjects(Api& api, SchemaCache& schemaCache, const std::vector<std::string>& projectNames,
+                  const std::vector<DataObjectHandler*>& handlers, DataObjectHandler& libraryHandler,
+                  const ReadOptions& options);
+
+}
+
+}
+
+#endif //POWSYBL_POWERFACTORY_DB_NATIVE_PROJECTREADER_H
@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file ReadOptions.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include "ReadOptions.h"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+namespace {
+
+bool matches(const char* pattern, const char* str) {
+    // iterative wildcard matching with backtracking on last '*'
+    const char* starPattern = nullptr;
+    const char* starStr = nullptr;
+    while (*str) {
+        if (*pattern == '*') {
+            starPattern = pattern++;
+            starStr = str;
+        } else if (*pattern == '?' || *pattern == *str) {
+            pattern++;
+            str++;
+        } else if (starPattern) {
+            pattern = starPattern + 1;
+            str = ++starStr;
+        } else {
+            return false;
+        }
+    }
+    while (*pattern == '*') {
+        pattern++;
+    }
+    return !*pattern;
+}
+
+}
+
+bool ReadOptions::isClassIncluded(const std::string& className) const {
+    return _classNames.empty() || _classNames.find(className) != _classNames.end();
+}
+
+const std::set<std::string>* ReadOptions::getAttributeNames(const std::string& className) const {
+    auto it = _attributeNames.find(className);
+    return it != _attributeNames.end() ? &it->second : nullptr;
+}
+
+bool ReadOptions::isSubtreeExcluded(const std::string& path) const {
+    for (const auto& pattern : _excludedSubtreePatterns) {
+        if (matches(pattern.c_str(), path.c_str())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string ReadOptions::getFilterKey() const {
+    std::string key;
+    for (const auto& className : _classNames) {
+        key += className + ',';
+    }
+    key += '|';
+    for (const auto& e : _attributeNames) {
+        key += e.first + ':';
+        for (const auto& attributeName : e.second) {
+            key += attributeName + ',';
+        }
+        key += ';';
+    }
+    key += '|';
+    for (const auto& pattern : _excludedSubtreePatterns) {
+        key += pattern + ',';
+    }
+    if (_readReferences) {
+        key += "|references:" + std::to_string(_maxReferenceDepth);
+    }
+    return key;
+}
+
+}
+
+}
@@ -0,0 +1,92 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file ReadOptions.h
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#ifndef POWSYBL_POWERFACTORY_DB_NATIVE_READOPTIONS_H
+#define POWSYBL_POWERFACTORY_DB_NATIVE_READOPTIONS_H
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace powsybl {
+
+namespace powerfactory {
+
+struct ReadProgress;
+class ReadStats;
+
+struct ReadOptions {
+    // zero means one upcall per value
+    int _batchSize = 0;
+
+    // size of the ring buffer between PowerFactory API reading thread and Java builder calling thread, zero means
+    // both are done by the same thread
+    int _pipelineCapacity = 0;
+
+    // integer, long and double vectors and double matrices larger than this are streamed to handlers that support it
+    // by slices of this size, zero means values are always set at once
+    int _chunkSize = 0;
+
+    // string values are sent to Java builders as codes in a dictionary that grows as new values are met
+    bool _stringDictionary = false;
+
+    // depth first by default, parents are created before their children in both orders
+    bool _breadthFirst = false;
+
+    // declare all classes and attributes in a single call before any object, at the cost of a first pass over the
+    // project to find classes
+    bool _schemaFirst = false;
+
+    // objects outside of the project that are referenced by object attributes, typically types of global libraries,
+    // are read after the project, breadth first, with what they reference themselves
+    bool _readReferences = false;
+
+    // number of reference hops followed from project objects, zero means no limit
+    int _maxReferenceDepth = 0;
+
+    // empty means no snapshot cache
+    std::string _cacheDir;
+
+    // empty means all classes, objects of other classes are not read but their children are
+    std::set<std::string> _classNames;
+
+    // per class attribute names to read, all attributes are read for classes not in the map
+    std::map<std::string, std::set<std::string>> _attributeNames;
+
+    // wildcard patterns ('*' and '?') matched against object paths, made of '\' separated name.class elements
+    // starting from the project, an object whose path matches is skipped with all its descendants
+    std::vector<std::string> _excludedSubtreePatterns;
+
+    // when not null, read statistics are collected, not part of what is read
+    ReadStats* _stats = nullptr;
+
+    // when not null, progress is published there and the read stops with an error once it is cancelled, not part
+    // of what is read
+    ReadProgress* _progress = nullptr;
+
+    // when not empty, a Chrome trace of the read is written to this file, requires statistics
+    std::string _traceFile;
+
+    bool isClassIncluded(const std::string& className) const;
+
+    // nullptr if all attributes of the class have to be read
+    const std::set<std::string>* getAttributeNames(const std::string& className) const;
+
+    bool isSubtreeExcluded(const std::string& path) const;
+
+    // everything that changes the content of a read, to be part of snapshot cache key
+    std::string getFilterKey() const;
+};
+
+}
+
+}
+
+#endif //POWSYBL_POWERFACTORY_DB_NATIVE_READOPTIONS_H
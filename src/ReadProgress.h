@@ -0,0 +1,46 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file ReadProgress.h
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#ifndef POWSYBL_POWERFACTORY_DB_NATIVE_READPROGRESS_H
+#define POWSYBL_POWERFACTORY_DB_NATIVE_READPROGRESS_H
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+
+namespace powsybl {
+
+namespace powerfactory {
+
+/**
+ * Progress of a read, updated by the reading thread and polled by any other one, which can also ask the read to
+ * stop. Cancellation is cooperative: it is checked between objects.
+ */
+struct ReadProgress {
+    std::atomic<uint64_t> _objectCount{0};
+
+    std::atomic<uint64_t> _attributeCount{0};
+
+    // objects returned by children calls and not visited yet, an estimate as their own children are not known
+    std::atomic<uint64_t> _pendingCount{0};
+
+    std::atomic<bool> _cancelled{false};
+
+    void checkCancelled() const {
+        if (_cancelled.load(std::memory_order_relaxed)) {
+            throw std::runtime_error("Read cancelled");
+        }
+    }
+};
+
+}
+
+}
+
+#endif //POWSYBL_POWERFACTORY_DB_NATIVE_READPROGRESS_H
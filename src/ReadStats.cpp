@@ -0,0 +1,291 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file ReadStats.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include <fstream>
+#include <stdexcept>
+#include "Api.h"
+#include "ReadStats.h"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+namespace {
+
+const char* const PHASE_NAMES[] = {"getClassName", "getChildren", "readObject"};
+
+std::string getAttributeTypeName(int type) {
+    switch (type) {
+        case api::v2::DataObject::AttributeType::TYPE_STRING: return "string";
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER: return "integer";
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER64: return "integer64";
+        case api::v2::DataObject::AttributeType::TYPE_DOUBLE: return "double";
+        case api::v2::DataObject::AttributeType::TYPE_OBJECT: return "object";
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER_VEC: return "integerVector";
+        case api::v2::DataObject::AttributeType::TYPE_INTEGER64_VEC: return "integer64Vector";
+        case api::v2::DataObject::AttributeType::TYPE_DOUBLE_VEC: return "doubleVector";
+        case api::v2::DataObject::AttributeType::TYPE_STRING_VEC: return "stringVector";
+        case api::v2::DataObject::AttributeType::TYPE_OBJECT_VEC: return "objectVector";
+        case api::v2::DataObject::AttributeType::TYPE_DOUBLE_MAT: return "doubleMatrix";
+        default: return std::to_string(type);
+    }
+}
+
+void add(ReadStats::Counter& counter, ReadStats::Clock::duration time) {
+    counter._count++;
+    counter._time += time;
+}
+
+std::string escapeJson(const std::string& str) {
+    std::string escaped;
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+}
+
+ReadStats::ReadStats(bool traceEnabled)
+    : _origin(Clock::now()),
+      _traceEnabled(traceEnabled) {
+}
+
+void ReadStats::addPhase(Phase phase, Clock::time_point start) {
+    auto end = Clock::now();
+    add(_phases[(int) phase], end - start);
+    if (_traceEnabled && phase == Phase::GET_CHILDREN) {
+        addTraceEvent(PHASE_NAMES[(int) phase], "api", start, end);
+    }
+}
+
+void ReadStats::addAttributeRead(int type, Clock::time_point start) {
+    add(_attributeTypes[type], Clock::now() - start);
+}
+
+void ReadStats::addObject(const std::string& className, Clock::time_point start) {
+    auto end = Clock::now();
+    add(_phases[(int) Phase::READ_OBJECT], end - start);
+    add(_classes[className], end - start);
+    if (_traceEnabled) {
+        addTraceEvent(className, "object", start, end);
+    }
+}
+
+void ReadStats::addHandlerCall(const char* methodName, Clock::time_point start) {
+    auto end = Clock::now();
+    add(_handlerCalls[methodName], end - start);
+    if (_traceEnabled) {
+        addTraceEvent(methodName, "handler", start, end);
+    }
+}
+
+void ReadStats::addTraceEvent(const std::string& name, const char* category, Clock::time_point start, Clock::time_point end) {
+    std::lock_guard<std::mutex> lock(_traceMutex);
+    _traceEvents.push_back({name, category, start, end - start, std::this_thread::get_id()});
+}
+
+void ReadStats::visit(const std::function<void(const std::string&, const std::string&, uint64_t, int64_t)>& visitor) const {
+    auto toNanos = [](Clock::duration time) {
+        return (int64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+    };
+    for (int i = 0; i < 3; i++) {
+        visitor("phase", PHASE_NAMES[i], _phases[i]._count, toNanos(_phases[i]._time));
+    }
+    for (const auto& e : _attributeTypes) {
+        visitor("attributeType", getAttributeTypeName(e.first), e.second._count, toNanos(e.second._time));
+    }
+    for (const auto& e : _classes) {
+        visitor("class", e.first, e.second._count, toNanos(e.second._time));
+    }
+    for (const auto& e : _handlerCalls) {
+        visitor("handler", e.first, e.second._count, toNanos(e.second._time));
+    }
+}
+
+void ReadStats::writeChromeTrace(const std::string& fileName) const {
+    std::ofstream os(fileName);
+    if (!os) {
+        throw std::runtime_error("Cannot write trace file '" + fileName + "'");
+    }
+
+    // thread ids are replaced by small integers, trace viewers expect numbers
+    std::unordered_map<std::thread::id, int> threadNumbers;
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    for (const auto& event : _traceEvents) {
+        int threadNumber = threadNumbers.emplace(event._threadId, (int) threadNumbers.size() + 1).first->second;
+        auto ts = std::chrono::duration_cast<std::chrono::microseconds>(event._start - _origin).count();
+        auto dur = std::chrono::duration_cast<std::chrono::microseconds>(event._duration).count();
+        os << (first ? "" : ",") << "\n{\"name\":\"" << escapeJson(event._name) << "\",\"cat\":\"" << event._category
+           << "\",\"ph\":\"X\",\"ts\":" << ts << ",\"dur\":" << dur << ",\"pid\":1,\"tid\":" << threadNumber << "}";
+        first = false;
+    }
+    os << "\n]}\n";
+}
+
+InstrumentedDataObjectHandler::InstrumentedDataObjectHandler(DataObjectHandler& handler, ReadStats& stats)
+    : _handler(handler),
+      _stats(stats) {
+}
+
+void InstrumentedDataObjectHandler::createClass(const std::string& name) {
+    auto start = ReadStats::Clock::now();
+    _handler.createClass(name);
+    _stats.addHandlerCall("createClass", start);
+}
+
+void InstrumentedDataObjectHandler::createAttribute(const std::string& className, const std::string& attributeName, int type, const std::string& description) {
+    auto start = ReadStats::Clock::now();
+    _handler.createAttribute(className, attributeName, type, description);
+    _stats.addHandlerCall("createAttribute", start);
+}
+
+void InstrumentedDataObjectHandler::createSchema(const std::vector<ClassSchema>& schemas) {
+    auto start = ReadStats::Clock::now();
+    _handler.createSchema(schemas);
+    _stats.addHandlerCall("createSchema", start);
+}
+
+void InstrumentedDataObjectHandler::createObject(long id, const std::string& className, long parentId) {
+    auto start = ReadStats::Clock::now();
+    _handler.createObject(id, className, parentId);
+    _stats.addHandlerCall("createObject", start);
+}
+
+void InstrumentedDataObjectHandler::setObjectParent(long id, long parentId) {
+    auto start = ReadStats::Clock::now();
+    _handler.setObjectParent(id, parentId);
+    _stats.addHandlerCall("setObjectParent", start);
+}
+
+void InstrumentedDataObjectHandler::updateObject(long id) {
+    auto start = ReadStats::Clock::now();
+    _handler.updateObject(id);
+    _stats.addHandlerCall("updateObject", start);
+}
+
+void InstrumentedDataObjectHandler::deleteObject(long id) {
+    auto start = ReadStats::Clock::now();
+    _handler.deleteObject(id);
+    _stats.addHandlerCall("deleteObject", start);
+}
+
+void InstrumentedDataObjectHandler::setStringAttributeValue(long objectId, const std::string& attributeName, const std::string& value) {
+    auto start = ReadStats::Clock::now();
+    _handler.setStringAttributeValue(objectId, attributeName, value);
+    _stats.addHandlerCall("setStringAttributeValue", start);
+}
+
+void InstrumentedDataObjectHandler::setIntAttributeValue(long objectId, const std::string& attributeName, int value) {
+    auto start = ReadStats::Clock::now();
+    _handler.setIntAttributeValue(objectId, attributeName, value);
+    _stats.addHandlerCall("setIntAttributeValue", start);
+}
+
+void InstrumentedDataObjectHandler::setLongAttributeValue(long objectId, const std::string& attributeName, long value) {
+    auto start = ReadStats::Clock::now();
+    _handler.setLongAttributeValue(objectId, attributeName, value);
+    _stats.addHandlerCall("setLongAttributeValue", start);
+}
+
+void InstrumentedDataObjectHandler::setDoubleAttributeValue(long objectId, const std::string& attributeName, double value) {
+    auto start = ReadStats::Clock::now();
+    _handler.setDoubleAttributeValue(objectId, attributeName, value);
+    _stats.addHandlerCall("setDoubleAttributeValue", start);
+}
+
+void InstrumentedDataObjectHandler::setObjectAttributeValue(long objectId, const std::string& attributeName, long otherObjectId) {
+    auto start = ReadStats::Clock::now();
+    _handler.setObjectAttributeValue(objectId, attributeName, otherObjectId);
+    _stats.addHandlerCall("setObjectAttributeValue", start);
+}
+
+void InstrumentedDataObjectHandler::setIntVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int>& value) {
+    auto start = ReadStats::Clock::now();
+    _handler.setIntVectorAttributeValue(objectId, attributeName, value);
+    _stats.addHandlerCall("setIntVectorAttributeValue", start);
+}
+
+void InstrumentedDataObjectHandler::setLongVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& value) {
+    auto start = ReadStats::Clock::now();
+    _handler.setLongVectorAttributeValue(objectId, attributeName, value);
+    _stats.addHandlerCall("setLongVectorAttributeValue", start);
+}
+
+void InstrumentedDataObjectHandler::setDoubleVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<double>& value) {
+    auto start = ReadStats::Clock::now();
+    _handler.setDoubleVectorAttributeValue(objectId, attributeName, value);
+    _stats.addHandlerCall("setDoubleVectorAttributeValue", start);
+}
+
+void InstrumentedDataObjectHandler::setStringVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<std::string>& value) {
+    auto start = ReadStats::Clock::now();
+    _handler.setStringVectorAttributeValue(objectId, attributeName, value);
+    _stats.addHandlerCall("setStringVectorAttributeValue", start);
+}
+
+void InstrumentedDataObjectHandler::setObjectVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& otherObjectsIds) {
+    auto start = ReadStats::Clock::now();
+    _handler.setObjectVectorAttributeValue(objectId, attributeName, otherObjectsIds);
+    _stats.addHandlerCall("setObjectVectorAttributeValue", start);
+}
+
+void InstrumentedDataObjectHandler::setDoubleMatrixAttributeValue(long objectId, const std::string& attributeName, int rowCount, int columnCount, const std::vector<double>& value) {
+    auto start = ReadStats::Clock::now();
+    _handler.setDoubleMatrixAttributeValue(objectId, attributeName, rowCount, columnCount, value);
+    _stats.addHandlerCall("setDoubleMatrixAttributeValue", start);
+}
+
+bool InstrumentedDataObjectHandler::isChunkedValueSupported() const {
+    return _handler.isChunkedValueSupported();
+}
+
+void InstrumentedDataObjectHandler::beginAttributeValue(long objectId, const std::string& attributeName, int type, int rowCount, int columnCount) {
+    auto start = ReadStats::Clock::now();
+    _handler.beginAttributeValue(objectId, attributeName, type, rowCount, columnCount);
+    _stats.addHandlerCall("beginAttributeValue", start);
+}
+
+void InstrumentedDataObjectHandler::appendIntValues(const int* values, size_t count) {
+    auto start = ReadStats::Clock::now();
+    _handler.appendIntValues(values, count);
+    _stats.addHandlerCall("appendIntValues", start);
+}
+
+void InstrumentedDataObjectHandler::appendLongValues(const int64_t* values, size_t count) {
+    auto start = ReadStats::Clock::now();
+    _handler.appendLongValues(values, count);
+    _stats.addHandlerCall("appendLongValues", start);
+}
+
+void InstrumentedDataObjectHandler::appendDoubleValues(const double* values, size_t count) {
+    auto start = ReadStats::Clock::now();
+    _handler.appendDoubleValues(values, count);
+    _stats.addHandlerCall("appendDoubleValues", start);
+}
+
+void InstrumentedDataObjectHandler::endAttributeValue() {
+    auto start = ReadStats::Clock::now();
+    _handler.endAttributeValue();
+    _stats.addHandlerCall("endAttributeValue", start);
+}
+
+void InstrumentedDataObjectHandler::flush() {
+    auto start = ReadStats::Clock::now();
+    _handler.flush();
+    _stats.addHandlerCall("flush", start);
+}
+
+}
+
+}
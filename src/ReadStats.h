@@ -0,0 +1,154 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file ReadStats.h
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#ifndef POWSYBL_POWERFACTORY_DB_NATIVE_READSTATS_H
+#define POWSYBL_POWERFACTORY_DB_NATIVE_READSTATS_H
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include "DataObjectHandler.h"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+/**
+ * Counters and cumulative timings of a read, per phase, attribute type, class and handler call, with optional trace
+ * events. Reader side (PowerFactory API) and handler side counters are distinct so that both can be updated from
+ * their own thread when the read is pipelined. Reads without statistics just have no ReadStats, and pay a null
+ * pointer check.
+ */
+class ReadStats {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    enum class Phase {
+        GET_CLASS_NAME,
+        GET_CHILDREN,
+        READ_OBJECT,
+    };
+
+    struct Counter {
+        uint64_t _count = 0;
+        Clock::duration _time{0};
+    };
+
+    explicit ReadStats(bool traceEnabled);
+
+    // epoch if there are no stats, so that timing costs nothing
+    static Clock::time_point start(const ReadStats* stats) {
+        return stats ? Clock::now() : Clock::time_point();
+    }
+
+    // reader side
+    void addPhase(Phase phase, Clock::time_point start);
+    void addAttributeRead(int type, Clock::time_point start);
+    void addObject(const std::string& className, Clock::time_point start);
+
+    // handler side
+    void addHandlerCall(const char* methodName, Clock::time_point start);
+
+    // category, name, count and cumulative time in nanoseconds of each counter
+    void visit(const std::function<void(const std::string&, const std::string&, uint64_t, int64_t)>& visitor) const;
+
+    void writeChromeTrace(const std::string& fileName) const;
+
+private:
+    struct TraceEvent {
+        std::string _name;
+        const char* _category;
+        Clock::time_point _start;
+        Clock::duration _duration;
+        std::thread::id _threadId;
+    };
+
+    void addTraceEvent(const std::string& name, const char* category, Clock::time_point start, Clock::time_point end);
+
+    const Clock::time_point _origin;
+    const bool _traceEnabled;
+
+    Counter _phases[3];
+    std::unordered_map<int, Counter> _attributeTypes;
+    std::unordered_map<std::string, Counter> _classes;
+    std::unordered_map<std::string, Counter> _handlerCalls;
+
+    std::mutex _traceMutex;
+    std::vector<TraceEvent> _traceEvents;
+};
+
+/**
+ * Times every call to a handler.
+ */
+class InstrumentedDataObjectHandler : public DataObjectHandler {
+public:
+    InstrumentedDataObjectHandler(DataObjectHandler& handler, ReadStats& stats);
+
+    void createClass(const std::string& name) override;
+
+    void createAttribute(const std::string& className, const std::string& attributeName, int type, const std::string& description) override;
+
+    void createSchema(const std::vector<ClassSchema>& schemas) override;
+
+    void createObject(long id, const std::string& className, long parentId) override;
+
+    void setObjectParent(long id, long parentId) override;
+
+    void updateObject(long id) override;
+
+    void deleteObject(long id) override;
+
+    void setStringAttributeValue(long objectId, const std::string& attributeName, const std::string& value) override;
+
+    void setIntAttributeValue(long objectId, const std::string& attributeName, int value) override;
+
+    void setLongAttributeValue(long objectId, const std::string& attributeName, long value) override;
+
+    void setDoubleAttributeValue(long objectId, const std::string& attributeName, double value) override;
+
+    void setObjectAttributeValue(long objectId, const std::string& attributeName, long otherObjectId) override;
+
+    void setIntVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int>& value) override;
+
+    void setLongVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& value) override;
+
+    void setDoubleVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<double>& value) override;
+
+    void setStringVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<std::string>& value) override;
+
+    void setObjectVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& otherObjectsIds) override;
+
+    void setDoubleMatrixAttributeValue(long objectId, const std::string& attributeName, int rowCount, int columnCount, const std::vector<double>& value) override;
+
+    bool isChunkedValueSupported() const override;
+
+    void beginAttributeValue(long objectId, const std::string& attributeName, int type, int rowCount, int columnCount) override;
+
+    void appendIntValues(const int* values, size_t count) override;
+
+    void appendLongValues(const int64_t* values, size_t count) override;
+
+    void appendDoubleValues(const double* values, size_t count) override;
+
+    void endAttributeValue() override;
+
+    void flush() override;
+
+private:
+    DataObjectHandler& _handler;
+    ReadStats& _stats;
+};
+
+}
+
+}
+
+#endif //POWSYBL_POWERFACTORY_DB_NATIVE_READSTATS_H
@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file Session.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include <stdexcept>
+#include "ProjectReader.h"
+#include "Session.h"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+Session::Session(const std::string& powerFactoryHome)
+    : _api(powerFactoryHome) {
+}
+
+api::v2::DataObject* Session::activateProject(const std::string& projectName) {
+    if (!_project || projectName != _projectName) {
+        _project = nullptr;
+        _idsByClass.clear();
+        _idsByClassTimeStamp = -1;
+        _project = _api.activateProject(projectName);
+        _projectName = projectName;
+    }
+    return _project;
+}
+
+std::string Session::getClassName(long id) {
+    return _api.makeValueUniquePtr(_api.getObject(id)->GetClassNameA())->GetString();
+}
+
+std::vector<long> Session::getChildIds(long id) {
+    std::vector<long> ids;
+    for (auto child : _api.getChildren(*_api.getObject(id))) {
+        ids.push_back(_api.getObjectId(child));
+    }
+    return ids;
+}
+
+std::vector<long> Session::findByClass(const std::string& className) {
+    if (!_project) {
+        throw std::runtime_error("No active project");
+    }
+    int64_t timeStamp = getProjectTimeStamp(_project);
+    if (timeStamp == -1 || timeStamp != _idsByClassTimeStamp) {
+        _idsByClass.clear();
+        _idsByClassTimeStamp = -1;
+        for (auto object : _api.getChildren(*_project, true)) {
+            _idsByClass[_api.makeValueUniquePtr(object->GetClassNameA())->GetString()].push_back(_api.getObjectId(object));
+        }
+        _idsByClassTimeStamp = timeStamp;
+    }
+    auto it = _idsByClass.find(className);
+    return it != _idsByClass.end() ? it->second : std::vector<long>();
+}
+
+void Session::readAttributes(DataObjectHandler& handler, long id, const std::vector<std::string>& attributeNames) {
+    powerfactory::readAttributes(_api, _schemaCache, handler, _api.getObject(id), attributeNames);
+}
+
+long SessionRegistry::open(const std::string& powerFactoryHome) {
+    // engine is loaded outside of the lock, as it takes time
+    auto session = std::make_shared<Session>(powerFactoryHome);
+    std::lock_guard<std::mutex> lock(_mutex);
+    long handle = ++_lastHandle;
+    _sessions.emplace(handle, std::move(session));
+    return handle;
+}
+
+std::shared_ptr<Session> SessionRegistry::get(long handle) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _sessions.find(handle);
+    if (it == _sessions.end()) {
+        throw std::runtime_error("Invalid session handle");
+    }
+    return it->second;
+}
+
+void SessionRegistry::close(long handle) {
+    std::shared_ptr<Session> session;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _sessions.find(handle);
+        if (it == _sessions.end()) {
+            throw std::runtime_error("Invalid session handle");
+        }
+        session = std::move(it->second);
+        _sessions.erase(it);
+    }
+    // destroyed here, outside of the lock, unless a call is still using it
+}
+
+}
+
+}
@@ -0,0 +1,93 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file Session.h
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#ifndef POWSYBL_POWERFACTORY_DB_NATIVE_SESSION_H
+#define POWSYBL_POWERFACTORY_DB_NATIVE_SESSION_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "Api.h"
+#include "ClassSchema.h"
+#include "DataObjectHandler.h"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+/**
+ * A PowerFactory engine kept alive across reads, so that loading digapi.dll and creating the API instance is only
+ * paid once. Object ids and class schemas are kept too, so an object has the same id in all reads of a session.
+ * Reads of a session are serialized through its mutex.
+ */
+class Session {
+public:
+    explicit Session(const std::string& powerFactoryHome);
+
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+
+    Api& getApi() { return _api; }
+
+    SchemaCache& getSchemaCache() { return _schemaCache; }
+
+    std::mutex& getMutex() { return _mutex; }
+
+    // project activation is skipped if the project is already the active one
+    api::v2::DataObject* activateProject(const std::string& projectName);
+
+    // cursor over the active project, objects are only read from the engine when asked for
+
+    std::string getClassName(long id);
+
+    std::vector<long> getChildIds(long id);
+
+    // ids of all objects of the class in the active project. The project is walked once to index all its objects by
+    // class, and again only once it has been modified, or on each call if the project has no modification time stamp.
+    std::vector<long> findByClass(const std::string& className);
+
+    void readAttributes(DataObjectHandler& handler, long id, const std::vector<std::string>& attributeNames);
+
+private:
+    Api _api;
+    SchemaCache _schemaCache;
+    std::string _projectName;
+    api::v2::DataObject* _project = nullptr;
+    std::unordered_map<std::string, std::vector<long>> _idsByClass;
+    // time stamp of the active project when it was indexed, -1 if not indexed
+    int64_t _idsByClassTimeStamp = -1;
+    std::mutex _mutex;
+};
+
+/**
+ * Open sessions by handle, handles given to Java instead of session addresses. A call holds its session through a
+ * shared pointer, so a session closed while calls are in flight, possibly waiting for its mutex, is only destroyed
+ * once the last of them returns. Handles are never reused.
+ */
+class SessionRegistry {
+public:
+    long open(const std::string& powerFactoryHome);
+
+    // throws if the session is unknown or closed
+    std::shared_ptr<Session> get(long handle);
+
+    // later calls with the handle fail, calls in flight go on with the session
+    void close(long handle);
+
+private:
+    std::mutex _mutex;
+    std::unordered_map<long, std::shared_ptr<Session>> _sessions;
+    long _lastHandle = 0;
+};
+
+}
+
+}
+
+#endif //POWSYBL_POWERFACTORY_DB_NATIVE_SESSION_H
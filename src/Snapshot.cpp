@@ -0,0 +1,621 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file Snapshot.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include "Snapshot.h"
+#include "v2/Api.hpp"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+namespace {
+
+const size_t ALIGNMENT = 8;
+
+size_t getPaddedSize(size_t size) {
+    return (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+}
+
+void pad(std::string& bytes) {
+    bytes.append(getPaddedSize(bytes.size()) - bytes.size(), '\0');
+}
+
+template<typename T>
+void write(std::string& bytes, T value) {
+    bytes.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeString(std::string& bytes, const std::string& str) {
+    write<uint32_t>(bytes, (uint32_t) str.size());
+    bytes.append(str);
+}
+
+template<typename T>
+void writeElements(std::string& bytes, const std::vector<T>& values) {
+    bytes.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+}
+
+/**
+ * Bounds checked access to a range of the snapshot buffer.
+ */
+class ByteReader {
+public:
+    ByteReader(const char* bytes, size_t size, size_t begin, size_t end)
+        : _bytes(bytes),
+          _pos(begin),
+          _end(end) {
+        if (begin > end || end > size) {
+            throw std::runtime_error("Truncated snapshot");
+        }
+    }
+
+    // in place, records being aligned on their size
+    template<typename T>
+    const T* read(size_t count = 1) {
+        if (count > (_end - _pos) / sizeof(T)) {
+            throw std::runtime_error("Truncated snapshot");
+        }
+        if (_pos % alignof(T) != 0) {
+            throw std::runtime_error("Misaligned snapshot record");
+        }
+        auto values = reinterpret_cast<const T*>(_bytes + _pos);
+        _pos += count * sizeof(T);
+        return values;
+    }
+
+    template<typename T>
+    T readUnaligned() {
+        check(sizeof(T));
+        T value;
+        std::memcpy(&value, _bytes + _pos, sizeof(T));
+        _pos += sizeof(T);
+        return value;
+    }
+
+    void readString(std::string& str) {
+        auto length = readUnaligned<uint32_t>();
+        check(length);
+        str.assign(_bytes + _pos, length);
+        _pos += length;
+    }
+
+    std::string readString() {
+        std::string str;
+        readString(str);
+        return str;
+    }
+
+    void skipPadding() {
+        _pos = std::min(getPaddedSize(_pos), _end);
+    }
+
+private:
+    void check(size_t size) const {
+        if (size > _end - _pos) {
+            throw std::runtime_error("Truncated snapshot");
+        }
+    }
+
+    const char* _bytes;
+    size_t _pos;
+    const size_t _end;
+};
+
+struct AttributeInfo {
+    std::string _name;
+    int _type;
+};
+
+// values larger than the chunk size are streamed by slices of the chunk size, as a read does
+template<typename T, typename Setter, typename Appender>
+void replayNumericValues(DataObjectHandler& handler, size_t chunkSize, long objectId, const std::string& attributeName, int type,
+                         int rowCount, int columnCount, const T* values, std::vector<T>& buffer, Setter setter, Appender appender) {
+    size_t count = (size_t) rowCount * columnCount;
+    if (count > chunkSize) {
+        handler.beginAttributeValue(objectId, attributeName, type, rowCount, columnCount);
+        for (size_t i = 0; i < count; i += chunkSize) {
+            appender(values + i, std::min(chunkSize, count - i));
+        }
+        handler.endAttributeValue();
+    } else {
+        buffer.assign(values, values + count);
+        setter(buffer);
+    }
+}
+
+}
+
+SnapshotWriter::SnapshotWriter(const std::string& fileName)
+    : _fileName(fileName),
+      _file(fileName, std::ios::binary | std::ios::trunc) {
+    if (!_file) {
+        throw std::runtime_error("Cannot open snapshot file '" + _fileName + "'");
+    }
+    // header is only known once everything has been written
+    SnapshotHeader header = {};
+    writeBytes(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+void SnapshotWriter::createClass(const std::string& name) {
+    if (_classIndexes.find(name) == _classIndexes.end()) {
+        _classIndexes.insert({name, (uint32_t) _classIndexes.size()});
+        writeString(_classes, name);
+    }
+}
+
+void SnapshotWriter::createAttribute(const std::string& className, const std::string& attributeName, int type, const std::string& description) {
+    uint32_t classIndex = _classIndexes.at(className);
+    auto key = std::make_pair(classIndex, attributeName);
+    if (_attributeIndexes.find(key) == _attributeIndexes.end()) {
+        _attributeIndexes.insert({key, (uint32_t) _attributeIndexes.size()});
+        write<uint32_t>(_attributes, classIndex);
+        write<int32_t>(_attributes, type);
+        writeString(_attributes, attributeName);
+        writeString(_attributes, description);
+    }
+}
+
+void SnapshotWriter::createObject(long id, const std::string& className, long parentId) {
+    _objectIndexes.insert({id, _objects.size()});
+    _objects.push_back({id, parentId, _classIndexes.at(className), 0});
+}
+
+void SnapshotWriter::setObjectParent(long id, long parentId) {
+    _objects.at(_objectIndexes.at(id))._parentId = parentId;
+}
+
+std::string& SnapshotWriter::beginValue(int type, long objectId, const std::string& attributeName, size_t length) {
+    uint32_t classIndex = _objects.at(_objectIndexes.at(objectId))._classIndex;
+    auto it = _attributeIndexes.find(std::make_pair(classIndex, attributeName));
+    if (it == _attributeIndexes.end()) {
+        throw std::runtime_error("Attribute '" + attributeName + "' has not been declared");
+    }
+    auto& block = _pendingBlocks[type];
+    SnapshotValue value = {objectId, it->second, (uint32_t) length};
+    write(block._bytes, value);
+    block._count++;
+    return block._bytes;
+}
+
+void SnapshotWriter::endValue(int type) {
+    auto& block = _pendingBlocks[type];
+    pad(block._bytes);
+    if (block._bytes.size() >= SNAPSHOT_BLOCK_SIZE) {
+        writeBlock(type, block);
+    }
+}
+
+void SnapshotWriter::writeBlock(int type, Block& block) {
+    _blocks.push_back({type, 0, block._count, _offset, block._bytes.size()});
+    writeBytes(block._bytes.data(), block._bytes.size());
+    block._count = 0;
+    block._bytes.clear();
+}
+
+void SnapshotWriter::writeBytes(const char* bytes, size_t size) {
+    _file.write(bytes, (std::streamsize) size);
+    if (!_file) {
+        throw std::runtime_error("Failed to write snapshot file '" + _fileName + "'");
+    }
+    _offset += size;
+}
+
+void SnapshotWriter::setStringAttributeValue(long objectId, const std::string& attributeName, const std::string& value) {
+    beginValue(api::v2::DataObject::AttributeType::TYPE_STRING, objectId, attributeName, value.size()).append(value);
+    endValue(api::v2::DataObject::AttributeType::TYPE_STRING);
+}
+
+void SnapshotWriter::setIntAttributeValue(long objectId, const std::string& attributeName, int value) {
+    write<int32_t>(beginValue(api::v2::DataObject::AttributeType::TYPE_INTEGER, objectId, attributeName, 1), value);
+    endValue(api::v2::DataObject::AttributeType::TYPE_INTEGER);
+}
+
+void SnapshotWriter::setLongAttributeValue(long objectId, const std::string& attributeName, long value) {
+    write<int64_t>(beginValue(api::v2::DataObject::AttributeType::TYPE_INTEGER64, objectId, attributeName, 1), value);
+    endValue(api::v2::DataObject::AttributeType::TYPE_INTEGER64);
+}
+
+void SnapshotWriter::setDoubleAttributeValue(long objectId, const std::string& attributeName, double value) {
+    write<double>(beginValue(api::v2::DataObject::AttributeType::TYPE_DOUBLE, objectId, attributeName, 1), value);
+    endValue(api::v2::DataObject::AttributeType::TYPE_DOUBLE);
+}
+
+void SnapshotWriter::setObjectAttributeValue(long objectId, const std::string& attributeName, long otherObjectId) {
+    write<int64_t>(beginValue(api::v2::DataObject::AttributeType::TYPE_OBJECT, objectId, attributeName, 1), otherObjectId);
+    endValue(api::v2::DataObject::AttributeType::TYPE_OBJECT);
+}
+
+void SnapshotWriter::setIntVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int>& value) {
+    writeElements(beginValue(api::v2::DataObject::AttributeType::TYPE_INTEGER_VEC, objectId, attributeName, value.size()), value);
+    endValue(api::v2::DataObject::AttributeType::TYPE_INTEGER_VEC);
+}
+
+void SnapshotWriter::setLongVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& value) {
+    writeElements(beginValue(api::v2::DataObject::AttributeType::TYPE_INTEGER64_VEC, objectId, attributeName, value.size()), value);
+    endValue(api::v2::DataObject::AttributeType::TYPE_INTEGER64_VEC);
+}
+
+void SnapshotWriter::setDoubleVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<double>& value) {
+    writeElements(beginValue(api::v2::DataObject::AttributeType::TYPE_DOUBLE_VEC, objectId, attributeName, value.size()), value);
+    endValue(api::v2::DataObject::AttributeType::TYPE_DOUBLE_VEC);
+}
+
+void SnapshotWriter::setStringVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<std::string>& value) {
+    auto& bytes = beginValue(api::v2::DataObject::AttributeType::TYPE_STRING_VEC, objectId, attributeName, value.size());
+    for (const auto& str : value) {
+        writeString(bytes, str);
+    }
+    endValue(api::v2::DataObject::AttributeType::TYPE_STRING_VEC);
+}
+
+void SnapshotWriter::setObjectVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& otherObjectsIds) {
+    writeElements(beginValue(api::v2::DataObject::AttributeType::TYPE_OBJECT_VEC, objectId, attributeName, otherObjectsIds.size()), otherObjectsIds);
+    endValue(api::v2::DataObject::AttributeType::TYPE_OBJECT_VEC);
+}
+
+void SnapshotWriter::setDoubleMatrixAttributeValue(long objectId, const std::string& attributeName, int rowCount, int columnCount, const std::vector<double>& value) {
+    auto& bytes = beginValue(api::v2::DataObject::AttributeType::TYPE_DOUBLE_MAT, objectId, attributeName, (size_t) rowCount);
+    write<uint32_t>(bytes, (uint32_t) columnCount);
+    write<uint32_t>(bytes, 0);
+    writeElements(bytes, value);
+    endValue(api::v2::DataObject::AttributeType::TYPE_DOUBLE_MAT);
+}
+
+void SnapshotWriter::flush() {
+    if (!_file.is_open()) {
+        throw std::runtime_error("Snapshot file '" + _fileName + "' already written");
+    }
+    for (auto& e : _pendingBlocks) {
+        if (e.second._count > 0) {
+            writeBlock(e.first, e.second);
+        }
+    }
+
+    SnapshotHeader header = {};
+    std::memcpy(header._magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header._version = SNAPSHOT_VERSION;
+    header._classCount = (uint32_t) _classIndexes.size();
+    header._attributeCount = (uint32_t) _attributeIndexes.size();
+    header._objectCount = _objects.size();
+    header._blockCount = _blocks.size();
+
+    header._classesOffset = _offset;
+    pad(_classes);
+    writeBytes(_classes.data(), _classes.size());
+    header._attributesOffset = _offset;
+    pad(_attributes);
+    writeBytes(_attributes.data(), _attributes.size());
+    header._objectsOffset = _offset;
+    writeBytes(reinterpret_cast<const char*>(_objects.data()), _objects.size() * sizeof(SnapshotObject));
+    header._blocksOffset = _offset;
+    writeBytes(reinterpret_cast<const char*>(_blocks.data()), _blocks.size() * sizeof(SnapshotBlock));
+
+    _file.seekp(0);
+    _file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    _file.close();
+    if (!_file) {
+        throw std::runtime_error("Failed to write snapshot file '" + _fileName + "'");
+    }
+}
+
+SnapshotReader::SnapshotReader(const std::string& fileName)
+    : _fileName(fileName) {
+}
+
+void SnapshotReader::read(DataObjectHandler& handler, ReadProgress* progress) {
+    ReadOptions options;
+    options._progress = progress;
+    read(handler, options);
+}
+
+void SnapshotReader::read(DataObjectHandler& handler, const ReadOptions& options) {
+    ReadProgress* progress = options._progress;
+    size_t chunkSize = options._chunkSize > 0 && handler.isChunkedValueSupported() ? (size_t) options._chunkSize : SIZE_MAX;
+
+    std::ifstream file(_fileName, std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw std::runtime_error("Cannot open snapshot file '" + _fileName + "'");
+    }
+    auto size = (size_t) file.tellg();
+    file.seekg(0);
+    // 64 bits words so that records can be read in place
+    std::vector<uint64_t> buffer((size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    const char* bytes = reinterpret_cast<const char*>(buffer.data());
+    if (!file.read(reinterpret_cast<char*>(buffer.data()), (std::streamsize) size)) {
+        throw std::runtime_error("Cannot read snapshot file '" + _fileName + "'");
+    }
+
+    const auto& header = *ByteReader(bytes, size, 0, size).read<SnapshotHeader>();
+    if (std::memcmp(header._magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+        throw std::runtime_error("'" + _fileName + "' is not a snapshot file");
+    }
+    if (header._version != SNAPSHOT_VERSION) {
+        throw std::runtime_error("Unsupported snapshot version " + std::to_string(header._version));
+    }
+
+    ByteReader classReader(bytes, size, header._classesOffset, header._attributesOffset);
+    std::vector<std::string> classNames;
+    classNames.reserve(header._classCount);
+    for (uint32_t i = 0; i < header._classCount; i++) {
+        classNames.push_back(classReader.readString());
+        if (!options._schemaFirst) {
+            handler.createClass(classNames.back());
+        }
+    }
+
+    ByteReader attributeReader(bytes, size, header._attributesOffset, header._objectsOffset);
+    std::vector<AttributeInfo> attributes;
+    attributes.reserve(header._attributeCount);
+    std::vector<ClassSchema> schemas(options._schemaFirst ? classNames.size() : 0);
+    for (uint32_t i = 0; i < header._attributeCount; i++) {
+        auto classIndex = attributeReader.readUnaligned<uint32_t>();
+        auto type = attributeReader.readUnaligned<int32_t>();
+        auto name = attributeReader.readString();
+        auto description = attributeReader.readString();
+        if (options._schemaFirst) {
+            auto& schema = schemas.at(classIndex);
+            schema._hasDescriptions |= !description.empty();
+            schema._attributes.push_back({name, type, description});
+        } else {
+            handler.createAttribute(classNames.at(classIndex), name, type, description);
+        }
+        attributes.push_back({name, type});
+    }
+    if (options._schemaFirst) {
+        for (size_t i = 0; i < classNames.size(); i++) {
+            schemas[i]._className = classNames[i];
+        }
+        handler.createSchema(schemas);
+    }
+
+    // objects are stored in traversal order, so parents before children
+    const auto* objects = ByteReader(bytes, size, header._objectsOffset, header._blocksOffset).read<SnapshotObject>(header._objectCount);
+    for (uint64_t i = 0; i < header._objectCount; i++) {
+        if (progress) {
+            progress->checkCancelled();
+            progress->_objectCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        handler.createObject((long) objects[i]._id, classNames.at(objects[i]._classIndex), (long) objects[i]._parentId);
+    }
+
+    // reused from one value to the next, handlers taking vectors
+    std::string str;
+    std::vector<int> ints;
+    std::vector<int64_t> longs;
+    std::vector<double> doubles;
+    std::vector<std::string> strings;
+
+    const auto* blocks = ByteReader(bytes, size, header._blocksOffset, size).read<SnapshotBlock>(header._blockCount);
+    for (uint64_t i = 0; i < header._blockCount; i++) {
+        const auto& block = blocks[i];
+        if (progress) {
+            progress->checkCancelled();
+            progress->_attributeCount.fetch_add(block._count, std::memory_order_relaxed);
+        }
+        ByteReader reader(bytes, size, block._offset, block._offset + block._size);
+        for (uint64_t j = 0; j < block._count; j++) {
+            const auto& value = *reader.read<SnapshotValue>();
+            auto objectId = (long) value._objectId;
+            const auto& attributeName = attributes.at(value._attributeIndex)._name;
+            switch (block._type) {
+                case api::v2::DataObject::AttributeType::TYPE_STRING: {
+                    const char* chars = reader.read<char>(value._length);
+                    str.assign(chars, value._length);
+                    handler.setStringAttributeValue(objectId, attributeName, str);
+                    break;
+                }
+
+                case api::v2::DataObject::AttributeType::TYPE_INTEGER:
+                    handler.setIntAttributeValue(objectId, attributeName, *reader.read<int32_t>());
+                    break;
+
+                case api::v2::DataObject::AttributeType::TYPE_INTEGER64:
+                    handler.setLongAttributeValue(objectId, attributeName, (long) *reader.read<int64_t>());
+                    break;
+
+                case api::v2::DataObject::AttributeType::TYPE_DOUBLE:
+                    handler.setDoubleAttributeValue(objectId, attributeName, *reader.read<double>());
+                    break;
+
+                case api::v2::DataObject::AttributeType::TYPE_OBJECT:
+                    handler.setObjectAttributeValue(objectId, attributeName, (long) *reader.read<int64_t>());
+                    break;
+
+                case api::v2::DataObject::AttributeType::TYPE_INTEGER_VEC:
+                    replayNumericValues(handler, chunkSize, objectId, attributeName, block._type, (int) value._length, 1,
+                                        reader.read<int32_t>(value._length), ints,
+                                        [&](const std::vector<int>& values) { handler.setIntVectorAttributeValue(objectId, attributeName, values); },
+                                        [&](const int* values, size_t count) { handler.appendIntValues(values, count); });
+                    break;
+
+                case api::v2::DataObject::AttributeType::TYPE_INTEGER64_VEC:
+                    replayNumericValues(handler, chunkSize, objectId, attributeName, block._type, (int) value._length, 1,
+                                        reader.read<int64_t>(value._length), longs,
+                                        [&](const std::vector<int64_t>& values) { handler.setLongVectorAttributeValue(objectId, attributeName, values); },
+                                        [&](const int64_t* values, size_t count) { handler.appendLongValues(values, count); });
+                    break;
+
+                case api::v2::DataObject::AttributeType::TYPE_DOUBLE_VEC:
+                    replayNumericValues(handler, chunkSize, objectId, attributeName, block._type, (int) value._length, 1,
+                                        reader.read<double>(value._length), doubles,
+                                        [&](const std::vector<double>& values) { handler.setDoubleVectorAttributeValue(objectId, attributeName, values); },
+                                        [&](const double* values, size_t count) { handler.appendDoubleValues(values, count); });
+                    break;
+
+                case api::v2::DataObject::AttributeType::TYPE_STRING_VEC:
+                    strings.resize(value._length);
+                    for (auto& s : strings) {
+                        reader.readString(s);
+                    }
+                    handler.setStringVectorAttributeValue(objectId, attributeName, strings);
+                    break;
+
+                case api::v2::DataObject::AttributeType::TYPE_OBJECT_VEC: {
+                    const auto* values = reader.read<int64_t>(value._length);
+                    longs.assign(values, values + value._length);
+                    handler.setObjectVectorAttributeValue(objectId, attributeName, longs);
+                    break;
+                }
+
+                case api::v2::DataObject::AttributeType::TYPE_DOUBLE_MAT: {
+                    auto columnCount = *reader.read<uint32_t>(2);
+                    auto rowCount = (int) value._length;
+                    replayNumericValues(handler, chunkSize, objectId, attributeName, block._type, rowCount, (int) columnCount,
+                                        reader.read<double>((size_t) value._length * columnCount), doubles,
+                                        [&](const std::vector<double>& values) { handler.setDoubleMatrixAttributeValue(objectId, attributeName, rowCount, (int) columnCount, values); },
+                                        [&](const double* values, size_t count) { handler.appendDoubleValues(values, count); });
+                    break;
+                }
+
+                default:
+                    throw std::runtime_error("Unsupported attribute type " + std::to_string(block._type));
+            }
+            reader.skipPadding();
+        }
+    }
+
+    handler.flush();
+}
+
+TeeDataObjectHandler::TeeDataObjectHandler(DataObjectHandler& handler1, DataObjectHandler& handler2)
+    : _handler1(handler1),
+      _handler2(handler2) {
+}
+
+void TeeDataObjectHandler::createClass(const std::string& name) {
+    _handler1.createClass(name);
+    _handler2.createClass(name);
+}
+
+void TeeDataObjectHandler::createAttribute(const std::string& className, const std::string& attributeName, int type, const std::string& description) {
+    _handler1.createAttribute(className, attributeName, type, description);
+    _handler2.createAttribute(className, attributeName, type, description);
+}
+
+void TeeDataObjectHandler::createSchema(const std::vector<ClassSchema>& schemas) {
+    _handler1.createSchema(schemas);
+    _handler2.createSchema(schemas);
+}
+
+void TeeDataObjectHandler::createObject(long id, const std::string& className, long parentId) {
+    _handler1.createObject(id, className, parentId);
+    _handler2.createObject(id, className, parentId);
+}
+
+void TeeDataObjectHandler::setObjectParent(long id, long parentId) {
+    _handler1.setObjectParent(id, parentId);
+    _handler2.setObjectParent(id, parentId);
+}
+
+void TeeDataObjectHandler::updateObject(long id) {
+    _handler1.updateObject(id);
+    _handler2.updateObject(id);
+}
+
+void TeeDataObjectHandler::deleteObject(long id) {
+    _handler1.deleteObject(id);
+    _handler2.deleteObject(id);
+}
+
+void TeeDataObjectHandler::setStringAttributeValue(long objectId, const std::string& attributeName, const std::string& value) {
+    _handler1.setStringAttributeValue(objectId, attributeName, value);
+    _handler2.setStringAttributeValue(objectId, attributeName, value);
+}
+
+void TeeDataObjectHandler::setIntAttributeValue(long objectId, const std::string& attributeName, int value) {
+    _handler1.setIntAttributeValue(objectId, attributeName, value);
+    _handler2.setIntAttributeValue(objectId, attributeName, value);
+}
+
+void TeeDataObjectHandler::setLongAttributeValue(long objectId, const std::string& attributeName, long value) {
+    _handler1.setLongAttributeValue(objectId, attributeName, value);
+    _handler2.setLongAttributeValue(objectId, attributeName, value);
+}
+
+void TeeDataObjectHandler::setDoubleAttributeValue(long objectId, const std::string& attributeName, double value) {
+    _handler1.setDoubleAttributeValue(objectId, attributeName, value);
+    _handler2.setDoubleAttributeValue(objectId, attributeName, value);
+}
+
+void TeeDataObjectHandler::setObjectAttributeValue(long objectId, const std::string& attributeName, long otherObjectId) {
+    _handler1.setObjectAttributeValue(objectId, attributeName, otherObjectId);
+    _handler2.setObjectAttributeValue(objectId, attributeName, otherObjectId);
+}
+
+void TeeDataObjectHandler::setIntVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int>& value) {
+    _handler1.setIntVectorAttributeValue(objectId, attributeName, value);
+    _handler2.setIntVectorAttributeValue(objectId, attributeName, value);
+}
+
+void TeeDataObjectHandler::setLongVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& value) {
+    _handler1.setLongVectorAttributeValue(objectId, attributeName, value);
+    _handler2.setLongVectorAttributeValue(objectId, attributeName, value);
+}
+
+void TeeDataObjectHandler::setDoubleVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<double>& value) {
+    _handler1.setDoubleVectorAttributeValue(objectId, attributeName, value);
+    _handler2.setDoubleVectorAttributeValue(objectId, attributeName, value);
+}
+
+void TeeDataObjectHandler::setStringVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<std::string>& value) {
+    _handler1.setStringVectorAttributeValue(objectId, attributeName, value);
+    _handler2.setStringVectorAttributeValue(objectId, attributeName, value);
+}
+
+void TeeDataObjectHandler::setObjectVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& otherObjectsIds) {
+    _handler1.setObjectVectorAttributeValue(objectId, attributeName, otherObjectsIds);
+    _handler2.setObjectVectorAttributeValue(objectId, attributeName, otherObjectsIds);
+}
+
+void TeeDataObjectHandler::setDoubleMatrixAttributeValue(long objectId, const std::string& attributeName, int rowCount, int columnCount, const std::vector<double>& value) {
+    _handler1.setDoubleMatrixAttributeValue(objectId, attributeName, rowCount, columnCount, value);
+    _handler2.setDoubleMatrixAttributeValue(objectId, attributeName, rowCount, columnCount, value);
+}
+
+bool TeeDataObjectHandler::isChunkedValueSupported() const {
+    return _handler1.isChunkedValueSupported() && _handler2.isChunkedValueSupported();
+}
+
+void TeeDataObjectHandler::beginAttributeValue(long objectId, const std::string& attributeName, int type, int rowCount, int columnCount) {
+    _handler1.beginAttributeValue(objectId, attributeName, type, rowCount, columnCount);
+    _handler2.beginAttributeValue(objectId, attributeName, type, rowCount, columnCount);
+}
+
+void TeeDataObjectHandler::appendIntValues(const int* values, size_t count) {
+    _handler1.appendIntValues(values, count);
+    _handler2.appendIntValues(values, count);
+}
+
+void TeeDataObjectHandler::appendLongValues(const int64_t* values, size_t count) {
+    _handler1.appendLongValues(values, count);
+    _handler2.appendLongValues(values, count);
+}
+
+void TeeDataObjectHandler::appendDoubleValues(const double* values, size_t count) {
+    _handler1.appendDoubleValues(values, count);
+    _handler2.appendDoubleValues(values, count);
+}
+
+void TeeDataObjectHandler::endAttributeValue() {
+    _handler1.endAttributeValue();
+    _handler2.endAttributeValue();
+}
+
+void TeeDataObjectHandler::flush() {
+    _handler1.flush();
+    _handler2.flush();
+}
+
+}
+
+}
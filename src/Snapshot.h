@@ -0,0 +1,240 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file Snapshot.h
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#ifndef POWSYBL_POWERFACTORY_DB_NATIVE_SNAPSHOT_H
+#define POWSYBL_POWERFACTORY_DB_NATIVE_SNAPSHOT_H
+
+#include <fstream>
+#include <map>
+#include <unordered_map>
+#include "DataObjectHandler.h"
+#include "ReadOptions.h"
+#include "ReadProgress.h"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+/**
+ * Binary snapshot of a project, little endian, laid out so that it can be used in place once loaded or mapped: every
+ * section and every record starts on an 8 bytes boundary and the header gives the offset of each section.
+ *
+ * header        : SnapshotHeader
+ * value blocks  : one after the other, each one holding count values of a single attribute type as
+ *                 (SnapshotValue, payload padded to 8 bytes)
+ * class table   : class count x string
+ * attributes    : attribute count x (uint32 class index, int32 type, string name, string description)
+ * objects       : object count x SnapshotObject, parents always before their children
+ * block index   : block count x SnapshotBlock, in file order
+ *
+ * Value payloads are the value itself for scalars, length elements for vectors, length UTF-8 bytes for strings,
+ * length strings for string vectors, uint32 column count, uint32 padding and length x column count row major elements
+ * for matrices, length being the row count. Strings are uint32 length followed by UTF-8 bytes. Value blocks come first
+ * so that they can be written as they are filled, other sections being only known at the end.
+ */
+const char SNAPSHOT_MAGIC[4] = {'P', 'F', 'D', 'B'};
+const uint32_t SNAPSHOT_VERSION = 2;
+
+// values are written to the file by blocks of about this size, so that the writer does not keep them in memory
+const size_t SNAPSHOT_BLOCK_SIZE = 1 << 20;
+
+struct SnapshotHeader {
+    char _magic[4];
+    uint32_t _version;
+    uint32_t _classCount;
+    uint32_t _attributeCount;
+    uint64_t _objectCount;
+    uint64_t _blockCount;
+    uint64_t _classesOffset;
+    uint64_t _attributesOffset;
+    uint64_t _objectsOffset;
+    uint64_t _blocksOffset;
+};
+
+struct SnapshotObject {
+    int64_t _id;
+    int64_t _parentId;
+    uint32_t _classIndex;
+    uint32_t _padding;
+};
+
+struct SnapshotBlock {
+    int32_t _type;
+    uint32_t _padding;
+    uint64_t _count;
+    uint64_t _offset;
+    uint64_t _size;
+};
+
+struct SnapshotValue {
+    int64_t _objectId;
+    uint32_t _attributeIndex;
+    uint32_t _length;
+};
+
+static_assert(sizeof(SnapshotHeader) == 64 && sizeof(SnapshotObject) == 24 && sizeof(SnapshotBlock) == 32
+              && sizeof(SnapshotValue) == 16, "Unexpected snapshot record padding");
+
+/**
+ * Serializes everything it receives to a binary snapshot file. Values are written as blocks are filled, classes,
+ * attributes and objects on flush.
+ */
+class SnapshotWriter : public DataObjectHandler {
+public:
+    explicit SnapshotWriter(const std::string& fileName);
+
+    void createClass(const std::string& name) override;
+
+    void createAttribute(const std::string& className, const std::string& attributeName, int type, const std::string& description) override;
+
+    void createObject(long id, const std::string& className, long parentId) override;
+
+    void setObjectParent(long id, long parentId) override;
+
+    void setStringAttributeValue(long objectId, const std::string& attributeName, const std::string& value) override;
+
+    void setIntAttributeValue(long objectId, const std::string& attributeName, int value) override;
+
+    void setLongAttributeValue(long objectId, const std::string& attributeName, long value) override;
+
+    void setDoubleAttributeValue(long objectId, const std::string& attributeName, double value) override;
+
+    void setObjectAttributeValue(long objectId, const std::string& attributeName, long otherObjectId) override;
+
+    void setIntVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int>& value) override;
+
+    void setLongVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& value) override;
+
+    void setDoubleVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<double>& value) override;
+
+    void setStringVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<std::string>& value) override;
+
+    void setObjectVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& otherObjectsIds) override;
+
+    void setDoubleMatrixAttributeValue(long objectId, const std::string& attributeName, int rowCount, int columnCount, const std::vector<double>& value) override;
+
+    void flush() override;
+
+private:
+    struct Block {
+        uint64_t _count = 0;
+        std::string _bytes;
+    };
+
+    std::string& beginValue(int type, long objectId, const std::string& attributeName, size_t length);
+
+    void endValue(int type);
+
+    void writeBlock(int type, Block& block);
+
+    void writeBytes(const char* bytes, size_t size);
+
+    std::string _fileName;
+    std::ofstream _file;
+    uint64_t _offset = 0;
+
+    std::map<std::string, uint32_t> _classIndexes;
+    std::map<std::pair<uint32_t, std::string>, uint32_t> _attributeIndexes;
+    std::string _classes;
+    std::string _attributes;
+
+    std::vector<SnapshotObject> _objects;
+    std::unordered_map<long, size_t> _objectIndexes;
+
+    // block being filled for each attribute type, and blocks already written
+    std::map<int, Block> _pendingBlocks;
+    std::vector<SnapshotBlock> _blocks;
+};
+
+/**
+ * Replays a binary snapshot file to a data object handler, as if the project was read from PowerFactory. The file is
+ * loaded at once in an 8 bytes aligned buffer and records are read in place.
+ */
+class SnapshotReader {
+public:
+    explicit SnapshotReader(const std::string& fileName);
+
+    // replayed objects and values are counted in the progress if given, and cancellation is checked between them
+    void read(DataObjectHandler& handler, ReadProgress* progress = nullptr);
+
+    // replayed as a read with these options sends them: schema in a single call first if asked for, numeric vectors
+    // and matrices larger than the chunk size streamed, progress of the options counted
+    void read(DataObjectHandler& handler, const ReadOptions& options);
+
+private:
+    std::string _fileName;
+};
+
+/**
+ * Forwards everything it receives to two handlers, typically to fill a snapshot while feeding Java.
+ */
+class TeeDataObjectHandler : public DataObjectHandler {
+public:
+    TeeDataObjectHandler(DataObjectHandler& handler1, DataObjectHandler& handler2);
+
+    void createClass(const std::string& name) override;
+
+    void createAttribute(const std::string& className, const std::string& attributeName, int type, const std::string& description) override;
+
+    void createSchema(const std::vector<ClassSchema>& schemas) override;
+
+    void createObject(long id, const std::string& className, long parentId) override;
+
+    void setObjectParent(long id, long parentId) override;
+
+    void updateObject(long id) override;
+
+    void deleteObject(long id) override;
+
+    void setStringAttributeValue(long objectId, const std::string& attributeName, const std::string& value) override;
+
+    void setIntAttributeValue(long objectId, const std::string& attributeName, int value) override;
+
+    void setLongAttributeValue(long objectId, const std::string& attributeName, long value) override;
+
+    void setDoubleAttributeValue(long objectId, const std::string& attributeName, double value) override;
+
+    void setObjectAttributeValue(long objectId, const std::string& attributeName, long otherObjectId) override;
+
+    void setIntVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int>& value) override;
+
+    void setLongVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& value) override;
+
+    void setDoubleVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<double>& value) override;
+
+    void setStringVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<std::string>& value) override;
+
+    void setObjectVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& otherObjectsIds) override;
+
+    void setDoubleMatrixAttributeValue(long objectId, const std::string& attributeName, int rowCount, int columnCount, const std::vector<double>& value) override;
+
+    bool isChunkedValueSupported() const override;
+
+    void beginAttributeValue(long objectId, const std::string& attributeName, int type, int rowCount, int columnCount) override;
+
+    void appendIntValues(const int* values, size_t count) override;
+
+    void appendLongValues(const int64_t* values, size_t count) override;
+
+    void appendDoubleValues(const double* values, size_t count) override;
+
+    void endAttributeValue() override;
+
+    void flush() override;
+
+private:
+    DataObjectHandler& _handler1;
+    DataObjectHandler& _handler2;
+};
+
+}
+
+}
+
+#endif //POWSYBL_POWERFACTORY_DB_NATIVE_SNAPSHOT_H
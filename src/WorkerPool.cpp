@@ -0,0 +1,142 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file WorkerPool.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <spawn.h>
+#include <sys/wait.h>
+extern char** environ;
+#endif
+#include "WorkerPool.h"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+WorkerPool::WorkerPool(const std::string& workerExecutable, size_t workerCount)
+    : _workerExecutable(workerExecutable),
+      _workerCount(std::max(workerCount, (size_t) 1)) {
+}
+
+std::string quoteWindowsArgument(const std::string& argument) {
+    if (!argument.empty() && argument.find_first_of(" \t\n\v\"") == std::string::npos) {
+        return argument;
+    }
+    // backslashes are only special before a quote, they are doubled there and before the closing quote, and the
+    // quote itself is escaped
+    std::string quoted = "\"";
+    size_t backslashCount = 0;
+    for (char c : argument) {
+        if (c == '\\') {
+            backslashCount++;
+            continue;
+        }
+        quoted.append(c == '"' ? backslashCount * 2 + 1 : backslashCount, '\\');
+        backslashCount = 0;
+        quoted.push_back(c);
+    }
+    quoted.append(backslashCount * 2, '\\');
+    quoted.push_back('"');
+    return quoted;
+}
+
+#ifdef _WIN32
+
+int WorkerPool::runProcess(const std::vector<std::string>& arguments) const {
+    // program name is parsed without escapes, it cannot contain quotes anyway
+    std::string commandLine = "\"" + _workerExecutable + "\"";
+    for (const auto& argument : arguments) {
+        commandLine += " " + quoteWindowsArgument(argument);
+    }
+
+    STARTUPINFOA startupInfo;
+    ZeroMemory(&startupInfo, sizeof(startupInfo));
+    startupInfo.cb = sizeof(startupInfo);
+    PROCESS_INFORMATION processInfo;
+    ZeroMemory(&processInfo, sizeof(processInfo));
+    if (!CreateProcessA(nullptr, &commandLine[0], nullptr, nullptr, FALSE, 0, nullptr, nullptr, &startupInfo, &processInfo)) {
+        throw std::runtime_error("Cannot start worker '" + _workerExecutable + "'");
+    }
+    WaitForSingleObject(processInfo.hProcess, INFINITE);
+    DWORD exitCode = 1;
+    GetExitCodeProcess(processInfo.hProcess, &exitCode);
+    CloseHandle(processInfo.hThread);
+    CloseHandle(processInfo.hProcess);
+    return (int) exitCode;
+}
+
+#else
+
+int WorkerPool::runProcess(const std::vector<std::string>& arguments) const {
+    std::vector<char*> argv;
+    argv.push_back(const_cast<char*>(_workerExecutable.c_str()));
+    for (const auto& argument : arguments) {
+        argv.push_back(const_cast<char*>(argument.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    pid_t pid;
+    if (posix_spawn(&pid, _workerExecutable.c_str(), nullptr, nullptr, argv.data(), environ) != 0) {
+        throw std::runtime_error("Cannot start worker '" + _workerExecutable + "'");
+    }
+    int status;
+    if (waitpid(pid, &status, 0) == -1 || !WIFEXITED(status)) {
+        return 1;
+    }
+    return WEXITSTATUS(status);
+}
+
+#endif
+
+void WorkerPool::run(const std::vector<std::vector<std::string>>& argumentLists) const {
+    // each thread only waits for its worker process, so threads are cheap compared to processes
+    std::atomic<size_t> next{0};
+    std::mutex errorMutex;
+    std::string error;
+    auto worker = [&]() {
+        for (size_t i = next++; i < argumentLists.size(); i = next++) {
+            std::string workerError;
+            try {
+                int exitCode = runProcess(argumentLists[i]);
+                if (exitCode != 0) {
+                    workerError = "Worker " + std::to_string(i) + " failed with exit code " + std::to_string(exitCode);
+                }
+            } catch (const std::exception& e) {
+                workerError = e.what();
+            }
+            if (!workerError.empty()) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (error.empty()) {
+                    error = workerError;
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < std::min(_workerCount, argumentLists.size()); i++) {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (!error.empty()) {
+        throw std::runtime_error(error);
+    }
+}
+
+}
+
+}
@@ -0,0 +1,47 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file WorkerPool.h
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#ifndef POWSYBL_POWERFACTORY_DB_NATIVE_WORKERPOOL_H
+#define POWSYBL_POWERFACTORY_DB_NATIVE_WORKERPOOL_H
+
+#include <string>
+#include <vector>
+
+namespace powsybl {
+
+namespace powerfactory {
+
+// quotes an argument of a Windows command line so that CommandLineToArgvW and the C runtime give it back unchanged
+std::string quoteWindowsArgument(const std::string& argument);
+
+/**
+ * Runs the worker executable once per argument list, with at most a given number of worker processes at the same
+ * time. PowerFactory API cannot be driven by several threads, so reading projects in parallel requires one engine
+ * per process.
+ */
+class WorkerPool {
+public:
+    WorkerPool(const std::string& workerExecutable, size_t workerCount);
+
+    // throws if a worker could not be started or exited with a non zero code, once all workers are done
+    void run(const std::vector<std::vector<std::string>>& argumentLists) const;
+
+private:
+    // exit code of the process
+    int runProcess(const std::vector<std::string>& arguments) const;
+
+    std::string _workerExecutable;
+    size_t _workerCount;
+};
+
+}
+
+}
+
+#endif //POWSYBL_POWERFACTORY_DB_NATIVE_WORKERPOOL_H
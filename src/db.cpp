@@ -8,203 +8,371 @@
  * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
  */
 #include <jni.h>
-#include <map>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
+#include <unordered_map>
 #include "jniwrapper.hpp"
-#include "api.h"
+#include "Api.h"
+#include "ArrowWriter.h"
+#include "ClassSchema.h"
+#include "JniDataObjectHandler.h"
+#include "ParallelRead.h"
+#include "Pipeline.h"
+#include "ProjectModel.h"
+#include "ProjectReader.h"
+#include "ReadOptions.h"
+#include "ReadProgress.h"
+#include "ReadStats.h"
+#include "Session.h"
+#include "Snapshot.h"
+#include "WorkerPool.h"
 
 namespace pf = powsybl::powerfactory;
 namespace jni = powsybl::jni;
 
-namespace powsybl {
+namespace {
 
-namespace powerfactory {
+pf::ReadOptions toReadOptions(JNIEnv* env, jobject j_options) {
+    pf::ReadOptions options;
+    if (j_options) {
+        jni::ComPowsyblPowerFactoryDbReadOptions readOptions(env, j_options);
+        options._batchSize = readOptions.getBatchSize();
+        options._cacheDir = readOptions.getCacheDir();
+        options._pipelineCapacity = readOptions.getPipelineCapacity();
+        options._chunkSize = readOptions.getChunkSize();
+        options._breadthFirst = readOptions.isBreadthFirst();
+        options._schemaFirst = readOptions.isSchemaFirst();
+        options._stringDictionary = readOptions.isStringDictionary();
+        options._readReferences = readOptions.isReadReferences();
+        options._maxReferenceDepth = readOptions.getMaxReferenceDepth();
+        for (const auto& className : readOptions.getClassNames()) {
+            options._classNames.insert(className);
+        }
+        for (const auto& className : readOptions.getAttributeClassNames()) {
+            auto attributeNames = readOptions.getAttributeNames(className);
+            options._attributeNames[className].insert(attributeNames.begin(), attributeNames.end());
+        }
+        options._excludedSubtreePatterns = readOptions.getExcludedSubtreePatterns();
+        options._traceFile = readOptions.getTraceFile();
+    }
+    return options;
+}
+
+std::unique_ptr<pf::DataObjectHandler> createHandler(jni::ComPowsyblPowerFactoryDbDataObjectBuilder& objectBuilder,
+                                                     const pf::ReadOptions& options) {
+    // a batch size of zero, or a builder without batch methods, keeps the one upcall per value mode
+    if (options._batchSize > 0 && objectBuilder.isBatchSupported()) {
+        return std::make_unique<pf::BatchedJniDataObjectHandler>(objectBuilder, options._batchSize, options._stringDictionary);
+    }
+    return std::make_unique<pf::JniDataObjectHandler>(objectBuilder, options._stringDictionary);
+}
 
-int getRowCount(api::v2::DataObject* object, const std::string& attributeName) {
-    int rowCount;
-    int columnCount;
-    object->GetAttributeSize(attributeName.c_str(), rowCount, columnCount);
-    return rowCount;
+// handler timing the calls to the given one, null if the options do not collect statistics
+std::unique_ptr<pf::DataObjectHandler> createInstrumentedHandler(pf::DataObjectHandler& handler, const pf::ReadOptions& options) {
+    if (options._stats) {
+        return std::make_unique<pf::InstrumentedDataObjectHandler>(handler, *options._stats);
+    }
+    return nullptr;
 }
 
-void readValues(Api &api, const jni::ComPowsyblPowerFactoryDbDataObjectBuilder &objectBuilder,
-                api::v2::DataObject* object, long id, const std::string& attributeName, int type) {
-    // set attribute value to object
-    switch (type) {
-        case api::v2::DataObject::AttributeType::TYPE_STRING: {
-            auto value = api.makeValueUniquePtr(object->GetAttributeString(attributeName.c_str()));
-            if (value) {
-                objectBuilder.setStringAttributeValue(id, attributeName, value->GetString());
-            }
-            break;
+// reads with the handler selected by the options, running the reader through a pipeline if requested
+void read(jni::ComPowsyblPowerFactoryDbDataObjectBuilder& objectBuilder, const pf::ReadOptions& options,
+          const std::function<void(pf::DataObjectHandler&)>& reader) {
+    auto jniHandler = createHandler(objectBuilder, options);
+    auto instrumentedHandler = createInstrumentedHandler(*jniHandler, options);
+    pf::DataObjectHandler& handler = instrumentedHandler ? *instrumentedHandler : *jniHandler;
+
+    if (options._pipelineCapacity > 0) {
+        // PowerFactory API is driven by a dedicated thread while this one, attached to the JVM, calls the builder
+        pf::Pipeline(options._pipelineCapacity).run(reader, handler);
+    } else {
+        reader(handler);
+    }
+}
+
+// statistics are only collected if a stats object or a trace file is given in the options
+std::unique_ptr<pf::ReadStats> createStats(JNIEnv* env, jobject j_options, pf::ReadOptions& options) {
+    std::unique_ptr<pf::ReadStats> stats;
+    if (j_options) {
+        jobject j_stats = jni::ComPowsyblPowerFactoryDbReadOptions(env, j_options).getStats();
+        if (j_stats || !options._traceFile.empty()) {
+            stats = std::make_unique<pf::ReadStats>(!options._traceFile.empty());
         }
+        env->DeleteLocalRef(j_stats);
+    }
+    options._stats = stats.get();
+    return stats;
+}
+
+void reportStats(JNIEnv* env, jobject j_options, const pf::ReadStats& stats, const pf::ReadOptions& options) {
+    if (!options._traceFile.empty()) {
+        stats.writeChromeTrace(options._traceFile);
+    }
+    jobject j_stats = jni::ComPowsyblPowerFactoryDbReadOptions(env, j_options).getStats();
+    if (j_stats) {
+        jni::ComPowsyblPowerFactoryDbReadStats readStats(env, j_stats);
+        stats.visit([&](const std::string& category, const std::string& name, uint64_t count, int64_t nanos) {
+            readStats.addCounter(category, name, (int64_t) count, nanos);
+        });
+        env->DeleteLocalRef(j_stats);
+    }
+}
+
+// sessions of all readers, handles being shared by them
+pf::SessionRegistry& getSessionRegistry() {
+    static pf::SessionRegistry registry;
+    return registry;
+}
+
+jlongArray toIdArray(JNIEnv* env, const std::vector<long>& ids) {
+    std::vector<jlong> values(ids.begin(), ids.end());
+    jlongArray array = env->NewLongArray((jsize) values.size());
+    env->SetLongArrayRegion(array, 0, (jsize) values.size(), values.data());
+    return array;
+}
 
-        case api::v2::DataObject::AttributeType::TYPE_INTEGER: {
-            int value = object->GetAttributeInt(attributeName.c_str());
-            objectBuilder.setIntAttributeValue(id, attributeName, value);
-            break;
+// a read running on its own native thread attached to the JVM, while another one reports its progress to a listener
+// at a fixed interval until the read is over. Threads and Java references are only freed by release, whether the read
+// has been waited for or not
+class AsyncRead {
+public:
+    AsyncRead(JNIEnv* env, const std::string& powerFactoryHomeDir, const std::string& projectName, jobject j_objectBuilder,
+              jobject j_options, jobject j_listener, int progressIntervalMillis)
+        : _powerFactoryHomeDir(powerFactoryHomeDir),
+          _projectName(projectName),
+          _progressInterval(progressIntervalMillis) {
+        if (progressIntervalMillis <= 0) {
+            throw std::runtime_error("Progress interval has to be positive");
         }
+        if (env->GetJavaVM(&_vm) != JNI_OK) {
+            throw std::runtime_error("Cannot get Java VM");
+        }
+        // Java classes are resolved on this thread, as attached native threads only see the system class loader
+        jni::ComPowsyblPowerFactoryDbDataObjectBuilder::init(env);
+        jni::ComPowsyblPowerFactoryDbReadStats::init(env);
+        jni::ComPowsyblPowerFactoryDbReadProgressListener::init(env);
+        _options = toReadOptions(env, j_options);
+        _stats = createStats(env, j_options, _options);
+        _options._progress = &_progress;
+
+        _objectBuilder = env->NewGlobalRef(j_objectBuilder);
+        _optionsObj = j_options ? env->NewGlobalRef(j_options) : nullptr;
+        _listener = j_listener ? env->NewGlobalRef(j_listener) : nullptr;
 
-        case api::v2::DataObject::AttributeType::TYPE_INTEGER64: {
-            long value = object->GetAttributeInt64(attributeName.c_str());
-            objectBuilder.setLongAttributeValue(id, attributeName, value);
-            break;
+        _readThread = std::thread(&AsyncRead::runRead, this);
+        _progressThread = std::thread(&AsyncRead::reportProgress, this);
+    }
+
+    ~AsyncRead() {
+        if (_readThread.joinable()) {
+            _progress._cancelled = true;
+            _readThread.join();
+        }
+        if (_progressThread.joinable()) {
+            _progressThread.join();
         }
+    }
+
+    void cancel() {
+        _progress._cancelled = true;
+    }
 
-        case api::v2::DataObject::AttributeType::TYPE_DOUBLE: {
-            double value = object->GetAttributeDouble(attributeName.c_str());
-            objectBuilder.setDoubleAttributeValue(id, attributeName, value);
-            break;
+    // waits for the end of the read, a Java exception of the builder is rethrown as is, other errors as exceptions,
+    // only once
+    void wait(JNIEnv* env) {
+        std::lock_guard<std::mutex> lock(_waitMutex);
+        join(env);
+        if (_exception) {
+            env->Throw(_exception);
+            env->DeleteGlobalRef(_exception);
+            _exception = nullptr;
+        } else if (!_error.empty()) {
+            std::string error;
+            error.swap(_error);
+            throw std::runtime_error(error);
         }
+    }
 
-        case api::v2::DataObject::AttributeType::TYPE_OBJECT: {
-            auto otherObject = object->GetAttributeObject(attributeName.c_str());
-            objectBuilder.setObjectAttributeValue(id, attributeName, api.addObject(otherObject));
-            break;
+    // cancels the read if it is still running and waits for its end, an outcome not waited for being dropped
+    void release(JNIEnv* env) {
+        cancel();
+        std::lock_guard<std::mutex> lock(_waitMutex);
+        join(env);
+        if (_exception) {
+            env->DeleteGlobalRef(_exception);
+            _exception = nullptr;
         }
+    }
 
-        case api::v2::DataObject::AttributeType::TYPE_INTEGER_VEC: {
-            int rowCount = getRowCount(object, attributeName);
-            if (rowCount > 0) {
-                int col = 0;
-                std::vector<int> values;
-                values.reserve(rowCount);
-                for (int row = 0; row < rowCount; row++) {
-                    int value = object->GetAttributeInt(attributeName.c_str(), row, col);
-                    values.push_back(value);
-                }
-                objectBuilder.setIntVectorAttributeValue(id, attributeName, values);
-            }
-            break;
-        }
-
-        case api::v2::DataObject::AttributeType::TYPE_INTEGER64_VEC: {
-            int rowCount = getRowCount(object, attributeName);
-            if (rowCount > 0) {
-                int col = 0;
-                std::vector<long> values;
-                values.reserve(rowCount);
-                for (int row = 0; row < rowCount; row++) {
-                    long value = object->GetAttributeInt64(attributeName.c_str(), row, col);
-                    values.push_back(value);
-                }
-                objectBuilder.setLongVectorAttributeValue(id, attributeName, values);
-            }
-            break;
-        }
-
-        case api::v2::DataObject::AttributeType::TYPE_DOUBLE_VEC: {
-            int rowCount = getRowCount(object, attributeName);
-            if (rowCount > 0) {
-                int col = 0;
-                std::vector<double> values;
-                values.reserve(rowCount);
-                for (int row = 0; row < rowCount; row++) {
-                    double value = object->GetAttributeDouble(attributeName.c_str(), row, col);
-                    values.push_back(value);
+private:
+    // joins the threads and deletes the references they used, does nothing the second time
+    void join(JNIEnv* env) {
+        if (_readThread.joinable()) {
+            _readThread.join();
+        }
+        if (_progressThread.joinable()) {
+            _progressThread.join();
+        }
+        if (_objectBuilder) {
+            env->DeleteGlobalRef(_objectBuilder);
+            _objectBuilder = nullptr;
+        }
+        if (_optionsObj) {
+            env->DeleteGlobalRef(_optionsObj);
+            _optionsObj = nullptr;
+        }
+        if (_listener) {
+            env->DeleteGlobalRef(_listener);
+            _listener = nullptr;
+        }
+    }
+
+    JNIEnv* attach() {
+        JNIEnv* env = nullptr;
+        if (_vm->AttachCurrentThread(reinterpret_cast<void**>(&env), nullptr) != JNI_OK) {
+            return nullptr;
+        }
+        return env;
+    }
+
+    void runRead() {
+        JNIEnv* env = attach();
+        if (env) {
+            try {
+                jni::ComPowsyblPowerFactoryDbDataObjectBuilder objectBuilder(env, _objectBuilder);
+                read(objectBuilder, _options, [&](pf::DataObjectHandler& readerHandler) {
+                    pf::Api api(_powerFactoryHomeDir);
+                    pf::SchemaCache schemaCache;
+                    auto project = api.activateProject(_projectName);
+                    pf::readProject(api, schemaCache, readerHandler, project, _projectName, _options);
+                });
+                if (_stats) {
+                    reportStats(env, _optionsObj, *_stats, _options);
                 }
-                objectBuilder.setDoubleVectorAttributeValue(id, attributeName, values);
+            } catch (const std::exception& e) {
+                _error = e.what();
+            } catch (...) {
+                _error = "Unknown exception";
             }
-            break;
-        }
-
-        case api::v2::DataObject::AttributeType::TYPE_STRING_VEC: {
-            int rowCount = getRowCount(object, attributeName);
-            if (rowCount > 0) {
-                std::vector<std::string> values;
-                values.reserve(rowCount);
-                for (int row = 0; row < rowCount; row++) {
-                    auto value = api.makeValueUniquePtr(object->GetAttributeString(attributeName.c_str(), row));
-                    std::string valueStr = value ? value->GetString() : "";
-                    values.push_back(valueStr);
-                }
-                objectBuilder.setStringVectorAttributeValue(id, attributeName, values);
+            // would be lost when detaching
+            if (env->ExceptionCheck()) {
+                _exception = reinterpret_cast<jthrowable>(env->NewGlobalRef(env->ExceptionOccurred()));
+                env->ExceptionClear();
             }
-            break;
+            _vm->DetachCurrentThread();
+        } else {
+            _error = "Cannot attach read thread to Java VM";
         }
 
-        case api::v2::DataObject::AttributeType::TYPE_OBJECT_VEC: {
-            int rowCount = getRowCount(object, attributeName);
-            if (rowCount > 0) {
-                std::vector<long> values;
-                values.reserve(rowCount);
-                for (int row = 0; row < rowCount; row++) {
-                    auto otherObject = object->GetAttributeObject(attributeName.c_str(), row);
-                    values.push_back(api.addObject(otherObject));
-                }
-                objectBuilder.setObjectVectorAttributeValue(id, attributeName, values);
-            }
-            break;
-        }
-
-        case api::v2::DataObject::AttributeType::TYPE_DOUBLE_MAT: {
-            int rowCount;
-            int columnCount;
-            object->GetAttributeSize(attributeName.c_str(), rowCount, columnCount);
-            if (rowCount > 0 && columnCount > 0) {
-                std::vector<double> values;
-                values.reserve(rowCount * columnCount);
-                for (int row = 0; row < rowCount; row++) {
-                    for (int col = 0; col < columnCount; col++) {
-                        double value = object->GetAttributeDouble(attributeName.c_str(), row, col);
-                        values.push_back(value);
-                    }
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _done = true;
+        }
+        _doneCondition.notify_all();
+    }
+
+    void reportProgress() {
+        if (!_listener) {
+            return;
+        }
+        JNIEnv* env = attach();
+        if (!env) {
+            return;
+        }
+        {
+            jni::ComPowsyblPowerFactoryDbReadProgressListener listener(env, _listener);
+            std::unique_lock<std::mutex> lock(_mutex);
+            bool done = false;
+            while (!done) {
+                // last report once the read is over, with final counts
+                done = _doneCondition.wait_for(lock, _progressInterval, [this] { return _done; });
+                lock.unlock();
+                listener.onProgress((int64_t) _progress._objectCount.load(), (int64_t) _progress._attributeCount.load(),
+                                    (int64_t) _progress._pendingCount.load());
+                // a failing listener must not stop the read
+                if (env->ExceptionCheck()) {
+                    env->ExceptionClear();
                 }
-                objectBuilder.setDoubleMatrixAttributeValue(id, attributeName, rowCount, columnCount, values);
+                lock.lock();
             }
-            break;
         }
-
-        default:
-            throw std::runtime_error("Unsupported attribute type " + std::to_string(type));
+        _vm->DetachCurrentThread();
     }
-}
 
-void traverse(Api &api, const jni::ComPowsyblPowerFactoryDbDataObjectBuilder &objectBuilder,
-              api::v2::DataObject* object, long parentId, std::map<long, long>& idToParentId,
-              std::map<std::string, int>& attributeTypes, bool fillDescription) {
-    // create class if not already exist
-    std::string className = api.makeValueUniquePtr(object->GetClassNameA())->GetString();
-    objectBuilder.createClass(className);
+    const std::string _powerFactoryHomeDir;
+    const std::string _projectName;
+    const std::chrono::milliseconds _progressInterval;
 
-    // create object
-    long id = api.getObjectId(object);
-    idToParentId.insert({id, parentId});
-    objectBuilder.createObject(id, className);
+    JavaVM* _vm = nullptr;
+    jobject _objectBuilder = nullptr;
+    jobject _optionsObj = nullptr;
+    jobject _listener = nullptr;
 
-    auto attributeNames = api.getAttributeNames(*object);
-    for (auto itN = attributeNames.begin(); itN != attributeNames.end(); ++itN) {
-        auto& attributeName = *itN;
-        auto itType = attributeTypes.find(attributeName);
-        int type;
-        if (itType == attributeTypes.end()) {
-            type = object->GetAttributeType(attributeName.c_str());
-            attributeTypes.insert({attributeName, type});
-        } else {
-            type = itType->second;
-        }
-        if (type != api::v2::DataObject::AttributeType::TYPE_INVALID) { // what does it mean?
-            // create attribute if not already exist
-            std::string description;
-            if (fillDescription) {
-                auto descriptionValue = object->GetAttributeDescription(attributeName.c_str());
-                if (descriptionValue) {
-                    description = api.makeValueUniquePtr(descriptionValue)->GetString();
-                }
-            }
-            objectBuilder.createAttribute(className, attributeName, type, description);
+    pf::ReadOptions _options;
+    std::unique_ptr<pf::ReadStats> _stats;
+    pf::ReadProgress _progress;
+
+    std::mutex _mutex;
+    std::condition_variable _doneCondition;
+    bool _done = false;
+    std::string _error;
+    jthrowable _exception = nullptr;
+
+    // wait and release calls from several Java threads
+    std::mutex _waitMutex;
+
+    std::thread _readThread;
+    std::thread _progressThread;
+};
+
+/**
+ * Asynchronous reads by handle until they are released, so that a released handle is rejected instead of pointing to
+ * a deleted read. As for sessions, reads are shared with the calls in flight and handles are never reused.
+ */
+class AsyncReadRegistry {
+public:
+    long add(std::shared_ptr<AsyncRead> asyncRead) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        long handle = ++_lastHandle;
+        _reads.emplace(handle, std::move(asyncRead));
+        return handle;
+    }
 
-            readValues(api, objectBuilder, object, id, attributeName, type);
+    std::shared_ptr<AsyncRead> get(long handle) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _reads.find(handle);
+        if (it == _reads.end()) {
+            throw std::runtime_error("Invalid read handle");
         }
+        return it->second;
     }
 
-    auto children = api.getChildren(*object);
-    for (auto itC = children.begin(); itC != children.end(); ++itC) {
-        auto &child = *itC;
-        traverse(api, objectBuilder, child, id, idToParentId, attributeTypes, fillDescription);
+    std::shared_ptr<AsyncRead> remove(long handle) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _reads.find(handle);
+        if (it == _reads.end()) {
+            throw std::runtime_error("Invalid read handle");
+        }
+        auto asyncRead = std::move(it->second);
+        _reads.erase(it);
+        return asyncRead;
     }
-}
 
+private:
+    std::mutex _mutex;
+    std::unordered_map<long, std::shared_ptr<AsyncRead>> _reads;
+    long _lastHandle = 0;
+};
+
+AsyncReadRegistry& getAsyncReadRegistry() {
+    static AsyncReadRegistry registry;
+    return registry;
 }
 
 }
@@ -213,36 +381,483 @@ void traverse(Api &api, const jni::ComPowsyblPowerFactoryDbDataObjectBuilder &ob
 extern "C" {
 #endif
 
+/*
+ * Class:     com_powsybl_powerfactory_db_JniDatabaseReader
+ * Method:    readNative
+ * Signature: (Ljava/lang/String;Ljava/lang/String;Lcom/powsybl/powerfactory/db/DataObjectBuilder;Lcom/powsybl/powerfactory/db/ReadOptions;)V
+ */
+JNIEXPORT void JNICALL Java_com_powsybl_powerfactory_db_JniDatabaseReader_readNative__Ljava_lang_String_2Ljava_lang_String_2Lcom_powsybl_powerfactory_db_DataObjectBuilder_2Lcom_powsybl_powerfactory_db_ReadOptions_2
+(JNIEnv * env, jobject, jstring j_powerFactoryHomeDir, jstring j_projectName, jobject j_objectBuilder, jobject j_options) {
+    try {
+        std::string powerFactoryHomeDir = powsybl::jni::StringUTF(env, j_powerFactoryHomeDir).toStr();
+        std::string projectName = powsybl::jni::StringUTF(env, j_projectName).toStr();
+        pf::ReadOptions options = toReadOptions(env, j_options);
+        auto stats = createStats(env, j_options, options);
+
+        jni::ComPowsyblPowerFactoryDbDataObjectBuilder objectBuilder(env, j_objectBuilder);
+        read(objectBuilder, options, [&](pf::DataObjectHandler& readerHandler) {
+            pf::Api api(powerFactoryHomeDir);
+            pf::SchemaCache schemaCache;
+            auto project = api.activateProject(projectName);
+            pf::readProject(api, schemaCache, readerHandler, project, projectName, options);
+        });
+        if (stats) {
+            reportStats(env, j_options, *stats, options);
+        }
+    } catch (const std::exception& e) {
+        powsybl::jni::throwPowsyblException(env, e.what());
+    } catch (...) {
+        powsybl::jni::throwPowsyblException(env, "Unknown exception");
+    }
+}
+
 /*
  * Class:     com_powsybl_powerfactory_db_JniDatabaseReader
  * Method:    readNative
  * Signature: (Ljava/lang/String;Ljava/lang/String;Lcom/powsybl/powerfactory/db/DataObjectBuilder;)V
  */
-JNIEXPORT void JNICALL Java_com_powsybl_powerfactory_db_JniDatabaseReader_readNative
-(JNIEnv * env, jobject, jstring j_powerFactoryHomeDir, jstring j_projectName, jobject j_objectBuilder) {
+JNIEXPORT void JNICALL Java_com_powsybl_powerfactory_db_JniDatabaseReader_readNative__Ljava_lang_String_2Ljava_lang_String_2Lcom_powsybl_powerfactory_db_DataObjectBuilder_2
+(JNIEnv * env, jobject obj, jstring j_powerFactoryHomeDir, jstring j_projectName, jobject j_objectBuilder) {
+    // overload of previous versions, with default options
+    Java_com_powsybl_powerfactory_db_JniDatabaseReader_readNative__Ljava_lang_String_2Ljava_lang_String_2Lcom_powsybl_powerfactory_db_DataObjectBuilder_2Lcom_powsybl_powerfactory_db_ReadOptions_2(
+        env, obj, j_powerFactoryHomeDir, j_projectName, j_objectBuilder, nullptr);
+}
+
+/*
+ * Class:     com_powsybl_powerfactory_db_JniDatabaseReader
+ * Method:    startReadNative
+ * Signature: (Ljava/lang/String;Ljava/lang/String;Lcom/powsybl/powerfactory/db/DataObjectBuilder;Lcom/powsybl/powerfactory/db/ReadOptions;Lcom/powsybl/powerfactory/db/ReadProgressListener;I)J
+ */
+JNIEXPORT jlong JNICALL Java_com_powsybl_powerfactory_db_JniDatabaseReader_startReadNative
+(JNIEnv * env, jobject, jstring j_powerFactoryHomeDir, jstring j_projectName, jobject j_objectBuilder, jobject j_options,
+ jobject j_listener, jint j_progressIntervalMillis) {
+    try {
+        std::string powerFactoryHomeDir = powsybl::jni::StringUTF(env, j_powerFactoryHomeDir).toStr();
+        std::string projectName = powsybl::jni::StringUTF(env, j_projectName).toStr();
+        // to be released with releaseReadNative, whether it has been waited for or not
+        return (jlong) getAsyncReadRegistry().add(std::make_shared<AsyncRead>(env, powerFactoryHomeDir, projectName, j_objectBuilder,
+                                                                              j_options, j_listener, (int) j_progressIntervalMillis));
+    } catch (const std::exception& e) {
+        powsybl::jni::throwPowsyblException(env, e.what());
+    } catch (...) {
+        powsybl::jni::throwPowsyblException(env, "Unknown exception");
+    }
+    return 0;
+}
+
+/*
+ * Class:     com_powsybl_powerfactory_db_JniDatabaseReader
+ * Method:    cancelReadNative
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_powsybl_powerfactory_db_JniDatabaseReader_cancelReadNative
+(JNIEnv * env, jobject, jlong j_handle) {
+    try {
+        getAsyncReadRegistry().get((long) j_handle)->cancel();
+    } catch (const std::exception& e) {
+        powsybl::jni::throwPowsyblException(env, e.what());
+    } catch (...) {
+        powsybl::jni::throwPowsyblException(env, "Unknown exception");
+    }
+}
+
+/*
+ * Class:     com_powsybl_powerfactory_db_JniDatabaseReader
+ * Method:    waitReadNative
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_powsybl_powerfactory_db_JniDatabaseReader_waitReadNative
+(JNIEnv * env, jobject, jlong j_handle) {
+    try {
+        getAsyncReadRegistry().get((long) j_handle)->wait(env);
+    } catch (const std::exception& e) {
+        powsybl::jni::throwPowsyblException(env, e.what());
+    } catch (...) {
+        powsybl::jni::throwPowsyblException(env, "Unknown exception");
+    }
+}
+
+/*
+ * Class:     com_powsybl_powerfactory_db_JniDatabaseReader
+ * Method:    releaseReadNative
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_powsybl_powerfactory_db_JniDatabaseReader_releaseReadNative
+(JNIEnv * env, jobject, jlong j_handle) {
+    try {
+        // a read still running is cancelled, its threads are joined and its Java references deleted
+        getAsyncReadRegistry().remove((long) j_handle)->release(env);
+    } catch (const std::exception& e) {
+        powsybl::jni::throwPowsyblException(env, e.what());
+    } catch (...) {
+        powsybl::jni::throwPowsyblException(env, "Unknown exception");
+    }
+}
+
+/*
+ * Class:     com_powsybl_powerfactory_db_JniDatabaseReader
+ * Method:    readProjectsNative
+ * Signature: (Ljava/lang/String;[Ljava/lang/String;[Lcom/powsybl/powerfactory/db/DataObjectBuilder;Lcom/powsybl/powerfactory/db/DataObjectBuilder;Lcom/powsybl/powerfactory/db/ReadOptions;)V
+ */
+JNIEXPORT void JNICALL Java_com_powsybl_powerfactory_db_JniDatabaseReader_readProjectsNative
+(JNIEnv * env, jobject, jstring j_powerFactoryHomeDir, jobjectArray j_projectNames, jobjectArray j_objectBuilders,
+ jobject j_libraryObjectBuilder, jobject j_options) {
+    try {
+        std::string powerFactoryHomeDir = powsybl::jni::StringUTF(env, j_powerFactoryHomeDir).toStr();
+        std::vector<std::string> projectNames = powsybl::jni::toStringVector(env, j_projectNames);
+        pf::ReadOptions options = toReadOptions(env, j_options);
+        auto stats = createStats(env, j_options, options);
+
+        // builders and their handlers live for the whole batch, as library objects may be read after any project
+        std::vector<std::unique_ptr<jni::ComPowsyblPowerFactoryDbDataObjectBuilder>> objectBuilders;
+        std::vector<std::unique_ptr<pf::DataObjectHandler>> handlers;
+        std::vector<std::unique_ptr<pf::DataObjectHandler>> instrumentedHandlers;
+        std::vector<pf::DataObjectHandler*> handlerPtrs;
+        for (jsize i = 0; i < env->GetArrayLength(j_objectBuilders); i++) {
+            objectBuilders.push_back(std::make_unique<jni::ComPowsyblPowerFactoryDbDataObjectBuilder>(env, env->GetObjectArrayElement(j_objectBuilders, i)));
+            handlers.push_back(createHandler(*objectBuilders.back(), options));
+            instrumentedHandlers.push_back(createInstrumentedHandler(*handlers.back(), options));
+            handlerPtrs.push_back(instrumentedHandlers.back() ? instrumentedHandlers.back().get() : handlers.back().get());
+        }
+        jni::ComPowsyblPowerFactoryDbDataObjectBuilder libraryObjectBuilder(env, j_libraryObjectBuilder);
+        auto libraryHandler = createHandler(libraryObjectBuilder, options);
+        auto instrumentedLibraryHandler = createInstrumentedHandler(*libraryHandler, options);
+
+        pf::Api api(powerFactoryHomeDir);
+        pf::SchemaCache schemaCache;
+        pf::readProjects(api, schemaCache, projectNames, handlerPtrs,
+                         instrumentedLibraryHandler ? *instrumentedLibraryHandler : *libraryHandler, options);
+        if (stats) {
+            reportStats(env, j_options, *stats, options);
+        }
+    } catch (const std::exception& e) {
+        powsybl::jni::throwPowsyblException(env, e.what());
+    } catch (...) {
+        powsybl::jni::throwPowsyblException(env, "Unknown exception");
+    }
+}
+
+/*
+ * Class:     com_powsybl_powerfactory_db_JniDatabaseReader
+ * Method:    readProjectsParallelNative
+ * Signature: (Ljava/lang/String;Ljava/lang/String;[Ljava/lang/String;[Lcom/powsybl/powerfactory/db/DataObjectBuilder;Lcom/powsybl/powerfactory/db/DataObjectBuilder;Lcom/powsybl/powerfactory/db/ReadOptions;ILjava/lang/String;)V
+ */
+JNIEXPORT void JNICALL Java_com_powsybl_powerfactory_db_JniDatabaseReader_readProjectsParallelNative
+(JNIEnv * env, jobject, jstring j_workerExecutable, jstring j_powerFactoryHomeDir, jobjectArray j_projectNames,
+ jobjectArray j_objectBuilders, jobject j_libraryObjectBuilder, jobject j_options, jint j_workerCount, jstring j_workDir) {
+    try {
+        std::string workerExecutable = powsybl::jni::StringUTF(env, j_workerExecutable).toStr();
+        std::string powerFactoryHomeDir = powsybl::jni::StringUTF(env, j_powerFactoryHomeDir).toStr();
+        std::vector<std::string> projectNames = powsybl::jni::toStringVector(env, j_projectNames);
+        std::string workDir = powsybl::jni::StringUTF(env, j_workDir).toStr();
+        pf::ReadOptions options = toReadOptions(env, j_options);
+        if (env->GetArrayLength(j_objectBuilders) != (jsize) projectNames.size()) {
+            throw std::runtime_error("One builder is expected per project");
+        }
+
+        // each worker process reads a project to snapshots, with its own engine and the options that change what is
+        // read, the others apply to the handlers below
+        std::vector<std::string> snapshotFiles;
+        std::vector<std::vector<std::string>> argumentLists;
+        std::vector<std::string> optionArguments = pf::toWorkerArguments(options);
+        for (size_t i = 0; i < projectNames.size(); i++) {
+            snapshotFiles.push_back(workDir + "/project-" + std::to_string(i) + ".pfdb");
+            argumentLists.push_back({powerFactoryHomeDir, projectNames[i], snapshotFiles.back()});
+            argumentLists.back().insert(argumentLists.back().end(), optionArguments.begin(), optionArguments.end());
+        }
+        try {
+            pf::WorkerPool(workerExecutable, (size_t) j_workerCount).run(argumentLists);
+
+            // snapshots are merged on this thread with ids shared by all projects, as a single engine batch read
+            // would give them
+            std::vector<std::unique_ptr<jni::ComPowsyblPowerFactoryDbDataObjectBuilder>> objectBuilders;
+            std::vector<std::unique_ptr<pf::DataObjectHandler>> handlers;
+            std::vector<pf::DataObjectHandler*> handlerPtrs;
+            for (jsize i = 0; i < env->GetArrayLength(j_objectBuilders); i++) {
+                objectBuilders.push_back(std::make_unique<jni::ComPowsyblPowerFactoryDbDataObjectBuilder>(env, env->GetObjectArrayElement(j_objectBuilders, i)));
+                handlers.push_back(createHandler(*objectBuilders.back(), options));
+                handlerPtrs.push_back(handlers.back().get());
+            }
+            jni::ComPowsyblPowerFactoryDbDataObjectBuilder libraryObjectBuilder(env, j_libraryObjectBuilder);
+            auto libraryHandler = createHandler(libraryObjectBuilder, options);
+            pf::mergeWorkerSnapshots(snapshotFiles, handlerPtrs, *libraryHandler);
+        } catch (...) {
+            for (const auto& snapshotFile : snapshotFiles) {
+                pf::removeWorkerSnapshots(snapshotFile);
+            }
+            throw;
+        }
+        for (const auto& snapshotFile : snapshotFiles) {
+            pf::removeWorkerSnapshots(snapshotFile);
+        }
+    } catch (const std::exception& e) {
+        powsybl::jni::throwPowsyblException(env, e.what());
+    } catch (...) {
+        powsybl::jni::throwPowsyblException(env, "Unknown exception");
+    }
+}
+
+/*
+ * Class:     com_powsybl_powerfactory_db_JniDatabaseReader
+ * Method:    writeSnapshotNative
+ * Signature: (Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;)V
+ */
+JNIEXPORT void JNICALL Java_com_powsybl_powerfactory_db_JniDatabaseReader_writeSnapshotNative
+(JNIEnv * env, jobject, jstring j_powerFactoryHomeDir, jstring j_projectName, jstring j_snapshotFile) {
+    try {
+        std::string powerFactoryHomeDir = powsybl::jni::StringUTF(env, j_powerFactoryHomeDir).toStr();
+        std::string projectName = powsybl::jni::StringUTF(env, j_projectName).toStr();
+        std::string snapshotFile = powsybl::jni::StringUTF(env, j_snapshotFile).toStr();
+
+        pf::Api api(powerFactoryHomeDir);
+        auto project = api.activateProject(projectName);
+
+        pf::SchemaCache schemaCache;
+        pf::SnapshotWriter writer(snapshotFile);
+        pf::readProject(api, schemaCache, writer, project);
+    } catch (const std::exception& e) {
+        powsybl::jni::throwPowsyblException(env, e.what());
+    } catch (...) {
+        powsybl::jni::throwPowsyblException(env, "Unknown exception");
+    }
+}
+
+/*
+ * Class:     com_powsybl_powerfactory_db_JniDatabaseReader
+ * Method:    writeArrowNative
+ * Signature: (Ljava/lang/String;Ljava/lang/String;Ljava/lang/String;Lcom/powsybl/powerfactory/db/ReadOptions;)V
+ */
+JNIEXPORT void JNICALL Java_com_powsybl_powerfactory_db_JniDatabaseReader_writeArrowNative
+(JNIEnv * env, jobject, jstring j_powerFactoryHomeDir, jstring j_projectName, jstring j_directory, jobject j_options) {
     try {
         std::string powerFactoryHomeDir = powsybl::jni::StringUTF(env, j_powerFactoryHomeDir).toStr();
         std::string projectName = powsybl::jni::StringUTF(env, j_projectName).toStr();
+        std::string directory = powsybl::jni::StringUTF(env, j_directory).toStr();
+        pf::ReadOptions options = toReadOptions(env, j_options);
 
         pf::Api api(powerFactoryHomeDir);
         auto project = api.activateProject(projectName);
 
+        pf::SchemaCache schemaCache;
+        pf::ArrowWriter writer(directory);
+        pf::readProject(api, schemaCache, writer, project, projectName, options);
+    } catch (const std::exception& e) {
+        powsybl::jni::throwPowsyblException(env, e.what());
+    } catch (...) {
+        powsybl::jni::throwPowsyblException(env, "Unknown exception");
+    }
+}
+
+/*
+ * Class:     com_powsybl_powerfactory_db_JniDatabaseReader
+ * Method:    readDeltaNative
+ * Signature: (Ljava/lang/String;Ljava/lang/String;Lcom/powsybl/powerfactory/db/DataObjectBuilder;Lcom/powsybl/powerfactory/db/ReadOptions;Ljava/lang/String;Ljava/lang/String;)V
+ */
+JNIEXPORT void JNICALL Java_com_powsybl_powerfactory_db_JniDatabaseReader_readDeltaNative
+(JNIEnv * env, jobject, jstring j_powerFactoryHomeDir, jstring j_projectName, jobject j_objectBuilder, jobject j_options,
+ jstring j_previousSnapshotFile, jstring j_snapshotFile) {
+    try {
+        std::string powerFactoryHomeDir = powsybl::jni::StringUTF(env, j_powerFactoryHomeDir).toStr();
+        std::string projectName = powsybl::jni::StringUTF(env, j_projectName).toStr();
+        std::string previousSnapshotFile = powsybl::jni::StringUTF(env, j_previousSnapshotFile).toStr();
+        std::string snapshotFile = powsybl::jni::StringUTF(env, j_snapshotFile).toStr();
+        // filters have to be the same as the ones of the read that wrote the previous snapshot, and referenced objects
+        // read, so that references to library types are matched by path as project objects are instead of being lost
+        pf::ReadOptions options = toReadOptions(env, j_options);
+
         jni::ComPowsyblPowerFactoryDbDataObjectBuilder objectBuilder(env, j_objectBuilder);
+        if (!objectBuilder.isDeltaSupported()) {
+            throw std::runtime_error("Object builder does not support delta reads");
+        }
 
-        // create objects
-        std::map<long, long> idToParentId;
-        std::map<std::string, int> attributeTypes;
-        pf::traverse(api, objectBuilder, project, -1, idToParentId, attributeTypes, false);
-
-        // set parents
-        for (auto it = idToParentId.begin(); it != idToParentId.end(); ++it) {
-            long id = it->first;
-            long parentId = it->second;
-            if (parentId != -1) {
-                objectBuilder.setObjectParent(id, parentId);
-            }
+        pf::ProjectModel previousModel;
+        pf::SnapshotReader(previousSnapshotFile).read(previousModel);
+
+        pf::Api api(powerFactoryHomeDir);
+        auto project = api.activateProject(projectName);
+
+        pf::SchemaCache schemaCache;
+        pf::ProjectModel model;
+        pf::readProject(api, schemaCache, model, project, options);
+
+        // objects keep ids of the previous read so that the builder can apply the delta to what it already has
+        model.remapIds(previousModel);
+
+        pf::JniDataObjectHandler handler(objectBuilder, options._stringDictionary);
+        model.emitDelta(previousModel, handler);
+
+        // new snapshot becomes the reference for next delta read
+        pf::SnapshotWriter writer(snapshotFile);
+        model.replay(writer);
+    } catch (const std::exception& e) {
+        powsybl::jni::throwPowsyblException(env, e.what());
+    } catch (...) {
+        powsybl::jni::throwPowsyblException(env, "Unknown exception");
+    }
+}
+
+/*
+ * Class:     com_powsybl_powerfactory_db_JniDatabaseReader
+ * Method:    openSessionNative
+ * Signature: (Ljava/lang/String;)J
+ */
+JNIEXPORT jlong JNICALL Java_com_powsybl_powerfactory_db_JniDatabaseReader_openSessionNative
+(JNIEnv * env, jobject, jstring j_powerFactoryHomeDir) {
+    try {
+        std::string powerFactoryHomeDir = powsybl::jni::StringUTF(env, j_powerFactoryHomeDir).toStr();
+        return (jlong) getSessionRegistry().open(powerFactoryHomeDir);
+    } catch (const std::exception& e) {
+        powsybl::jni::throwPowsyblException(env, e.what());
+    } catch (...) {
+        powsybl::jni::throwPowsyblException(env, "Unknown exception");
+    }
+    return 0;
+}
+
+/*
+ * Class:     com_powsybl_powerfactory_db_JniDatabaseReader
+ * Method:    readSessionNative
+ * Signature: (JLjava/lang/String;Lcom/powsybl/powerfactory/db/DataObjectBuilder;Lcom/powsybl/powerfactory/db/ReadOptions;)V
+ */
+JNIEXPORT void JNICALL Java_com_powsybl_powerfactory_db_JniDatabaseReader_readSessionNative
+(JNIEnv * env, jobject, jlong j_handle, jstring j_projectName, jobject j_objectBuilder, jobject j_options) {
+    try {
+        auto session = getSessionRegistry().get((long) j_handle);
+        std::string projectName = powsybl::jni::StringUTF(env, j_projectName).toStr();
+        pf::ReadOptions options = toReadOptions(env, j_options);
+        auto stats = createStats(env, j_options, options);
+
+        std::lock_guard<std::mutex> lock(session->getMutex());
+        jni::ComPowsyblPowerFactoryDbDataObjectBuilder objectBuilder(env, j_objectBuilder);
+        read(objectBuilder, options, [&](pf::DataObjectHandler& readerHandler) {
+            auto project = session->activateProject(projectName);
+            pf::readProject(session->getApi(), session->getSchemaCache(), readerHandler, project, projectName, options);
+        });
+        if (stats) {
+            reportStats(env, j_options, *stats, options);
         }
+    } catch (const std::exception& e) {
+        powsybl::jni::throwPowsyblException(env, e.what());
+    } catch (...) {
+        powsybl::jni::throwPowsyblException(env, "Unknown exception");
+    }
+}
+
+/*
+ * Class:     com_powsybl_powerfactory_db_JniDatabaseReader
+ * Method:    getRootNative
+ * Signature: (JLjava/lang/String;)J
+ */
+JNIEXPORT jlong JNICALL Java_com_powsybl_powerfactory_db_JniDatabaseReader_getRootNative
+(JNIEnv * env, jobject, jlong j_handle, jstring j_projectName) {
+    try {
+        auto session = getSessionRegistry().get((long) j_handle);
+        std::string projectName = powsybl::jni::StringUTF(env, j_projectName).toStr();
+
+        std::lock_guard<std::mutex> lock(session->getMutex());
+        return (jlong) session->getApi().getObjectId(session->activateProject(projectName));
+    } catch (const std::exception& e) {
+        powsybl::jni::throwPowsyblException(env, e.what());
+    } catch (...) {
+        powsybl::jni::throwPowsyblException(env, "Unknown exception");
+    }
+    return -1;
+}
+
+/*
+ * Class:     com_powsybl_powerfactory_db_JniDatabaseReader
+ * Method:    getClassNameNative
+ * Signature: (JJ)Ljava/lang/String;
+ */
+JNIEXPORT jstring JNICALL Java_com_powsybl_powerfactory_db_JniDatabaseReader_getClassNameNative
+(JNIEnv * env, jobject, jlong j_handle, jlong j_id) {
+    try {
+        auto session = getSessionRegistry().get((long) j_handle);
+
+        std::lock_guard<std::mutex> lock(session->getMutex());
+        return env->NewStringUTF(session->getClassName((long) j_id).c_str());
+    } catch (const std::exception& e) {
+        powsybl::jni::throwPowsyblException(env, e.what());
+    } catch (...) {
+        powsybl::jni::throwPowsyblException(env, "Unknown exception");
+    }
+    return nullptr;
+}
+
+/*
+ * Class:     com_powsybl_powerfactory_db_JniDatabaseReader
+ * Method:    getChildrenNative
+ * Signature: (JJ)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_com_powsybl_powerfactory_db_JniDatabaseReader_getChildrenNative
+(JNIEnv * env, jobject, jlong j_handle, jlong j_id) {
+    try {
+        auto session = getSessionRegistry().get((long) j_handle);
+
+        std::lock_guard<std::mutex> lock(session->getMutex());
+        return toIdArray(env, session->getChildIds((long) j_id));
+    } catch (const std::exception& e) {
+        powsybl::jni::throwPowsyblException(env, e.what());
+    } catch (...) {
+        powsybl::jni::throwPowsyblException(env, "Unknown exception");
+    }
+    return nullptr;
+}
 
+/*
+ * Class:     com_powsybl_powerfactory_db_JniDatabaseReader
+ * Method:    getAttributesNative
+ * Signature: (JJ[Ljava/lang/String;Lcom/powsybl/powerfactory/db/DataObjectBuilder;)V
+ */
+JNIEXPORT void JNICALL Java_com_powsybl_powerfactory_db_JniDatabaseReader_getAttributesNative
+(JNIEnv * env, jobject, jlong j_handle, jlong j_id, jobjectArray j_attributeNames, jobject j_objectBuilder) {
+    try {
+        auto session = getSessionRegistry().get((long) j_handle);
+        std::vector<std::string> attributeNames = powsybl::jni::toStringVector(env, j_attributeNames);
+
+        std::lock_guard<std::mutex> lock(session->getMutex());
+        // values are set on an object the builder already knows from a previous cursor call
+        jni::ComPowsyblPowerFactoryDbDataObjectBuilder objectBuilder(env, j_objectBuilder);
+        pf::JniDataObjectHandler handler(objectBuilder);
+        session->readAttributes(handler, (long) j_id, attributeNames);
+    } catch (const std::exception& e) {
+        powsybl::jni::throwPowsyblException(env, e.what());
+    } catch (...) {
+        powsybl::jni::throwPowsyblException(env, "Unknown exception");
+    }
+}
+
+/*
+ * Class:     com_powsybl_powerfactory_db_JniDatabaseReader
+ * Method:    findByClassNative
+ * Signature: (JLjava/lang/String;)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_com_powsybl_powerfactory_db_JniDatabaseReader_findByClassNative
+(JNIEnv * env, jobject, jlong j_handle, jstring j_className) {
+    try {
+        auto session = getSessionRegistry().get((long) j_handle);
+        std::string className = powsybl::jni::StringUTF(env, j_className).toStr();
+
+        std::lock_guard<std::mutex> lock(session->getMutex());
+        return toIdArray(env, session->findByClass(className));
+    } catch (const std::exception& e) {
+        powsybl::jni::throwPowsyblException(env, e.what());
+    } catch (...) {
+        powsybl::jni::throwPowsyblException(env, "Unknown exception");
+    }
+    return nullptr;
+}
+
+/*
+ * Class:     com_powsybl_powerfactory_db_JniDatabaseReader
+ * Method:    closeSessionNative
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_powsybl_powerfactory_db_JniDatabaseReader_closeSessionNative
+(JNIEnv * env, jobject, jlong j_handle) {
+    try {
+        // calls in flight keep the session alive until they return
+        getSessionRegistry().close((long) j_handle);
     } catch (const std::exception& e) {
         powsybl::jni::throwPowsyblException(env, e.what());
     } catch (...) {
@@ -8,61 +8,53 @@
  * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
  */
 
+#include <stdexcept>
 #include "jniwrapper.hpp"
 
 namespace powsybl {
 
 namespace jni {
 
-jclass JavaLangDouble::_cls = nullptr;
-jmethodID JavaLangDouble::_constructor = nullptr;
+namespace {
 
-void JavaLangDouble::init(JNIEnv* env) {
-    if (!_cls) {
-        jclass localCls = env->FindClass("java/lang/Double");
-        _cls = reinterpret_cast<jclass>(env->NewGlobalRef(localCls));
-        _constructor = env->GetMethodID(_cls, "<init>", "(D)V");
-    }
+jintArray newIntArray(JNIEnv* env, const std::vector<int>& values) {
+    static_assert(sizeof(jint) == sizeof(int), "Unexpected jint size");
+    jintArray array = env->NewIntArray((jsize) values.size());
+    env->SetIntArrayRegion(array, 0, (jsize) values.size(), reinterpret_cast<const jint*>(values.data()));
+    return array;
 }
 
-JavaLangDouble::JavaLangDouble(JNIEnv* env, double d)
-    : JniWrapper<jobject>(env, nullptr) {
-    init(env);
-    _obj = env->NewObject(_cls, _constructor, d);
+jlongArray newLongArray(JNIEnv* env, const std::vector<int64_t>& values) {
+    static_assert(sizeof(jlong) == sizeof(int64_t), "Unexpected jlong size");
+    jlongArray array = env->NewLongArray((jsize) values.size());
+    env->SetLongArrayRegion(array, 0, (jsize) values.size(), reinterpret_cast<const jlong*>(values.data()));
+    return array;
 }
 
-jclass JavaLangInteger::_cls = nullptr;
-jmethodID JavaLangInteger::_constructor = nullptr;
-
-void JavaLangInteger::init(JNIEnv* env) {
-    if (!_cls) {
-        jclass localCls = env->FindClass("java/lang/Integer");
-        _cls = reinterpret_cast<jclass>(env->NewGlobalRef(localCls));
-        _constructor = env->GetMethodID(_cls, "<init>", "(I)V");
-    }
+jdoubleArray newDoubleArray(JNIEnv* env, const std::vector<double>& values) {
+    jdoubleArray array = env->NewDoubleArray((jsize) values.size());
+    env->SetDoubleArrayRegion(array, 0, (jsize) values.size(), values.data());
+    return array;
 }
 
-JavaLangInteger::JavaLangInteger(JNIEnv* env, int i)
-    : JniWrapper<jobject>(env, nullptr) {
-    init(env);
-    _obj = env->NewObject(_cls, _constructor, i);
 }
 
-jclass JavaLangLong::_cls = nullptr;
-jmethodID JavaLangLong::_constructor = nullptr;
-
-void JavaLangLong::init(JNIEnv* env) {
-    if (!_cls) {
-        jclass localCls = env->FindClass("java/lang/Long");
-        _cls = reinterpret_cast<jclass>(env->NewGlobalRef(localCls));
-        _constructor = env->GetMethodID(_cls, "<init>", "(J)V");
+JavaStringInternTable::~JavaStringInternTable() {
+    for (auto& e : _strings) {
+        _env->DeleteGlobalRef(e.second);
     }
 }
 
-JavaLangLong::JavaLangLong(JNIEnv* env, long l)
-    : JniWrapper<jobject>(env, nullptr) {
-    init(env);
-    _obj = env->NewObject(_cls, _constructor, l);
+jstring JavaStringInternTable::get(const std::string& str) {
+    auto it = _strings.find(str);
+    if (it == _strings.end()) {
+        jstring j_str = _env->NewStringUTF(str.c_str());
+        auto j_globalStr = reinterpret_cast<jstring>(_env->NewGlobalRef(j_str));
+        _env->DeleteLocalRef(j_str);
+        _strings.emplace(str, j_globalStr);
+        return j_globalStr;
+    }
+    return it->second;
 }
 
 jclass JavaUtilArrayList::_cls = nullptr;
@@ -73,6 +65,7 @@ void JavaUtilArrayList::init(JNIEnv* env) {
     if (!_cls) {
         jclass localCls = env->FindClass("java/util/ArrayList");
         _cls = reinterpret_cast<jclass>(env->NewGlobalRef(localCls));
+        env->DeleteLocalRef(localCls);
         _constructor = env->GetMethodID(_cls, "<init>", "()V");
         _add = env->GetMethodID(_cls, "add", "(Ljava/lang/Object;)Z");
     }
@@ -85,14 +78,80 @@ JavaUtilArrayList::JavaUtilArrayList(JNIEnv* env)
 }
 
 void JavaUtilArrayList::add(jobject obj) {
-    _env->CallObjectMethod(_obj, _add, obj);
+    _env->CallBooleanMethod(_obj, _add, obj);
+}
+
+namespace {
+
+// boxing class and its valueOf method, looked up once
+class BoxingClass {
+public:
+    BoxingClass(const char* className, const char* valueOfSignature)
+        : _className(className),
+          _valueOfSignature(valueOfSignature) {
+    }
+
+    void init(JNIEnv* env) {
+        if (!_cls) {
+            jclass localCls = env->FindClass(_className);
+            _cls = reinterpret_cast<jclass>(env->NewGlobalRef(localCls));
+            env->DeleteLocalRef(localCls);
+            _valueOf = env->GetStaticMethodID(_cls, "valueOf", _valueOfSignature);
+        }
+    }
+
+    template<typename T>
+    jobject valueOf(JNIEnv* env, T value) const {
+        return env->CallStaticObjectMethod(_cls, _valueOf, value);
+    }
+
+private:
+    const char* _className;
+    const char* _valueOfSignature;
+    jclass _cls = nullptr;
+    jmethodID _valueOf = nullptr;
+};
+
+BoxingClass integerClass("java/lang/Integer", "(I)Ljava/lang/Integer;");
+BoxingClass longClass("java/lang/Long", "(J)Ljava/lang/Long;");
+BoxingClass doubleClass("java/lang/Double", "(D)Ljava/lang/Double;");
+
+// values boxed with the valueOf method of their class, for builders taking lists instead of primitive arrays
+template<typename T>
+jobject newBoxedList(JNIEnv* env, BoxingClass& boxingClass, const std::vector<T>& values) {
+    boxingClass.init(env);
+    JavaUtilArrayList list(env);
+    for (T value : values) {
+        jobject j_value = boxingClass.valueOf(env, value);
+        list.add(j_value);
+        env->DeleteLocalRef(j_value);
+    }
+    return list.obj();
+}
+
+jobject newIntList(JNIEnv* env, const std::vector<int>& values) {
+    return newBoxedList(env, integerClass, values);
+}
+
+jobject newLongList(JNIEnv* env, const std::vector<int64_t>& values) {
+    return newBoxedList<jlong>(env, longClass, std::vector<jlong>(values.begin(), values.end()));
+}
+
+jobject newDoubleList(JNIEnv* env, const std::vector<double>& values) {
+    return newBoxedList(env, doubleClass, values);
+}
+
 }
 
 jclass ComPowsyblPowerFactoryDbDataObjectBuilder::_cls = nullptr;
 jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_createClass = nullptr;
 jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_createAttribute = nullptr;
+jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_createSchema = nullptr;
 jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_createObject = nullptr;
+jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_createObjectWithParent = nullptr;
 jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_setObjectParent = nullptr;
+jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_updateObject = nullptr;
+jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_deleteObject = nullptr;
 jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_setStringAttributeValue = nullptr;
 jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_setIntAttributeValue = nullptr;
 jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_setLongAttributeValue = nullptr;
@@ -104,11 +163,31 @@ jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_setDoubleVectorAttributeVa
 jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_setStringVectorAttributeValue = nullptr;
 jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_setObjectVectorAttributeValue = nullptr;
 jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_setDoubleMatrixAttributeValue = nullptr;
+jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_beginAttributeValue = nullptr;
+jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_appendIntValues = nullptr;
+jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_appendLongValues = nullptr;
+jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_appendDoubleValues = nullptr;
+jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_endAttributeValue = nullptr;
+jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_appendDictionaryString = nullptr;
+jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_setStringCodeAttributeValue = nullptr;
+jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_setStringCodeVectorAttributeValue = nullptr;
+jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_createAttributeIndex = nullptr;
+jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::_flushBatch = nullptr;
+bool ComPowsyblPowerFactoryDbDataObjectBuilder::_boxedVectors = false;
+
+jmethodID ComPowsyblPowerFactoryDbDataObjectBuilder::getOptionalMethodId(JNIEnv* env, const char* name, const char* signature) {
+    jmethodID method = env->GetMethodID(_cls, name, signature);
+    if (!method) {
+        env->ExceptionClear();
+    }
+    return method;
+}
 
 void ComPowsyblPowerFactoryDbDataObjectBuilder::init(JNIEnv* env) {
     if (!_cls) {
         jclass localCls = env->FindClass("com/powsybl/powerfactory/db/DataObjectBuilder");
         _cls = reinterpret_cast<jclass>(env->NewGlobalRef(localCls));
+        env->DeleteLocalRef(localCls);
         _createClass = env->GetMethodID(_cls, "createClass", "(Ljava/lang/String;)V");
         _createAttribute = env->GetMethodID(_cls, "createAttribute", "(Ljava/lang/String;Ljava/lang/String;ILjava/lang/String;)V");
         _createObject = env->GetMethodID(_cls, "createObject", "(JLjava/lang/String;)V");
@@ -118,136 +197,546 @@ void ComPowsyblPowerFactoryDbDataObjectBuilder::init(JNIEnv* env) {
         _setLongAttributeValue = env->GetMethodID(_cls, "setLongAttributeValue", "(JLjava/lang/String;J)V");
         _setDoubleAttributeValue = env->GetMethodID(_cls, "setDoubleAttributeValue", "(JLjava/lang/String;D)V");
         _setObjectAttributeValue = env->GetMethodID(_cls, "setObjectAttributeValue", "(JLjava/lang/String;J)V");
-        _setIntVectorAttributeValue = env->GetMethodID(_cls, "setIntVectorAttributeValue", "(JLjava/lang/String;Ljava/util/List;)V");
-        _setLongVectorAttributeValue = env->GetMethodID(_cls, "setLongVectorAttributeValue", "(JLjava/lang/String;Ljava/util/List;)V");
-        _setDoubleVectorAttributeValue = env->GetMethodID(_cls, "setDoubleVectorAttributeValue", "(JLjava/lang/String;Ljava/util/List;)V");
         _setStringVectorAttributeValue = env->GetMethodID(_cls, "setStringVectorAttributeValue", "(JLjava/lang/String;Ljava/util/List;)V");
-        _setObjectVectorAttributeValue = env->GetMethodID(_cls, "setObjectVectorAttributeValue", "(JLjava/lang/String;Ljava/util/List;)V");
-        _setDoubleMatrixAttributeValue = env->GetMethodID(_cls, "setDoubleMatrixAttributeValue", "(JLjava/lang/String;IILjava/util/List;)V");
+        // builders of previous versions take numeric vectors and matrices as lists of boxed values
+        _setIntVectorAttributeValue = getOptionalMethodId(env, "setIntVectorAttributeValue", "(JLjava/lang/String;[I)V");
+        _boxedVectors = _setIntVectorAttributeValue == nullptr;
+        if (_boxedVectors) {
+            _setIntVectorAttributeValue = env->GetMethodID(_cls, "setIntVectorAttributeValue", "(JLjava/lang/String;Ljava/util/List;)V");
+            _setLongVectorAttributeValue = env->GetMethodID(_cls, "setLongVectorAttributeValue", "(JLjava/lang/String;Ljava/util/List;)V");
+            _setDoubleVectorAttributeValue = env->GetMethodID(_cls, "setDoubleVectorAttributeValue", "(JLjava/lang/String;Ljava/util/List;)V");
+            _setObjectVectorAttributeValue = env->GetMethodID(_cls, "setObjectVectorAttributeValue", "(JLjava/lang/String;Ljava/util/List;)V");
+            _setDoubleMatrixAttributeValue = env->GetMethodID(_cls, "setDoubleMatrixAttributeValue", "(JLjava/lang/String;IILjava/util/List;)V");
+        } else {
+            _setLongVectorAttributeValue = env->GetMethodID(_cls, "setLongVectorAttributeValue", "(JLjava/lang/String;[J)V");
+            _setDoubleVectorAttributeValue = env->GetMethodID(_cls, "setDoubleVectorAttributeValue", "(JLjava/lang/String;[D)V");
+            _setObjectVectorAttributeValue = env->GetMethodID(_cls, "setObjectVectorAttributeValue", "(JLjava/lang/String;[J)V");
+            _setDoubleMatrixAttributeValue = env->GetMethodID(_cls, "setDoubleMatrixAttributeValue", "(JLjava/lang/String;II[D)V");
+        }
+        _createObjectWithParent = getOptionalMethodId(env, "createObject", "(JLjava/lang/String;J)V");
+        _createSchema = getOptionalMethodId(env, "createSchema", "([Ljava/lang/String;[I[Ljava/lang/String;[I[Ljava/lang/String;)V");
+        _updateObject = getOptionalMethodId(env, "updateObject", "(J)V");
+        _deleteObject = getOptionalMethodId(env, "deleteObject", "(J)V");
+        _beginAttributeValue = getOptionalMethodId(env, "beginAttributeValue", "(JLjava/lang/String;III)V");
+        _appendIntValues = getOptionalMethodId(env, "appendIntValues", "([II)V");
+        _appendLongValues = getOptionalMethodId(env, "appendLongValues", "([JI)V");
+        _appendDoubleValues = getOptionalMethodId(env, "appendDoubleValues", "([DI)V");
+        _endAttributeValue = getOptionalMethodId(env, "endAttributeValue", "()V");
+        _appendDictionaryString = getOptionalMethodId(env, "appendDictionaryString", "(Ljava/lang/String;)V");
+        _setStringCodeAttributeValue = getOptionalMethodId(env, "setStringCodeAttributeValue", "(JLjava/lang/String;I)V");
+        _setStringCodeVectorAttributeValue = getOptionalMethodId(env, "setStringCodeVectorAttributeValue", "(JLjava/lang/String;[I)V");
+        _createAttributeIndex = getOptionalMethodId(env, "createAttributeIndex", "(ILjava/lang/String;)V");
+        _flushBatch = getOptionalMethodId(env, "flushBatch", "(IILjava/nio/ByteBuffer;Ljava/nio/ByteBuffer;Ljava/nio/ByteBuffer;)V");
     }
 }
 
+bool ComPowsyblPowerFactoryDbDataObjectBuilder::isChunkedValueSupported() const {
+    return _beginAttributeValue && _appendIntValues && _appendLongValues && _appendDoubleValues && _endAttributeValue;
+}
+
+bool ComPowsyblPowerFactoryDbDataObjectBuilder::isStringDictionarySupported() const {
+    return _appendDictionaryString && _setStringCodeAttributeValue && _setStringCodeVectorAttributeValue;
+}
+
+bool ComPowsyblPowerFactoryDbDataObjectBuilder::isBatchSupported() const {
+    return _createAttributeIndex && _flushBatch;
+}
+
+bool ComPowsyblPowerFactoryDbDataObjectBuilder::isDeltaSupported() const {
+    return _updateObject && _deleteObject;
+}
+
 ComPowsyblPowerFactoryDbDataObjectBuilder::ComPowsyblPowerFactoryDbDataObjectBuilder(JNIEnv *env, jobject obj)
-    : JniWrapper<jobject>(env, obj) {
+    : JniWrapper<jobject>(env, obj),
+      _names(env) {
     init(env);
 }
 
+ComPowsyblPowerFactoryDbDataObjectBuilder::~ComPowsyblPowerFactoryDbDataObjectBuilder() {
+    if (_intChunk) {
+        _env->DeleteGlobalRef(_intChunk);
+    }
+    if (_longChunk) {
+        _env->DeleteGlobalRef(_longChunk);
+    }
+    if (_doubleChunk) {
+        _env->DeleteGlobalRef(_doubleChunk);
+    }
+}
+
+void ComPowsyblPowerFactoryDbDataObjectBuilder::checkException() const {
+    if (_env->ExceptionCheck()) {
+        throw std::runtime_error("Object builder failed");
+    }
+}
+
 void ComPowsyblPowerFactoryDbDataObjectBuilder::createClass(const std::string& name) const {
-    jstring j_name = _env->NewStringUTF(name.c_str());
-    _env->CallObjectMethod(_obj, _createClass, j_name);
+    jstring j_name = _names.get(name);
+    _env->CallVoidMethod(_obj, _createClass, j_name);
+    checkException();
 }
 
 void ComPowsyblPowerFactoryDbDataObjectBuilder::createAttribute(const std::string& className, const std::string& attributeName, int type, const std::string& description) const {
-    jstring j_className = _env->NewStringUTF(className.c_str());
-    jstring j_attributeName = _env->NewStringUTF(attributeName.c_str());
+    jstring j_className = _names.get(className);
+    jstring j_attributeName = _names.get(attributeName);
     jstring j_description = _env->NewStringUTF(description.c_str());
-    _env->CallObjectMethod(_obj, _createAttribute, j_className, j_attributeName, (jint) type, j_description);
+    _env->CallVoidMethod(_obj, _createAttribute, j_className, j_attributeName, (jint) type, j_description);
+    _env->DeleteLocalRef(j_description);
+    checkException();
 }
 
-void ComPowsyblPowerFactoryDbDataObjectBuilder::createObject(long id, const std::string& className) const {
-    jstring j_className = _env->NewStringUTF(className.c_str());
-    _env->CallObjectMethod(_obj, _createObject, (jlong) id, j_className);
+jobjectArray ComPowsyblPowerFactoryDbDataObjectBuilder::newNameArray(const std::vector<std::string>& names) const {
+    jclass stringCls = _env->FindClass("java/lang/String");
+    jobjectArray array = _env->NewObjectArray((jsize) names.size(), stringCls, nullptr);
+    for (size_t i = 0; i < names.size(); i++) {
+        _env->SetObjectArrayElement(array, (jsize) i, _names.get(names[i]));
+    }
+    _env->DeleteLocalRef(stringCls);
+    return array;
+}
+
+void ComPowsyblPowerFactoryDbDataObjectBuilder::createSchema(const std::vector<std::string>& classNames, const std::vector<int>& attributeCounts,
+                                                             const std::vector<std::string>& attributeNames, const std::vector<int>& attributeTypes,
+                                                             const std::vector<std::string>& attributeDescriptions) const {
+    if (!_createSchema) {
+        size_t attributeIndex = 0;
+        for (size_t i = 0; i < classNames.size(); i++) {
+            createClass(classNames[i]);
+            for (int j = 0; j < attributeCounts[i]; j++, attributeIndex++) {
+                createAttribute(classNames[i], attributeNames[attributeIndex], attributeTypes[attributeIndex], attributeDescriptions[attributeIndex]);
+            }
+        }
+        return;
+    }
+    jobjectArray j_classNames = newNameArray(classNames);
+    jintArray j_attributeCounts = newIntArray(_env, attributeCounts);
+    jobjectArray j_attributeNames = newNameArray(attributeNames);
+    jintArray j_attributeTypes = newIntArray(_env, attributeTypes);
+    jclass stringCls = _env->FindClass("java/lang/String");
+    jobjectArray j_attributeDescriptions = _env->NewObjectArray((jsize) attributeDescriptions.size(), stringCls, nullptr);
+    for (size_t i = 0; i < attributeDescriptions.size(); i++) {
+        jstring j_description = _env->NewStringUTF(attributeDescriptions[i].c_str());
+        _env->SetObjectArrayElement(j_attributeDescriptions, (jsize) i, j_description);
+        _env->DeleteLocalRef(j_description);
+    }
+    _env->CallVoidMethod(_obj, _createSchema, j_classNames, j_attributeCounts, j_attributeNames, j_attributeTypes, j_attributeDescriptions);
+    _env->DeleteLocalRef(stringCls);
+    _env->DeleteLocalRef(j_classNames);
+    _env->DeleteLocalRef(j_attributeCounts);
+    _env->DeleteLocalRef(j_attributeNames);
+    _env->DeleteLocalRef(j_attributeTypes);
+    _env->DeleteLocalRef(j_attributeDescriptions);
+    checkException();
+}
+
+void ComPowsyblPowerFactoryDbDataObjectBuilder::createObject(long id, const std::string& className, long parentId) const {
+    jstring j_className = _names.get(className);
+    if (_createObjectWithParent) {
+        _env->CallVoidMethod(_obj, _createObjectWithParent, (jlong) id, j_className, (jlong) parentId);
+        checkException();
+    } else {
+        _env->CallVoidMethod(_obj, _createObject, (jlong) id, j_className);
+        checkException();
+        if (parentId != -1) {
+            setObjectParent(id, parentId);
+        }
+    }
 }
 
 void ComPowsyblPowerFactoryDbDataObjectBuilder::setObjectParent(long id, long parentId) const {
-    _env->CallObjectMethod(_obj, _setObjectParent, (jlong) id, (jlong) parentId);
+    _env->CallVoidMethod(_obj, _setObjectParent, (jlong) id, (jlong) parentId);
+    checkException();
+}
+
+void ComPowsyblPowerFactoryDbDataObjectBuilder::updateObject(long id) const {
+    _env->CallVoidMethod(_obj, _updateObject, (jlong) id);
+    checkException();
+}
+
+void ComPowsyblPowerFactoryDbDataObjectBuilder::deleteObject(long id) const {
+    _env->CallVoidMethod(_obj, _deleteObject, (jlong) id);
+    checkException();
 }
 
 void ComPowsyblPowerFactoryDbDataObjectBuilder::setStringAttributeValue(long objectId, const std::string &attributeName,
                                                                         const std::string& value) const {
-    jstring j_attributeName = _env->NewStringUTF(attributeName.c_str());
+    jstring j_attributeName = _names.get(attributeName);
     jstring j_value = _env->NewStringUTF(value.c_str());
-    _env->CallObjectMethod(_obj, _setStringAttributeValue, (jlong) objectId, j_attributeName, j_value);
+    _env->CallVoidMethod(_obj, _setStringAttributeValue, (jlong) objectId, j_attributeName, j_value);
+    _env->DeleteLocalRef(j_value);
+    checkException();
 }
 
 void ComPowsyblPowerFactoryDbDataObjectBuilder::setIntAttributeValue(long objectId, const std::string &attributeName, int value) const {
-    jstring j_attributeName = _env->NewStringUTF(attributeName.c_str());
-    _env->CallObjectMethod(_obj, _setIntAttributeValue, (jlong) objectId, j_attributeName, (jint) value);
+    jstring j_attributeName = _names.get(attributeName);
+    _env->CallVoidMethod(_obj, _setIntAttributeValue, (jlong) objectId, j_attributeName, (jint) value);
+    checkException();
 }
 
 void ComPowsyblPowerFactoryDbDataObjectBuilder::setLongAttributeValue(long objectId, const std::string &attributeName, long value) const {
-    jstring j_attributeName = _env->NewStringUTF(attributeName.c_str());
-    _env->CallObjectMethod(_obj, _setLongAttributeValue, (jlong) objectId, j_attributeName, (jlong) value);
+    jstring j_attributeName = _names.get(attributeName);
+    _env->CallVoidMethod(_obj, _setLongAttributeValue, (jlong) objectId, j_attributeName, (jlong) value);
+    checkException();
 }
 
 void ComPowsyblPowerFactoryDbDataObjectBuilder::setDoubleAttributeValue(long objectId, const std::string &attributeName, double value) const {
-    jstring j_attributeName = _env->NewStringUTF(attributeName.c_str());
-    _env->CallObjectMethod(_obj, _setDoubleAttributeValue, (jlong) objectId, j_attributeName, (jdouble) value);
+    jstring j_attributeName = _names.get(attributeName);
+    _env->CallVoidMethod(_obj, _setDoubleAttributeValue, (jlong) objectId, j_attributeName, (jdouble) value);
+    checkException();
 }
 
 void ComPowsyblPowerFactoryDbDataObjectBuilder::setObjectAttributeValue(long objectId, const std::string &attributeName, long otherObjectId) const {
-    jstring j_attributeName = _env->NewStringUTF(attributeName.c_str());
-    _env->CallObjectMethod(_obj, _setObjectAttributeValue, (jlong) objectId, j_attributeName, (jlong) otherObjectId);
+    jstring j_attributeName = _names.get(attributeName);
+    _env->CallVoidMethod(_obj, _setObjectAttributeValue, (jlong) objectId, j_attributeName, (jlong) otherObjectId);
+    checkException();
 }
 
 void ComPowsyblPowerFactoryDbDataObjectBuilder::setIntVectorAttributeValue(long objectId,
                                                                            const std::string& attributeName,
                                                                            const std::vector<int>& value) const {
-    jstring j_attributeName = _env->NewStringUTF(attributeName.c_str());
-    JavaUtilArrayList list(_env);
-    for (auto i : value) {
-        list.add(JavaLangInteger(_env, i).obj());
-    }
-    _env->CallObjectMethod(_obj, _setIntVectorAttributeValue, (jlong) objectId, j_attributeName, list.obj());
+    jstring j_attributeName = _names.get(attributeName);
+    jobject j_value = _boxedVectors ? newIntList(_env, value) : newIntArray(_env, value);
+    _env->CallVoidMethod(_obj, _setIntVectorAttributeValue, (jlong) objectId, j_attributeName, j_value);
+    _env->DeleteLocalRef(j_value);
+    checkException();
 }
 
 void ComPowsyblPowerFactoryDbDataObjectBuilder::setLongVectorAttributeValue(long objectId,
                                                                             const std::string& attributeName,
-                                                                            const std::vector<long>& value) const {
-    jstring j_attributeName = _env->NewStringUTF(attributeName.c_str());
-    JavaUtilArrayList list(_env);
-    for (auto l : value) {
-        list.add(JavaLangLong(_env, l).obj());
-    }
-    _env->CallObjectMethod(_obj, _setLongVectorAttributeValue, (jlong) objectId, j_attributeName, list.obj());
+                                                                            const std::vector<int64_t>& value) const {
+    jstring j_attributeName = _names.get(attributeName);
+    jobject j_value = _boxedVectors ? newLongList(_env, value) : newLongArray(_env, value);
+    _env->CallVoidMethod(_obj, _setLongVectorAttributeValue, (jlong) objectId, j_attributeName, j_value);
+    _env->DeleteLocalRef(j_value);
+    checkException();
 }
 
 void ComPowsyblPowerFactoryDbDataObjectBuilder::setDoubleVectorAttributeValue(long objectId,
                                                                               const std::string& attributeName,
                                                                               const std::vector<double>& value) const {
-    jstring j_attributeName = _env->NewStringUTF(attributeName.c_str());
-    JavaUtilArrayList list(_env);
-    for (auto d : value) {
-        list.add(JavaLangDouble(_env, d).obj());
-    }
-    _env->CallObjectMethod(_obj, _setDoubleVectorAttributeValue, (jlong) objectId, j_attributeName, list.obj());
+    jstring j_attributeName = _names.get(attributeName);
+    jobject j_value = _boxedVectors ? newDoubleList(_env, value) : newDoubleArray(_env, value);
+    _env->CallVoidMethod(_obj, _setDoubleVectorAttributeValue, (jlong) objectId, j_attributeName, j_value);
+    _env->DeleteLocalRef(j_value);
+    checkException();
 }
 
 void ComPowsyblPowerFactoryDbDataObjectBuilder::setStringVectorAttributeValue(long objectId,
                                                                               const std::string& attributeName,
                                                                               const std::vector<std::string>& value) const {
-    jstring j_attributeName = _env->NewStringUTF(attributeName.c_str());
+    jstring j_attributeName = _names.get(attributeName);
     JavaUtilArrayList list(_env);
-    for (auto str : value) {
-        list.add(_env->NewStringUTF(str.c_str()));
+    for (const auto& str : value) {
+        jstring j_str = _env->NewStringUTF(str.c_str());
+        list.add(j_str);
+        _env->DeleteLocalRef(j_str);
     }
-    _env->CallObjectMethod(_obj, _setStringVectorAttributeValue, (jlong) objectId, j_attributeName, list.obj());
+    _env->CallVoidMethod(_obj, _setStringVectorAttributeValue, (jlong) objectId, j_attributeName, list.obj());
+    _env->DeleteLocalRef(list.obj());
+    checkException();
 }
 
 void ComPowsyblPowerFactoryDbDataObjectBuilder::setObjectVectorAttributeValue(long objectId,
                                                                               const std::string& attributeName,
-                                                                              const std::vector<long>& otherObjectsIds) const {
-    jstring j_attributeName = _env->NewStringUTF(attributeName.c_str());
-    JavaUtilArrayList list(_env);
-    for (auto otherObjectId : otherObjectsIds) {
-        list.add(JavaLangLong(_env, otherObjectId).obj());
-    }
-    _env->CallObjectMethod(_obj, _setObjectVectorAttributeValue, (jlong) objectId, j_attributeName, list.obj());
+                                                                              const std::vector<int64_t>& otherObjectsIds) const {
+    jstring j_attributeName = _names.get(attributeName);
+    jobject j_otherObjectsIds = _boxedVectors ? newLongList(_env, otherObjectsIds) : newLongArray(_env, otherObjectsIds);
+    _env->CallVoidMethod(_obj, _setObjectVectorAttributeValue, (jlong) objectId, j_attributeName, j_otherObjectsIds);
+    _env->DeleteLocalRef(j_otherObjectsIds);
+    checkException();
 }
 
 void ComPowsyblPowerFactoryDbDataObjectBuilder::setDoubleMatrixAttributeValue(long objectId,
                                                                               const std::string &attributeName,
                                                                               int rowCount, int columnCount,
                                                                               const std::vector<double> &value) const {
-    jstring j_attributeName = _env->NewStringUTF(attributeName.c_str());
-    JavaUtilArrayList list(_env);
-    for (auto d : value) {
-        list.add(JavaLangDouble(_env, d).obj());
+    jstring j_attributeName = _names.get(attributeName);
+    jobject j_value = _boxedVectors ? newDoubleList(_env, value) : newDoubleArray(_env, value);
+    _env->CallVoidMethod(_obj, _setDoubleMatrixAttributeValue, (jlong) objectId, j_attributeName, (jint) rowCount, (jint) columnCount, j_value);
+    _env->DeleteLocalRef(j_value);
+    checkException();
+}
+
+void ComPowsyblPowerFactoryDbDataObjectBuilder::beginAttributeValue(long objectId, const std::string& attributeName, int type,
+                                                                    int rowCount, int columnCount) const {
+    jstring j_attributeName = _names.get(attributeName);
+    _env->CallVoidMethod(_obj, _beginAttributeValue, (jlong) objectId, j_attributeName, (jint) type, (jint) rowCount, (jint) columnCount);
+    checkException();
+}
+
+void ComPowsyblPowerFactoryDbDataObjectBuilder::appendIntValues(const int* values, size_t count) const {
+    if (!_intChunk || (size_t) _env->GetArrayLength(_intChunk) < count) {
+        if (_intChunk) {
+            _env->DeleteGlobalRef(_intChunk);
+        }
+        jintArray localChunk = _env->NewIntArray((jsize) count);
+        _intChunk = reinterpret_cast<jintArray>(_env->NewGlobalRef(localChunk));
+        _env->DeleteLocalRef(localChunk);
+    }
+    _env->SetIntArrayRegion(_intChunk, 0, (jsize) count, reinterpret_cast<const jint*>(values));
+    _env->CallVoidMethod(_obj, _appendIntValues, _intChunk, (jint) count);
+    checkException();
+}
+
+void ComPowsyblPowerFactoryDbDataObjectBuilder::appendLongValues(const int64_t* values, size_t count) const {
+    if (!_longChunk || (size_t) _env->GetArrayLength(_longChunk) < count) {
+        if (_longChunk) {
+            _env->DeleteGlobalRef(_longChunk);
+        }
+        jlongArray localChunk = _env->NewLongArray((jsize) count);
+        _longChunk = reinterpret_cast<jlongArray>(_env->NewGlobalRef(localChunk));
+        _env->DeleteLocalRef(localChunk);
+    }
+    _env->SetLongArrayRegion(_longChunk, 0, (jsize) count, reinterpret_cast<const jlong*>(values));
+    _env->CallVoidMethod(_obj, _appendLongValues, _longChunk, (jint) count);
+    checkException();
+}
+
+void ComPowsyblPowerFactoryDbDataObjectBuilder::appendDoubleValues(const double* values, size_t count) const {
+    if (!_doubleChunk || (size_t) _env->GetArrayLength(_doubleChunk) < count) {
+        if (_doubleChunk) {
+            _env->DeleteGlobalRef(_doubleChunk);
+        }
+        jdoubleArray localChunk = _env->NewDoubleArray((jsize) count);
+        _doubleChunk = reinterpret_cast<jdoubleArray>(_env->NewGlobalRef(localChunk));
+        _env->DeleteLocalRef(localChunk);
+    }
+    _env->SetDoubleArrayRegion(_doubleChunk, 0, (jsize) count, values);
+    _env->CallVoidMethod(_obj, _appendDoubleValues, _doubleChunk, (jint) count);
+    checkException();
+}
+
+void ComPowsyblPowerFactoryDbDataObjectBuilder::endAttributeValue() const {
+    _env->CallVoidMethod(_obj, _endAttributeValue);
+    checkException();
+}
+
+void ComPowsyblPowerFactoryDbDataObjectBuilder::appendDictionaryString(const std::string& value) const {
+    jstring j_value = _env->NewStringUTF(value.c_str());
+    _env->CallVoidMethod(_obj, _appendDictionaryString, j_value);
+    _env->DeleteLocalRef(j_value);
+    checkException();
+}
+
+void ComPowsyblPowerFactoryDbDataObjectBuilder::setStringCodeAttributeValue(long objectId, const std::string& attributeName, int code) const {
+    jstring j_attributeName = _names.get(attributeName);
+    _env->CallVoidMethod(_obj, _setStringCodeAttributeValue, (jlong) objectId, j_attributeName, (jint) code);
+    checkException();
+}
+
+void ComPowsyblPowerFactoryDbDataObjectBuilder::setStringCodeVectorAttributeValue(long objectId, const std::string& attributeName,
+                                                                                  const std::vector<int>& codes) const {
+    jstring j_attributeName = _names.get(attributeName);
+    jintArray j_codes = newIntArray(_env, codes);
+    _env->CallVoidMethod(_obj, _setStringCodeVectorAttributeValue, (jlong) objectId, j_attributeName, j_codes);
+    _env->DeleteLocalRef(j_codes);
+    checkException();
+}
+
+void ComPowsyblPowerFactoryDbDataObjectBuilder::createAttributeIndex(int attributeIndex, const std::string& attributeName) const {
+    jstring j_attributeName = _names.get(attributeName);
+    _env->CallVoidMethod(_obj, _createAttributeIndex, (jint) attributeIndex, j_attributeName);
+    checkException();
+}
+
+void ComPowsyblPowerFactoryDbDataObjectBuilder::flushBatch(int type, int count, const int64_t* objectIds, const int32_t* attributeIndexes,
+                                                           const void* values, size_t valueSize) const {
+    jobject j_objectIds = _env->NewDirectByteBuffer(const_cast<int64_t*>(objectIds), (jlong) (count * sizeof(int64_t)));
+    jobject j_attributeIndexes = _env->NewDirectByteBuffer(const_cast<int32_t*>(attributeIndexes), (jlong) (count * sizeof(int32_t)));
+    jobject j_values = _env->NewDirectByteBuffer(const_cast<void*>(values), (jlong) (count * valueSize));
+    _env->CallVoidMethod(_obj, _flushBatch, (jint) type, (jint) count, j_objectIds, j_attributeIndexes, j_values);
+    _env->DeleteLocalRef(j_objectIds);
+    _env->DeleteLocalRef(j_attributeIndexes);
+    _env->DeleteLocalRef(j_values);
+    checkException();
+}
+
+jclass ComPowsyblPowerFactoryDbReadOptions::_cls = nullptr;
+jmethodID ComPowsyblPowerFactoryDbReadOptions::_getBatchSize = nullptr;
+jmethodID ComPowsyblPowerFactoryDbReadOptions::_getPipelineCapacity = nullptr;
+jmethodID ComPowsyblPowerFactoryDbReadOptions::_getChunkSize = nullptr;
+jmethodID ComPowsyblPowerFactoryDbReadOptions::_isBreadthFirst = nullptr;
+jmethodID ComPowsyblPowerFactoryDbReadOptions::_isSchemaFirst = nullptr;
+jmethodID ComPowsyblPowerFactoryDbReadOptions::_isStringDictionary = nullptr;
+jmethodID ComPowsyblPowerFactoryDbReadOptions::_isReadReferences = nullptr;
+jmethodID ComPowsyblPowerFactoryDbReadOptions::_getMaxReferenceDepth = nullptr;
+jmethodID ComPowsyblPowerFactoryDbReadOptions::_getCacheDir = nullptr;
+jmethodID ComPowsyblPowerFactoryDbReadOptions::_getClassNames = nullptr;
+jmethodID ComPowsyblPowerFactoryDbReadOptions::_getAttributeClassNames = nullptr;
+jmethodID ComPowsyblPowerFactoryDbReadOptions::_getAttributeNames = nullptr;
+jmethodID ComPowsyblPowerFactoryDbReadOptions::_getExcludedSubtreePatterns = nullptr;
+jmethodID ComPowsyblPowerFactoryDbReadOptions::_getStats = nullptr;
+jmethodID ComPowsyblPowerFactoryDbReadOptions::_getTraceFile = nullptr;
+
+void ComPowsyblPowerFactoryDbReadOptions::init(JNIEnv* env) {
+    if (!_cls) {
+        jclass localCls = env->FindClass("com/powsybl/powerfactory/db/ReadOptions");
+        _cls = reinterpret_cast<jclass>(env->NewGlobalRef(localCls));
+        env->DeleteLocalRef(localCls);
+        _getBatchSize = env->GetMethodID(_cls, "getBatchSize", "()I");
+        _getPipelineCapacity = env->GetMethodID(_cls, "getPipelineCapacity", "()I");
+        _getChunkSize = env->GetMethodID(_cls, "getChunkSize", "()I");
+        _isBreadthFirst = env->GetMethodID(_cls, "isBreadthFirst", "()Z");
+        _isSchemaFirst = env->GetMethodID(_cls, "isSchemaFirst", "()Z");
+        _isStringDictionary = env->GetMethodID(_cls, "isStringDictionary", "()Z");
+        _isReadReferences = env->GetMethodID(_cls, "isReadReferences", "()Z");
+        _getMaxReferenceDepth = env->GetMethodID(_cls, "getMaxReferenceDepth", "()I");
+        _getCacheDir = env->GetMethodID(_cls, "getCacheDir", "()Ljava/lang/String;");
+        _getClassNames = env->GetMethodID(_cls, "getClassNames", "()[Ljava/lang/String;");
+        _getAttributeClassNames = env->GetMethodID(_cls, "getAttributeClassNames", "()[Ljava/lang/String;");
+        _getAttributeNames = env->GetMethodID(_cls, "getAttributeNames", "(Ljava/lang/String;)[Ljava/lang/String;");
+        _getExcludedSubtreePatterns = env->GetMethodID(_cls, "getExcludedSubtreePatterns", "()[Ljava/lang/String;");
+        _getStats = env->GetMethodID(_cls, "getStats", "()Lcom/powsybl/powerfactory/db/ReadStats;");
+        _getTraceFile = env->GetMethodID(_cls, "getTraceFile", "()Ljava/lang/String;");
+    }
+}
+
+ComPowsyblPowerFactoryDbReadOptions::ComPowsyblPowerFactoryDbReadOptions(JNIEnv* env, jobject obj)
+    : JniWrapper<jobject>(env, obj) {
+    init(env);
+}
+
+int ComPowsyblPowerFactoryDbReadOptions::getBatchSize() const {
+    return _env->CallIntMethod(_obj, _getBatchSize);
+}
+
+int ComPowsyblPowerFactoryDbReadOptions::getPipelineCapacity() const {
+    return _env->CallIntMethod(_obj, _getPipelineCapacity);
+}
+
+int ComPowsyblPowerFactoryDbReadOptions::getChunkSize() const {
+    return _env->CallIntMethod(_obj, _getChunkSize);
+}
+
+bool ComPowsyblPowerFactoryDbReadOptions::isBreadthFirst() const {
+    return _env->CallBooleanMethod(_obj, _isBreadthFirst);
+}
+
+bool ComPowsyblPowerFactoryDbReadOptions::isSchemaFirst() const {
+    return _env->CallBooleanMethod(_obj, _isSchemaFirst);
+}
+
+bool ComPowsyblPowerFactoryDbReadOptions::isStringDictionary() const {
+    return _env->CallBooleanMethod(_obj, _isStringDictionary);
+}
+
+bool ComPowsyblPowerFactoryDbReadOptions::isReadReferences() const {
+    return _env->CallBooleanMethod(_obj, _isReadReferences);
+}
+
+int ComPowsyblPowerFactoryDbReadOptions::getMaxReferenceDepth() const {
+    return _env->CallIntMethod(_obj, _getMaxReferenceDepth);
+}
+
+std::string ComPowsyblPowerFactoryDbReadOptions::getCacheDir() const {
+    auto j_cacheDir = reinterpret_cast<jstring>(_env->CallObjectMethod(_obj, _getCacheDir));
+    if (!j_cacheDir) {
+        return "";
     }
-    _env->CallObjectMethod(_obj, _setDoubleMatrixAttributeValue, (jlong) objectId, j_attributeName, rowCount, columnCount, list.obj());
+    std::string cacheDir = StringUTF(_env, j_cacheDir).toStr();
+    _env->DeleteLocalRef(j_cacheDir);
+    return cacheDir;
+}
+
+std::vector<std::string> ComPowsyblPowerFactoryDbReadOptions::getClassNames() const {
+    return toStringVector(_env, reinterpret_cast<jobjectArray>(_env->CallObjectMethod(_obj, _getClassNames)));
+}
+
+std::vector<std::string> ComPowsyblPowerFactoryDbReadOptions::getAttributeClassNames() const {
+    return toStringVector(_env, reinterpret_cast<jobjectArray>(_env->CallObjectMethod(_obj, _getAttributeClassNames)));
+}
+
+std::vector<std::string> ComPowsyblPowerFactoryDbReadOptions::getAttributeNames(const std::string& className) const {
+    jstring j_className = _env->NewStringUTF(className.c_str());
+    auto j_attributeNames = reinterpret_cast<jobjectArray>(_env->CallObjectMethod(_obj, _getAttributeNames, j_className));
+    _env->DeleteLocalRef(j_className);
+    return toStringVector(_env, j_attributeNames);
+}
+
+std::vector<std::string> ComPowsyblPowerFactoryDbReadOptions::getExcludedSubtreePatterns() const {
+    return toStringVector(_env, reinterpret_cast<jobjectArray>(_env->CallObjectMethod(_obj, _getExcludedSubtreePatterns)));
+}
+
+jobject ComPowsyblPowerFactoryDbReadOptions::getStats() const {
+    return _env->CallObjectMethod(_obj, _getStats);
+}
+
+std::string ComPowsyblPowerFactoryDbReadOptions::getTraceFile() const {
+    auto j_traceFile = reinterpret_cast<jstring>(_env->CallObjectMethod(_obj, _getTraceFile));
+    if (!j_traceFile) {
+        return "";
+    }
+    std::string traceFile = StringUTF(_env, j_traceFile).toStr();
+    _env->DeleteLocalRef(j_traceFile);
+    return traceFile;
+}
+
+jclass ComPowsyblPowerFactoryDbReadStats::_cls = nullptr;
+jmethodID ComPowsyblPowerFactoryDbReadStats::_addCounter = nullptr;
+
+void ComPowsyblPowerFactoryDbReadStats::init(JNIEnv* env) {
+    if (!_cls) {
+        jclass localCls = env->FindClass("com/powsybl/powerfactory/db/ReadStats");
+        _cls = reinterpret_cast<jclass>(env->NewGlobalRef(localCls));
+        env->DeleteLocalRef(localCls);
+        _addCounter = env->GetMethodID(_cls, "addCounter", "(Ljava/lang/String;Ljava/lang/String;JJ)V");
+    }
+}
+
+ComPowsyblPowerFactoryDbReadStats::ComPowsyblPowerFactoryDbReadStats(JNIEnv* env, jobject obj)
+    : JniWrapper<jobject>(env, obj) {
+    init(env);
+}
+
+void ComPowsyblPowerFactoryDbReadStats::addCounter(const std::string& category, const std::string& name, int64_t count, int64_t nanos) const {
+    jstring j_category = _env->NewStringUTF(category.c_str());
+    jstring j_name = _env->NewStringUTF(name.c_str());
+    _env->CallVoidMethod(_obj, _addCounter, j_category, j_name, (jlong) count, (jlong) nanos);
+    _env->DeleteLocalRef(j_category);
+    _env->DeleteLocalRef(j_name);
+}
+
+jclass ComPowsyblPowerFactoryDbReadProgressListener::_cls = nullptr;
+jmethodID ComPowsyblPowerFactoryDbReadProgressListener::_onProgress = nullptr;
+
+void ComPowsyblPowerFactoryDbReadProgressListener::init(JNIEnv* env) {
+    if (!_cls) {
+        jclass localCls = env->FindClass("com/powsybl/powerfactory/db/ReadProgressListener");
+        _cls = reinterpret_cast<jclass>(env->NewGlobalRef(localCls));
+        env->DeleteLocalRef(localCls);
+        _onProgress = env->GetMethodID(_cls, "onProgress", "(JJJ)V");
+    }
+}
+
+ComPowsyblPowerFactoryDbReadProgressListener::ComPowsyblPowerFactoryDbReadProgressListener(JNIEnv* env, jobject obj)
+    : JniWrapper<jobject>(env, obj) {
+    init(env);
+}
+
+void ComPowsyblPowerFactoryDbReadProgressListener::onProgress(int64_t objectCount, int64_t attributeCount, int64_t pendingCount) const {
+    _env->CallVoidMethod(_obj, _onProgress, (jlong) objectCount, (jlong) attributeCount, (jlong) pendingCount);
+}
+
+std::vector<std::string> toStringVector(JNIEnv* env, jobjectArray array) {
+    std::vector<std::string> strings;
+    if (array) {
+        jsize length = env->GetArrayLength(array);
+        strings.reserve(length);
+        for (jsize i = 0; i < length; i++) {
+            auto j_str = reinterpret_cast<jstring>(env->GetObjectArrayElement(array, i));
+            strings.push_back(StringUTF(env, j_str).toStr());
+            env->DeleteLocalRef(j_str);
+        }
+        env->DeleteLocalRef(array);
+    }
+    return strings;
 }
 
 void throwPowsyblException(JNIEnv* env, const char* msg) {
+    // an exception of a Java callback is more telling than the native error it caused
+    if (env->ExceptionCheck()) {
+        return;
+    }
     jclass clazz = env->FindClass("com/powsybl/commons/PowsyblException");
     env->ThrowNew(clazz, msg);
 }
@@ -11,7 +11,9 @@
 #ifndef JNIWRAPPER_HPP
 #define JNIWRAPPER_HPP
 
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <jni.h>
 
@@ -81,37 +83,26 @@ private:
     mutable const char* _ptr;
 };
 
-class JavaLangInteger : public JniWrapper<jobject> {
-public:
-    JavaLangInteger(JNIEnv* env, int i);
-
-    static void init(JNIEnv* env);
-
-private:
-    static jclass _cls;
-    static jmethodID _constructor;
-};
-
-class JavaLangLong : public JniWrapper<jobject> {
+/**
+ * Global reference Java strings, one per distinct native string, so that class and attribute names
+ * are only converted once and can be compared by identity on Java side.
+ */
+class JavaStringInternTable {
 public:
-    JavaLangLong(JNIEnv* env, long l);
+    explicit JavaStringInternTable(JNIEnv* env)
+        : _env(env) {
+    }
 
-    static void init(JNIEnv* env);
+    ~JavaStringInternTable();
 
-private:
-    static jclass _cls;
-    static jmethodID _constructor;
-};
+    JavaStringInternTable(const JavaStringInternTable&) = delete;
+    JavaStringInternTable& operator=(const JavaStringInternTable&) = delete;
 
-class JavaLangDouble : public JniWrapper<jobject> {
-public:
-    JavaLangDouble(JNIEnv* env, double d);
-
-    static void init(JNIEnv* env);
+    jstring get(const std::string& str);
 
 private:
-    static jclass _cls;
-    static jmethodID _constructor;
+    JNIEnv* _env;
+    std::unordered_map<std::string, jstring> _strings;
 };
 
 class JavaUtilArrayList : public JniWrapper<jobject> {
@@ -132,16 +123,38 @@ class ComPowsyblPowerFactoryDbDataObjectBuilder : public JniWrapper<jobject> {
 public:
     ComPowsyblPowerFactoryDbDataObjectBuilder(JNIEnv* env, jobject obj);
 
+    ~ComPowsyblPowerFactoryDbDataObjectBuilder() override;
+
     static void init(JNIEnv* env);
 
+    // builders of previous versions miss these methods, values are then sent one by one
+    bool isChunkedValueSupported() const;
+
+    bool isStringDictionarySupported() const;
+
+    bool isBatchSupported() const;
+
+    bool isDeltaSupported() const;
+
     void createClass(const std::string& name) const;
 
     void createAttribute(const std::string& className, const std::string& attributeName, int type, const std::string& description) const;
 
-    void createObject(long id, const std::string& className) const;
+    // attributes of all classes are flattened, attributeCounts giving the number of attributes of each class, sent
+    // class by class to builders without createSchema
+    void createSchema(const std::vector<std::string>& classNames, const std::vector<int>& attributeCounts,
+                      const std::vector<std::string>& attributeNames, const std::vector<int>& attributeTypes,
+                      const std::vector<std::string>& attributeDescriptions) const;
+
+    // parent set with a second upcall if the builder does not take it with the object
+    void createObject(long id, const std::string& className, long parentId) const;
 
     void setObjectParent(long id, long parentId) const;
 
+    void updateObject(long id) const;
+
+    void deleteObject(long id) const;
+
     void setStringAttributeValue(long objectId, const std::string& attributeName, const std::string& value) const;
 
     void setIntAttributeValue(long objectId, const std::string& attributeName, int value) const;
@@ -154,22 +167,65 @@ public:
 
     void setIntVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int>& value) const;
 
-    void setLongVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<long>& value) const;
+    void setLongVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& value) const;
 
     void setDoubleVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<double>& value) const;
 
     void setStringVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<std::string>& value) const;
 
-    void setObjectVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<long>& otherObjectsIds) const;
+    void setObjectVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& otherObjectsIds) const;
 
     void setDoubleMatrixAttributeValue(long objectId, const std::string& attributeName, int rowCount, int columnCount, const std::vector<double>& value) const;
 
+    void beginAttributeValue(long objectId, const std::string& attributeName, int type, int rowCount, int columnCount) const;
+
+    // chunk arrays are reused from one call to the next, only count values are valid
+    void appendIntValues(const int* values, size_t count) const;
+
+    void appendLongValues(const int64_t* values, size_t count) const;
+
+    void appendDoubleValues(const double* values, size_t count) const;
+
+    void endAttributeValue() const;
+
+    // next string of the dictionary, its code being its position
+    void appendDictionaryString(const std::string& value) const;
+
+    void setStringCodeAttributeValue(long objectId, const std::string& attributeName, int code) const;
+
+    void setStringCodeVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int>& codes) const;
+
+    void createAttributeIndex(int attributeIndex, const std::string& attributeName) const;
+
+    // columns are wrapped in native ordered direct byte buffers only valid during the upcall
+    void flushBatch(int type, int count, const int64_t* objectIds, const int32_t* attributeIndexes, const void* values, size_t valueSize) const;
+
 private:
+    // null, without any pending NoSuchMethodError, if the builder does not have the method
+    static jmethodID getOptionalMethodId(JNIEnv* env, const char* name, const char* signature);
+
+    // a Java exception of the builder aborts the read, and is left pending to be rethrown to the caller
+    void checkException() const;
+
+    jobjectArray newNameArray(const std::vector<std::string>& names) const;
+
+    // class and attribute names interned for the whole read
+    mutable JavaStringInternTable _names;
+
+    // global references, grown on demand
+    mutable jintArray _intChunk = nullptr;
+    mutable jlongArray _longChunk = nullptr;
+    mutable jdoubleArray _doubleChunk = nullptr;
+
     static jclass _cls;
     static jmethodID _createClass;
     static jmethodID _createAttribute;
+    static jmethodID _createSchema;
     static jmethodID _createObject;
+    static jmethodID _createObjectWithParent;
     static jmethodID _setObjectParent;
+    static jmethodID _updateObject;
+    static jmethodID _deleteObject;
     static jmethodID _setStringAttributeValue;
     static jmethodID _setIntAttributeValue;
     static jmethodID _setLongAttributeValue;
@@ -181,8 +237,107 @@ private:
     static jmethodID _setStringVectorAttributeValue;
     static jmethodID _setObjectVectorAttributeValue;
     static jmethodID _setDoubleMatrixAttributeValue;
+    static jmethodID _beginAttributeValue;
+    static jmethodID _appendIntValues;
+    static jmethodID _appendLongValues;
+    static jmethodID _appendDoubleValues;
+    static jmethodID _endAttributeValue;
+    static jmethodID _appendDictionaryString;
+    static jmethodID _setStringCodeAttributeValue;
+    static jmethodID _setStringCodeVectorAttributeValue;
+    static jmethodID _createAttributeIndex;
+    static jmethodID _flushBatch;
+
+    // numeric vectors and matrices passed as lists of boxed values instead of primitive arrays
+    static bool _boxedVectors;
+};
+
+class ComPowsyblPowerFactoryDbReadOptions : public JniWrapper<jobject> {
+public:
+    ComPowsyblPowerFactoryDbReadOptions(JNIEnv* env, jobject obj);
+
+    static void init(JNIEnv* env);
+
+    int getBatchSize() const;
+
+    int getPipelineCapacity() const;
+
+    int getChunkSize() const;
+
+    bool isBreadthFirst() const;
+
+    bool isSchemaFirst() const;
+
+    bool isStringDictionary() const;
+
+    bool isReadReferences() const;
+
+    int getMaxReferenceDepth() const;
+
+    // empty if not set
+    std::string getCacheDir() const;
+
+    std::vector<std::string> getClassNames() const;
+
+    std::vector<std::string> getAttributeClassNames() const;
+
+    std::vector<std::string> getAttributeNames(const std::string& className) const;
+
+    std::vector<std::string> getExcludedSubtreePatterns() const;
+
+    // null if statistics are not requested
+    jobject getStats() const;
+
+    // empty if not set
+    std::string getTraceFile() const;
+
+private:
+    static jclass _cls;
+    static jmethodID _getBatchSize;
+    static jmethodID _getPipelineCapacity;
+    static jmethodID _getChunkSize;
+    static jmethodID _isBreadthFirst;
+    static jmethodID _isSchemaFirst;
+    static jmethodID _isStringDictionary;
+    static jmethodID _isReadReferences;
+    static jmethodID _getMaxReferenceDepth;
+    static jmethodID _getCacheDir;
+    static jmethodID _getClassNames;
+    static jmethodID _getAttributeClassNames;
+    static jmethodID _getAttributeNames;
+    static jmethodID _getExcludedSubtreePatterns;
+    static jmethodID _getStats;
+    static jmethodID _getTraceFile;
+};
+
+class ComPowsyblPowerFactoryDbReadStats : public JniWrapper<jobject> {
+public:
+    ComPowsyblPowerFactoryDbReadStats(JNIEnv* env, jobject obj);
+
+    static void init(JNIEnv* env);
+
+    void addCounter(const std::string& category, const std::string& name, int64_t count, int64_t nanos) const;
+
+private:
+    static jclass _cls;
+    static jmethodID _addCounter;
 };
 
+class ComPowsyblPowerFactoryDbReadProgressListener : public JniWrapper<jobject> {
+public:
+    ComPowsyblPowerFactoryDbReadProgressListener(JNIEnv* env, jobject obj);
+
+    static void init(JNIEnv* env);
+
+    void onProgress(int64_t objectCount, int64_t attributeCount, int64_t pendingCount) const;
+
+private:
+    static jclass _cls;
+    static jmethodID _onProgress;
+};
+
+std::vector<std::string> toStringVector(JNIEnv* env, jobjectArray array);
+
 void throwPowsyblException(JNIEnv* env, const char* msg);
 
 }  // namespace jni
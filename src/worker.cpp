@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file worker.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#ifdef _WIN32
+#include <Windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+#include "Api.h"
+#include "ArrowWriter.h"
+#include "ClassSchema.h"
+#include "ParallelRead.h"
+#include "ProjectReader.h"
+
+namespace pf = powsybl::powerfactory;
+
+namespace {
+
+// only counts what it receives, so that a benchmark measures the PowerFactory API side of a read
+class CountingDataObjectHandler : public pf::DataObjectHandler {
+public:
+    void createClass(const std::string&) override { _calls++; }
+
+    void createAttribute(const std::string&, const std::string&, int, const std::string&) override { _calls++; }
+
+    void createObject(long, const std::string&, long) override { _calls++; _objects++; }
+
+    void setObjectParent(long, long) override { _calls++; }
+
+    void setStringAttributeValue(long, const std::string&, const std::string&) override { countValue(); }
+
+    void setIntAttributeValue(long, const std::string&, int) override { countValue(); }
+
+    void setLongAttributeValue(long, const std::string&, long) override { countValue(); }
+
+    void setDoubleAttributeValue(long, const std::string&, double) override { countValue(); }
+
+    void setObjectAttributeValue(long, const std::string&, long) override { countValue(); }
+
+    void setIntVectorAttributeValue(long, const std::string&, const std::vector<int>&) override { countValue(); }
+
+    void setLongVectorAttributeValue(long, const std::string&, const std::vector<int64_t>&) override { countValue(); }
+
+    void setDoubleVectorAttributeValue(long, const std::string&, const std::vector<double>&) override { countValue(); }
+
+    void setStringVectorAttributeValue(long, const std::string&, const std::vector<std::string>&) override { countValue(); }
+
+    void setObjectVectorAttributeValue(long, const std::string&, const std::vector<int64_t>&) override { countValue(); }
+
+    void setDoubleMatrixAttributeValue(long, const std::string&, int, int, const std::vector<double>&) override { countValue(); }
+
+    size_t _calls = 0;
+    size_t _objects = 0;
+    size_t _values = 0;
+
+private:
+    void countValue() {
+        _calls++;
+        _values++;
+    }
+};
+
+// in kilobytes
+size_t getPeakResidentSetSize() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.PeakWorkingSetSize / 1024;
+#else
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (size_t) usage.ru_maxrss;
+#endif
+}
+
+// reads the project to a handler that does nothing, and reports read throughput. Handler calls are not JNI upcalls,
+// batching and pipelining are not part of this measure.
+int benchmark(const std::string& powerFactoryHomeDir, const std::string& projectName) {
+    pf::Api api(powerFactoryHomeDir);
+    auto project = api.activateProject(projectName);
+
+    pf::SchemaCache schemaCache;
+    CountingDataObjectHandler handler;
+    auto start = std::chrono::steady_clock::now();
+    pf::readProject(api, schemaCache, handler, project);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "objects: " << handler._objects << std::endl;
+    std::cout << "attribute values: " << handler._values << std::endl;
+    std::cout << "time (s): " << seconds << std::endl;
+    if (seconds > 0) {
+        std::cout << "objects/s: " << handler._objects / seconds << std::endl;
+        std::cout << "attribute reads/s: " << handler._values / seconds << std::endl;
+    }
+    if (handler._objects > 0) {
+        std::cout << "handler calls/object: " << (double) handler._calls / handler._objects << std::endl;
+    }
+    std::cout << "peak RSS (KB): " << getPeakResidentSetSize() << std::endl;
+    return 0;
+}
+
+// reads the project to Arrow IPC files, one per class, for tools that do not need the JVM at all
+int writeArrow(const std::string& powerFactoryHomeDir, const std::string& projectName, const std::string& directory) {
+    pf::Api api(powerFactoryHomeDir);
+    auto project = api.activateProject(projectName);
+
+    pf::SchemaCache schemaCache;
+    pf::ArrowWriter writer(directory);
+    pf::readProject(api, schemaCache, writer, project);
+    return 0;
+}
+
+}
+
+// reads one project with its own engine and writes it to snapshots, to be run by the worker pool, benchmarks the
+// read of a project, or writes it to Arrow files
+int main(int argc, char** argv) {
+    if (argc == 4 && std::string(argv[1]) == "--benchmark") {
+        try {
+            return benchmark(argv[2], argv[3]);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+    if (argc == 5 && std::string(argv[1]) == "--arrow") {
+        try {
+            return writeArrow(argv[2], argv[3], argv[4]);
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+    if (argc < 4) {
+        std::cerr << "Usage: " << argv[0] << " <PowerFactory home> <project name> <snapshot file> [read options]" << std::endl;
+        std::cerr << "       " << argv[0] << " --benchmark <PowerFactory home> <project name>" << std::endl;
+        std::cerr << "       " << argv[0] << " --arrow <PowerFactory home> <project name> <directory>" << std::endl;
+        return 2;
+    }
+    std::string powerFactoryHomeDir = argv[1];
+    std::string projectName = argv[2];
+    std::string snapshotFile = argv[3];
+    try {
+        pf::ReadOptions options = pf::parseWorkerArguments(std::vector<std::string>(argv + 4, argv + argc));
+        pf::Api api(powerFactoryHomeDir);
+        pf::writeWorkerSnapshots(api, projectName, snapshotFile, options);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
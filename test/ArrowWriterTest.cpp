@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file ArrowWriterTest.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include <cstdio>
+#include <fstream>
+#include "ArrowWriter.h"
+#include "ProjectReader.h"
+#include "Test.h"
+#include "v2/Api.hpp"
+
+namespace pf = powsybl::powerfactory;
+
+namespace {
+
+// files of this directory are then read back with pyarrow by arrow_round_trip.py
+const std::string DIRECTORY = POWSYBL_POWERFACTORY_ARROW_DIRECTORY;
+
+const char* const SPEC = "objects=200;depth=3;classes=ElmTerm:2,ElmLne;vector=5;matrix=2x3;library=4";
+
+const size_t BATCH_ROW_COUNT = 16;
+
+std::streamoff getFileSize(const std::string& fileName) {
+    std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+    return file ? (std::streamoff) file.tellg() : -1;
+}
+
+}
+
+POWSYBL_TEST(writesProjectRead) {
+    pf::Api api(SPEC);
+    auto project = api.activateProject("test");
+    pf::SchemaCache schemaCache;
+    pf::ArrowWriter writer(DIRECTORY, BATCH_ROW_COUNT);
+    pf::readProject(api, schemaCache, writer, project);
+    POWSYBL_CHECK(getFileSize(DIRECTORY + "/ElmTerm.arrows") > 0);
+    POWSYBL_CHECK(getFileSize(DIRECTORY + "/ElmLne.arrows") > 0);
+    POWSYBL_CHECK(getFileSize(DIRECTORY + "/IntPrj.arrows") > 0);
+}
+
+POWSYBL_TEST(writesBatchesWhileReading) {
+    const std::string fileName = DIRECTORY + "/ElmBatch.arrows";
+    std::remove(fileName.c_str());
+    pf::ArrowWriter writer(DIRECTORY, BATCH_ROW_COUNT);
+    writer.createClass("ElmBatch");
+    writer.createAttribute("ElmBatch", "nlnum", api::v2::DataObject::AttributeType::TYPE_INTEGER, "");
+    writer.createObject(0, "ElmBatch", -1);
+    writer.setIntAttributeValue(0, "nlnum", 0);
+    POWSYBL_CHECK_EQUAL(-1, getFileSize(fileName));
+
+    for (long id = 1; id <= (long) BATCH_ROW_COUNT; id++) {
+        writer.createObject(id, "ElmBatch", 0);
+    }
+    std::streamoff size = getFileSize(fileName);
+    POWSYBL_CHECK(size > 0);
+    // rows of written batches cannot be changed anymore
+    POWSYBL_CHECK_THROWS(writer.setObjectParent(0, 1));
+    POWSYBL_CHECK_THROWS(writer.createAttribute("ElmBatch", "dline", api::v2::DataObject::AttributeType::TYPE_DOUBLE, ""));
+
+    writer.flush();
+    POWSYBL_CHECK(getFileSize(fileName) > size);
+}
+
+POWSYBL_TEST(rejectsValuesOfPreviousRows) {
+    pf::ArrowWriter writer(DIRECTORY, BATCH_ROW_COUNT);
+    writer.createClass("ElmOrder");
+    writer.createAttribute("ElmOrder", "nlnum", api::v2::DataObject::AttributeType::TYPE_INTEGER, "");
+    writer.createObject(0, "ElmOrder", -1);
+    writer.createObject(1, "ElmOrder", 0);
+    POWSYBL_CHECK_THROWS(writer.setIntAttributeValue(0, "nlnum", 0));
+    writer.setIntAttributeValue(1, "nlnum", 1);
+    POWSYBL_CHECK_THROWS(writer.setIntAttributeValue(1, "nlnum", 1));
+    POWSYBL_CHECK_THROWS(writer.setDoubleAttributeValue(1, "nlnum", 1));
+    writer.flush();
+}
@@ -0,0 +1,362 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file FakeJniEnv.h
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#ifndef POWSYBL_POWERFACTORY_DB_NATIVE_FAKEJNIENV_H
+#define POWSYBL_POWERFACTORY_DB_NATIVE_FAKEJNIENV_H
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <jni.h>
+
+namespace powsybl {
+
+namespace powerfactory {
+
+namespace test {
+
+/**
+ * JNI environment without any JVM behind: methods calls do nothing, but local and global references are tracked as a
+ * JVM would, with local frames, so that tests can check how many local references are alive during a read. Calls are
+ * counted per method name, and methods can be made missing to stand for classes of previous versions.
+ */
+class FakeJniEnv {
+public:
+    FakeJniEnv()
+        : _frames(1) {
+        _functions.FindClass = &findClass;
+        _functions.ThrowNew = &throwNew;
+        _functions.PushLocalFrame = &pushLocalFrame;
+        _functions.PopLocalFrame = &popLocalFrame;
+        _functions.NewGlobalRef = &newGlobalRef;
+        _functions.DeleteGlobalRef = &deleteGlobalRef;
+        _functions.DeleteLocalRef = &deleteLocalRef;
+        _functions.NewObjectV = &newObjectV;
+        _functions.GetMethodID = &getMethodId;
+        _functions.GetStaticMethodID = &getMethodId;
+        _functions.CallStaticObjectMethodV = &callStaticObjectMethodV;
+        _functions.ExceptionClear = &exceptionClear;
+        _functions.CallObjectMethodV = &callObjectMethodV;
+        _functions.CallBooleanMethodV = &callBooleanMethodV;
+        _functions.CallIntMethodV = &callIntMethodV;
+        _functions.CallVoidMethodV = &callVoidMethodV;
+        _functions.NewStringUTF = &newStringUtf;
+        _functions.GetStringUTFLength = &getStringUtfLength;
+        _functions.GetStringUTFChars = &getStringUtfChars;
+        _functions.ReleaseStringUTFChars = &releaseStringUtfChars;
+        _functions.GetArrayLength = &getArrayLength;
+        _functions.NewObjectArray = &newObjectArray;
+        _functions.GetObjectArrayElement = &getObjectArrayElement;
+        _functions.SetObjectArrayElement = &setObjectArrayElement;
+        _functions.NewIntArray = &newIntArray;
+        _functions.NewLongArray = &newLongArray;
+        _functions.NewDoubleArray = &newDoubleArray;
+        _functions.SetIntArrayRegion = &setIntArrayRegion;
+        _functions.SetLongArrayRegion = &setLongArrayRegion;
+        _functions.SetDoubleArrayRegion = &setDoubleArrayRegion;
+        _functions.ExceptionCheck = &exceptionCheck;
+        _functions.NewDirectByteBuffer = &newDirectByteBuffer;
+        _holder._env.functions = &_functions;
+        _holder._owner = this;
+    }
+
+    FakeJniEnv(const FakeJniEnv&) = delete;
+
+    FakeJniEnv& operator=(const FakeJniEnv&) = delete;
+
+    JNIEnv* env() {
+        return &_holder._env;
+    }
+
+    // a global reference to a Java object, as the builders given to the native methods are made global
+    jobject newObject() {
+        return reinterpret_cast<jobject>(newReference(_globalReferences));
+    }
+
+    bool isAlive(jobject obj) const {
+        auto reference = reinterpret_cast<uintptr_t>(obj);
+        if (_globalReferences.count(reference)) {
+            return true;
+        }
+        return std::any_of(_frames.begin(), _frames.end(), [reference](const std::unordered_set<uintptr_t>& frame) {
+            return frame.count(reference) > 0;
+        });
+    }
+
+    size_t getLocalReferenceCount() const {
+        size_t count = 0;
+        for (const auto& frame : _frames) {
+            count += frame.size();
+        }
+        return count;
+    }
+
+    size_t getMaxLocalReferenceCount() const {
+        return _maxLocalReferenceCount;
+    }
+
+    size_t getFrameDepth() const {
+        return _frames.size() - 1;
+    }
+
+    int64_t getUpcallCount() const {
+        return _upcallCount;
+    }
+
+    int64_t getCallCount(const std::string& methodName) const {
+        auto it = _callCounts.find(methodName);
+        return it != _callCounts.end() ? it->second : 0;
+    }
+
+    // lookups of the method with this signature fail with a pending NoSuchMethodError
+    void removeMethod(const std::string& name, const std::string& signature) {
+        _missingMethods.insert(name + signature);
+    }
+
+    // deletion of unknown references, use of a deleted one as a call target, or call with an exception pending
+    int getErrorCount() const {
+        return _errorCount;
+    }
+
+    // makes the next upcalls throw a Java exception, left pending as a JVM would
+    void setThrowing(bool throwing) {
+        _throwing = throwing;
+    }
+
+private:
+    // the environment has to be the first member so that the fake can be found back from it
+    struct Holder {
+        JNIEnv _env;
+        FakeJniEnv* _owner;
+    };
+
+    static FakeJniEnv& get(JNIEnv* env) {
+        return *reinterpret_cast<Holder*>(env)->_owner;
+    }
+
+    uintptr_t newReference(std::unordered_set<uintptr_t>& references) {
+        uintptr_t reference = (++_lastReference) << 4;
+        references.insert(reference);
+        return reference;
+    }
+
+    jobject newLocalReference() {
+        jobject reference = reinterpret_cast<jobject>(newReference(_frames.back()));
+        _maxLocalReferenceCount = std::max(_maxLocalReferenceCount, getLocalReferenceCount());
+        return reference;
+    }
+
+    static jobject upcall(JNIEnv* env, jobject obj, jmethodID methodId) {
+        FakeJniEnv& fake = get(env);
+        fake._upcallCount++;
+        fake._callCounts[*reinterpret_cast<const std::string*>(methodId)]++;
+        if (!fake.isAlive(obj) || fake._exceptionPending) {
+            fake._errorCount++;
+        }
+        fake._exceptionPending |= fake._throwing;
+        return nullptr;
+    }
+
+    static jclass JNICALL findClass(JNIEnv* env, const char*) {
+        return reinterpret_cast<jclass>(get(env).newLocalReference());
+    }
+
+    static jint JNICALL throwNew(JNIEnv*, jclass, const char*) {
+        return JNI_OK;
+    }
+
+    static jint JNICALL pushLocalFrame(JNIEnv* env, jint) {
+        get(env)._frames.emplace_back();
+        return JNI_OK;
+    }
+
+    static jobject JNICALL popLocalFrame(JNIEnv* env, jobject) {
+        FakeJniEnv& fake = get(env);
+        if (fake._frames.size() == 1) {
+            fake._errorCount++;
+        } else {
+            fake._frames.pop_back();
+        }
+        return nullptr;
+    }
+
+    static jobject JNICALL newGlobalRef(JNIEnv* env, jobject) {
+        return reinterpret_cast<jobject>(get(env).newReference(get(env)._globalReferences));
+    }
+
+    static void JNICALL deleteGlobalRef(JNIEnv* env, jobject gref) {
+        if (gref && get(env)._globalReferences.erase(reinterpret_cast<uintptr_t>(gref)) == 0) {
+            get(env)._errorCount++;
+        }
+    }
+
+    static void JNICALL deleteLocalRef(JNIEnv* env, jobject obj) {
+        if (!obj) {
+            return;
+        }
+        FakeJniEnv& fake = get(env);
+        for (auto it = fake._frames.rbegin(); it != fake._frames.rend(); ++it) {
+            if (it->erase(reinterpret_cast<uintptr_t>(obj)) > 0) {
+                fake._strings.erase(reinterpret_cast<uintptr_t>(obj));
+                fake._arrayLengths.erase(reinterpret_cast<uintptr_t>(obj));
+                return;
+            }
+        }
+        fake._errorCount++;
+    }
+
+    static jobject JNICALL newObjectV(JNIEnv* env, jclass, jmethodID, va_list) {
+        return get(env).newLocalReference();
+    }
+
+    // method ids are the method names, shared by all environments as method ids are cached in static members
+    static jmethodID JNICALL getMethodId(JNIEnv* env, jclass, const char* name, const char* signature) {
+        static std::set<std::string> methodNames;
+        FakeJniEnv& fake = get(env);
+        if (fake._exceptionPending) {
+            fake._errorCount++;
+        }
+        if (fake._missingMethods.count(std::string(name) + signature)) {
+            fake._exceptionPending = true;
+            return nullptr;
+        }
+        return reinterpret_cast<jmethodID>(const_cast<std::string*>(&*methodNames.insert(name).first));
+    }
+
+    static jobject JNICALL callObjectMethodV(JNIEnv* env, jobject obj, jmethodID methodId, va_list) {
+        return upcall(env, obj, methodId);
+    }
+
+    static jboolean JNICALL callBooleanMethodV(JNIEnv* env, jobject obj, jmethodID methodId, va_list) {
+        upcall(env, obj, methodId);
+        return JNI_TRUE;
+    }
+
+    static jint JNICALL callIntMethodV(JNIEnv* env, jobject obj, jmethodID methodId, va_list) {
+        upcall(env, obj, methodId);
+        return 0;
+    }
+
+    static void JNICALL callVoidMethodV(JNIEnv* env, jobject obj, jmethodID methodId, va_list) {
+        upcall(env, obj, methodId);
+    }
+
+    // boxing of a value, the class being a global reference
+    static jobject JNICALL callStaticObjectMethodV(JNIEnv* env, jclass cls, jmethodID methodId, va_list) {
+        FakeJniEnv& fake = get(env);
+        fake._callCounts[*reinterpret_cast<const std::string*>(methodId)]++;
+        if (!fake.isAlive(cls)) {
+            fake._errorCount++;
+        }
+        return fake.newLocalReference();
+    }
+
+    static jstring JNICALL newStringUtf(JNIEnv* env, const char* utf) {
+        FakeJniEnv& fake = get(env);
+        jobject str = fake.newLocalReference();
+        fake._strings[reinterpret_cast<uintptr_t>(str)] = utf;
+        return reinterpret_cast<jstring>(str);
+    }
+
+    static jsize JNICALL getStringUtfLength(JNIEnv* env, jstring str) {
+        return (jsize) get(env)._strings[reinterpret_cast<uintptr_t>(str)].size();
+    }
+
+    static const char* JNICALL getStringUtfChars(JNIEnv* env, jstring str, jboolean*) {
+        return get(env)._strings[reinterpret_cast<uintptr_t>(str)].c_str();
+    }
+
+    static void JNICALL releaseStringUtfChars(JNIEnv*, jstring, const char*) {
+    }
+
+    jarray newArray(jsize length) {
+        jobject array = newLocalReference();
+        _arrayLengths[reinterpret_cast<uintptr_t>(array)] = length;
+        return reinterpret_cast<jarray>(array);
+    }
+
+    static jsize JNICALL getArrayLength(JNIEnv* env, jarray array) {
+        return get(env)._arrayLengths[reinterpret_cast<uintptr_t>(array)];
+    }
+
+    static jobjectArray JNICALL newObjectArray(JNIEnv* env, jsize length, jclass, jobject) {
+        return reinterpret_cast<jobjectArray>(get(env).newArray(length));
+    }
+
+    static jobject JNICALL getObjectArrayElement(JNIEnv* env, jobjectArray, jsize) {
+        return get(env).newLocalReference();
+    }
+
+    static void JNICALL setObjectArrayElement(JNIEnv*, jobjectArray, jsize, jobject) {
+    }
+
+    static jintArray JNICALL newIntArray(JNIEnv* env, jsize length) {
+        return reinterpret_cast<jintArray>(get(env).newArray(length));
+    }
+
+    static jlongArray JNICALL newLongArray(JNIEnv* env, jsize length) {
+        return reinterpret_cast<jlongArray>(get(env).newArray(length));
+    }
+
+    static jdoubleArray JNICALL newDoubleArray(JNIEnv* env, jsize length) {
+        return reinterpret_cast<jdoubleArray>(get(env).newArray(length));
+    }
+
+    static void JNICALL setIntArrayRegion(JNIEnv*, jintArray, jsize, jsize, const jint*) {
+    }
+
+    static void JNICALL setLongArrayRegion(JNIEnv*, jlongArray, jsize, jsize, const jlong*) {
+    }
+
+    static void JNICALL setDoubleArrayRegion(JNIEnv*, jdoubleArray, jsize, jsize, const jdouble*) {
+    }
+
+    static jboolean JNICALL exceptionCheck(JNIEnv* env) {
+        return get(env)._exceptionPending ? JNI_TRUE : JNI_FALSE;
+    }
+
+    static void JNICALL exceptionClear(JNIEnv* env) {
+        get(env)._exceptionPending = false;
+    }
+
+    static jobject JNICALL newDirectByteBuffer(JNIEnv* env, void*, jlong) {
+        return get(env).newLocalReference();
+    }
+
+    JNINativeInterface_ _functions = {};
+    Holder _holder;
+
+    // base frame first, then one set per pushed local frame
+    std::vector<std::unordered_set<uintptr_t>> _frames;
+    std::unordered_set<uintptr_t> _globalReferences;
+    uintptr_t _lastReference = 0;
+    size_t _maxLocalReferenceCount = 0;
+
+    std::map<uintptr_t, std::string> _strings;
+    std::map<uintptr_t, jsize> _arrayLengths;
+
+    int64_t _upcallCount = 0;
+    std::map<std::string, int64_t> _callCounts;
+    std::set<std::string> _missingMethods;
+    int _errorCount = 0;
+    bool _throwing = false;
+    bool _exceptionPending = false;
+};
+
+}
+
+}
+
+}
+
+#endif //POWSYBL_POWERFACTORY_DB_NATIVE_FAKEJNIENV_H
@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file JniDataObjectHandlerTest.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include <string>
+#include "FakeJniEnv.h"
+#include "JniDataObjectHandler.h"
+#include "ProjectReader.h"
+#include "Test.h"
+
+namespace pf = powsybl::powerfactory;
+
+namespace {
+
+// the largest upcall needs a few references at once, whatever the number of objects
+const size_t MAX_LOCAL_REFERENCE_COUNT = 8;
+
+// largest number of local references alive at once while reading two projects of the given size and their library
+size_t getMaxLocalReferenceCount(int objectCount) {
+    pf::test::FakeJniEnv fake;
+    JNIEnv* env = fake.env();
+
+    // project handlers and library handler interleave their upcalls on the same environment
+    powsybl::jni::ComPowsyblPowerFactoryDbDataObjectBuilder builder1(env, fake.newObject());
+    powsybl::jni::ComPowsyblPowerFactoryDbDataObjectBuilder builder2(env, fake.newObject());
+    powsybl::jni::ComPowsyblPowerFactoryDbDataObjectBuilder libraryBuilder(env, fake.newObject());
+    pf::JniDataObjectHandler handler1(builder1, true);
+    pf::BatchedJniDataObjectHandler handler2(builder2, 100);
+    pf::JniDataObjectHandler libraryHandler(libraryBuilder);
+    // class lookups of the wrappers initialization are released too
+    POWSYBL_CHECK_EQUAL(0, fake.getLocalReferenceCount());
+
+    pf::Api api("objects=" + std::to_string(objectCount) + ";depth=6;classes=ElmTerm:2,ElmLne;vector=2;matrix=2x2;library=8");
+    pf::SchemaCache schemaCache;
+    pf::ReadOptions options;
+    options._readReferences = true;
+    pf::readProjects(api, schemaCache, {"p1", "p2"}, {&handler1, &handler2}, libraryHandler, options);
+
+    POWSYBL_CHECK_EQUAL(0, fake.getErrorCount());
+    POWSYBL_CHECK_EQUAL(0, fake.getFrameDepth());
+    POWSYBL_CHECK_EQUAL(0, fake.getLocalReferenceCount());
+    return fake.getMaxLocalReferenceCount();
+}
+
+}
+
+POWSYBL_TEST(boundsLocalReferencesWhateverTheObjectCount) {
+    size_t maxLocalReferenceCount = getMaxLocalReferenceCount(1000);
+    POWSYBL_CHECK(maxLocalReferenceCount <= MAX_LOCAL_REFERENCE_COUNT);
+    POWSYBL_CHECK_EQUAL(maxLocalReferenceCount, getMaxLocalReferenceCount(10000));
+}
+
+POWSYBL_TEST(releasesLocalReferencesOfInterleavedHandlers) {
+    pf::test::FakeJniEnv fake;
+    JNIEnv* env = fake.env();
+    powsybl::jni::ComPowsyblPowerFactoryDbDataObjectBuilder builder1(env, fake.newObject());
+    powsybl::jni::ComPowsyblPowerFactoryDbDataObjectBuilder builder2(env, fake.newObject());
+    pf::JniDataObjectHandler handler1(builder1);
+    pf::BatchedJniDataObjectHandler handler2(builder2, 2, true);
+
+    // second handler flushed while first one is in the middle of an object
+    handler1.createObject(0, "ElmLne", -1);
+    POWSYBL_CHECK_EQUAL(0, fake.getFrameDepth());
+    // local reference of the caller, which the handlers must not release
+    jstring callerReference = env->NewStringUTF("caller");
+    handler2.createObject(0, "ElmTerm", -1);
+    handler1.setStringAttributeValue(0, "loc_name", "line");
+    handler2.setStringAttributeValue(0, "loc_name", "terminal");
+    handler2.setDoubleAttributeValue(0, "uknom", 400);
+    handler2.flush();
+    handler1.setDoubleVectorAttributeValue(0, "dvec", {1, 2});
+    handler1.setStringVectorAttributeValue(0, "svec", {"a", "b"});
+    handler2.createObject(1, "ElmTerm", 0);
+    handler1.createObject(1, "ElmLne", 0);
+    handler1.beginAttributeValue(1, "dmat", 3, 2, 2);
+    handler2.setStringVectorAttributeValue(1, "svec", {"a", "b"});
+    const double values[] = {1, 2, 3, 4};
+    handler1.appendDoubleValues(values, 4);
+    handler1.endAttributeValue();
+    handler1.flush();
+    handler2.flush();
+
+    POWSYBL_CHECK(fake.isAlive(callerReference));
+    env->DeleteLocalRef(callerReference);
+    POWSYBL_CHECK_EQUAL(0, fake.getErrorCount());
+    POWSYBL_CHECK_EQUAL(0, fake.getFrameDepth());
+    POWSYBL_CHECK_EQUAL(0, fake.getLocalReferenceCount());
+}
+
+POWSYBL_TEST(abortsReadOnBuilderException) {
+    pf::test::FakeJniEnv fake;
+    JNIEnv* env = fake.env();
+    powsybl::jni::ComPowsyblPowerFactoryDbDataObjectBuilder builder(env, fake.newObject());
+    pf::JniDataObjectHandler handler(builder);
+    handler.createObject(0, "ElmLne", -1);
+
+    fake.setThrowing(true);
+    POWSYBL_CHECK_THROWS(handler.setStringAttributeValue(0, "loc_name", "line"));
+    POWSYBL_CHECK(env->ExceptionCheck());
+    POWSYBL_CHECK_EQUAL(0, fake.getLocalReferenceCount());
+}
@@ -0,0 +1,66 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file JniLegacyBuilderTest.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include "FakeJniEnv.h"
+#include "JniDataObjectHandler.h"
+#include "ProjectReader.h"
+#include "Test.h"
+
+namespace pf = powsybl::powerfactory;
+
+// method ids of the builder are looked up once per process, so a builder of a previous version needs its own test
+// executable
+POWSYBL_TEST(readsWithBuilderOfPreviousVersion) {
+    pf::test::FakeJniEnv fake;
+    fake.removeMethod("createObject", "(JLjava/lang/String;J)V");
+    fake.removeMethod("createSchema", "([Ljava/lang/String;[I[Ljava/lang/String;[I[Ljava/lang/String;)V");
+    fake.removeMethod("updateObject", "(J)V");
+    fake.removeMethod("deleteObject", "(J)V");
+    fake.removeMethod("setIntVectorAttributeValue", "(JLjava/lang/String;[I)V");
+    fake.removeMethod("beginAttributeValue", "(JLjava/lang/String;III)V");
+    fake.removeMethod("appendIntValues", "([II)V");
+    fake.removeMethod("appendLongValues", "([JI)V");
+    fake.removeMethod("appendDoubleValues", "([DI)V");
+    fake.removeMethod("endAttributeValue", "()V");
+    fake.removeMethod("appendDictionaryString", "(Ljava/lang/String;)V");
+    fake.removeMethod("setStringCodeAttributeValue", "(JLjava/lang/String;I)V");
+    fake.removeMethod("setStringCodeVectorAttributeValue", "(JLjava/lang/String;[I)V");
+    fake.removeMethod("createAttributeIndex", "(ILjava/lang/String;)V");
+    fake.removeMethod("flushBatch", "(IILjava/nio/ByteBuffer;Ljava/nio/ByteBuffer;Ljava/nio/ByteBuffer;)V");
+    JNIEnv* env = fake.env();
+
+    powsybl::jni::ComPowsyblPowerFactoryDbDataObjectBuilder builder(env, fake.newObject());
+    POWSYBL_CHECK(!env->ExceptionCheck());
+    POWSYBL_CHECK(!builder.isChunkedValueSupported());
+    POWSYBL_CHECK(!builder.isStringDictionarySupported());
+    POWSYBL_CHECK(!builder.isBatchSupported());
+    POWSYBL_CHECK(!builder.isDeltaSupported());
+
+    // every option relying on new builder methods is asked for
+    pf::JniDataObjectHandler handler(builder, true);
+    pf::Api api("objects=50;depth=3;classes=ElmTerm:2,ElmLne;vector=5;matrix=2x3");
+    auto project = api.activateProject("test");
+    pf::SchemaCache schemaCache;
+    pf::ReadOptions options;
+    options._schemaFirst = true;
+    options._chunkSize = 2;
+    pf::readProject(api, schemaCache, handler, project, options);
+
+    POWSYBL_CHECK(!env->ExceptionCheck());
+    POWSYBL_CHECK_EQUAL(0, fake.getErrorCount());
+    POWSYBL_CHECK_EQUAL(0, fake.getLocalReferenceCount());
+    POWSYBL_CHECK(fake.getCallCount("createClass") > 0);
+    POWSYBL_CHECK(fake.getCallCount("createAttribute") > 0);
+    // one object out of the 51 of the project has no parent
+    POWSYBL_CHECK_EQUAL(51, fake.getCallCount("createObject"));
+    POWSYBL_CHECK_EQUAL(50, fake.getCallCount("setObjectParent"));
+    POWSYBL_CHECK(fake.getCallCount("setStringAttributeValue") > 0);
+    POWSYBL_CHECK(fake.getCallCount("setDoubleMatrixAttributeValue") > 0);
+    POWSYBL_CHECK(fake.getCallCount("valueOf") > 0);
+}
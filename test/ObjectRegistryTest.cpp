@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file ObjectRegistryTest.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include <cstdint>
+#include "ObjectRegistry.h"
+#include "Test.h"
+
+namespace pf = powsybl::powerfactory;
+
+namespace {
+
+// the registry never dereferences objects, aligned fake pointers are enough
+api::v2::DataObject* fakeObject(size_t i) {
+    return reinterpret_cast<api::v2::DataObject*>((uintptr_t) (i + 1) * 16);
+}
+
+}
+
+POWSYBL_TEST(givesDenseIdsInRegistrationOrder) {
+    pf::ObjectRegistry registry;
+    for (size_t i = 0; i < 100; i++) {
+        POWSYBL_CHECK_EQUAL((long) i, registry.add(fakeObject(i)));
+    }
+    POWSYBL_CHECK_EQUAL(100, registry.size());
+    for (size_t i = 0; i < 100; i++) {
+        POWSYBL_CHECK_EQUAL((long) i, registry.find(fakeObject(i)));
+        POWSYBL_CHECK(registry.get((long) i) == fakeObject(i));
+    }
+}
+
+POWSYBL_TEST(keepsIdOfRegisteredObject) {
+    pf::ObjectRegistry registry;
+    registry.add(fakeObject(0));
+    registry.add(fakeObject(1));
+    POWSYBL_CHECK_EQUAL(0, registry.add(fakeObject(0)));
+    registry.addAll({fakeObject(1), fakeObject(2), fakeObject(2)});
+    POWSYBL_CHECK_EQUAL(3, registry.size());
+    POWSYBL_CHECK_EQUAL(2, registry.find(fakeObject(2)));
+}
+
+POWSYBL_TEST(handlesNullAndUnknownObjects) {
+    pf::ObjectRegistry registry;
+    POWSYBL_CHECK_EQUAL(-1, registry.add(nullptr));
+    POWSYBL_CHECK_EQUAL(-1, registry.find(nullptr));
+    POWSYBL_CHECK_EQUAL(-1, registry.find(fakeObject(0)));
+    POWSYBL_CHECK_EQUAL(0, registry.size());
+    POWSYBL_CHECK_THROWS(registry.get(0));
+    POWSYBL_CHECK_THROWS(registry.get(-1));
+}
+
+POWSYBL_TEST(growsThroughSmallBatches) {
+    // like children lists of a traversal, many small batches, far beyond the expected size
+    const size_t objectCount = 1000000;
+    pf::ObjectRegistry registry(16);
+    std::vector<api::v2::DataObject*> batch;
+    for (size_t i = 0; i < objectCount; i++) {
+        batch.push_back(fakeObject(i));
+        if (batch.size() == 3) {
+            registry.addAll(batch);
+            batch.clear();
+        }
+    }
+    registry.addAll(batch);
+    POWSYBL_CHECK_EQUAL(objectCount, registry.size());
+    for (size_t i = 0; i < objectCount; i += 997) {
+        POWSYBL_CHECK_EQUAL((long) i, registry.find(fakeObject(i)));
+    }
+}
+
+POWSYBL_TEST(spreadsPointersWithHighBitsOnly) {
+    // pointers differing only by their high bits must not all collide
+    pf::ObjectRegistry registry;
+    for (size_t i = 0; i < 1000; i++) {
+        auto object = reinterpret_cast<api::v2::DataObject*>(((uintptr_t) (i + 1) << 40) | 0x1000);
+        POWSYBL_CHECK_EQUAL((long) i, registry.add(object));
+    }
+    for (size_t i = 0; i < 1000; i++) {
+        auto object = reinterpret_cast<api::v2::DataObject*>(((uintptr_t) (i + 1) << 40) | 0x1000);
+        POWSYBL_CHECK_EQUAL((long) i, registry.find(object));
+    }
+}
@@ -0,0 +1,156 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file ParallelReadTest.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include "ParallelRead.h"
+#include "ProjectReader.h"
+#include "RecordingDataObjectHandler.h"
+#include "Test.h"
+#include "WorkerPool.h"
+
+namespace pf = powsybl::powerfactory;
+
+namespace {
+
+const char* const SPEC = "objects=60;depth=2;classes=ElmTerm,ElmLne;vector=2;matrix=1x2;library=10";
+
+const std::vector<std::string> PROJECT_NAMES{"a", "b", "c"};
+
+struct BatchRead {
+    std::vector<pf::test::RecordingDataObjectHandler> _projects;
+    pf::test::RecordingDataObjectHandler _library;
+
+    BatchRead()
+        : _projects(PROJECT_NAMES.size()) {
+    }
+
+    std::vector<pf::DataObjectHandler*> getProjectHandlers() {
+        std::vector<pf::DataObjectHandler*> handlers;
+        for (auto& project : _projects) {
+            handlers.push_back(&project);
+        }
+        return handlers;
+    }
+};
+
+BatchRead readWithWorkers(const pf::ReadOptions& options) {
+    std::vector<std::string> snapshotFiles;
+    std::vector<std::vector<std::string>> argumentLists;
+    for (size_t i = 0; i < PROJECT_NAMES.size(); i++) {
+        snapshotFiles.push_back("ParallelReadTest-" + std::to_string(i) + ".pfdb");
+        argumentLists.push_back({SPEC, PROJECT_NAMES[i], snapshotFiles.back()});
+        auto optionArguments = pf::toWorkerArguments(options);
+        argumentLists.back().insert(argumentLists.back().end(), optionArguments.begin(), optionArguments.end());
+    }
+    pf::WorkerPool(POWSYBL_POWERFACTORY_WORKER, 2).run(argumentLists);
+
+    BatchRead read;
+    pf::mergeWorkerSnapshots(snapshotFiles, read.getProjectHandlers(), read._library);
+    for (const auto& snapshotFile : snapshotFiles) {
+        pf::removeWorkerSnapshots(snapshotFile);
+    }
+    return read;
+}
+
+BatchRead readWithSingleEngine(const pf::ReadOptions& options) {
+    BatchRead read;
+    pf::Api api(SPEC);
+    pf::SchemaCache schemaCache;
+    pf::readProjects(api, schemaCache, PROJECT_NAMES, read.getProjectHandlers(), read._library, options);
+    return read;
+}
+
+std::multiset<std::string> getNames(const pf::test::RecordingDataObjectHandler& handler) {
+    std::multiset<std::string> names;
+    for (const auto& e : handler._objects) {
+        names.insert(e.second._values.at("loc_name"));
+    }
+    return names;
+}
+
+// references resolve to objects of the project or of the library, and no id is used twice
+void checkIds(const BatchRead& read) {
+    std::set<long> ids;
+    for (const auto& e : read._library._objects) {
+        POWSYBL_CHECK(ids.insert(e.first).second);
+    }
+    for (const auto& project : read._projects) {
+        for (const auto& e : project._objects) {
+            POWSYBL_CHECK(ids.insert(e.first).second);
+        }
+    }
+    for (const auto& project : read._projects) {
+        for (const auto& e : project._objects) {
+            auto it = e.second._values.find("typ_id");
+            if (it != e.second._values.end() && it->second != "#-1") {
+                long id = std::stol(it->second.substr(1));
+                POWSYBL_CHECK(project._objects.count(id) == 1 || read._library._objects.count(id) == 1);
+            }
+        }
+    }
+}
+
+void checkSameRead(const BatchRead& expected, const BatchRead& actual) {
+    checkIds(actual);
+    POWSYBL_CHECK(getNames(expected._library) == getNames(actual._library));
+    for (size_t i = 0; i < PROJECT_NAMES.size(); i++) {
+        POWSYBL_CHECK(getNames(expected._projects[i]) == getNames(actual._projects[i]));
+        POWSYBL_CHECK(expected._projects[i]._attributes == actual._projects[i]._attributes);
+        POWSYBL_CHECK_EQUAL(1, actual._projects[i]._flushCount);
+    }
+    POWSYBL_CHECK_EQUAL(1, actual._library._flushCount);
+}
+
+}
+
+POWSYBL_TEST(mergesWorkerSnapshotsWithSharedLibrary) {
+    pf::ReadOptions options;
+    auto expected = readWithSingleEngine(options);
+    auto actual = readWithWorkers(options);
+    POWSYBL_CHECK_EQUAL(10, actual._library._objects.size());
+    checkSameRead(expected, actual);
+}
+
+POWSYBL_TEST(passesReadOptionsToWorkers) {
+    pf::ReadOptions options;
+    options._classNames = {"IntPrj", "ElmLne", "TypLne"};
+    options._attributeNames["ElmLne"] = {"loc_name", "typ_id"};
+    options._maxReferenceDepth = 2;
+    options._breadthFirst = true;
+    auto expected = readWithSingleEngine(options);
+    auto actual = readWithWorkers(options);
+    checkSameRead(expected, actual);
+    POWSYBL_CHECK_EQUAL(2, actual._projects[0]._attributes.at("ElmLne").size());
+    POWSYBL_CHECK_EQUAL(0, actual._projects[0]._attributes.count("ElmTerm"));
+}
+
+POWSYBL_TEST(parsesWorkerArguments) {
+    pf::ReadOptions options;
+    options._schemaFirst = true;
+    options._classNames = {"ElmLne"};
+    options._attributeNames["ElmLne"] = {"loc_name"};
+    options._excludedSubtreePatterns = {"\\\\a b.IntFolder"};
+    options._maxReferenceDepth = 3;
+    auto parsed = pf::parseWorkerArguments(pf::toWorkerArguments(options));
+    POWSYBL_CHECK_EQUAL(options.getFilterKey(), parsed.getFilterKey());
+    POWSYBL_CHECK(parsed._schemaFirst);
+    POWSYBL_CHECK(!parsed._breadthFirst);
+    POWSYBL_CHECK_EQUAL(3, parsed._maxReferenceDepth);
+    POWSYBL_CHECK_THROWS(pf::parseWorkerArguments({"--unknown"}));
+    POWSYBL_CHECK_THROWS(pf::parseWorkerArguments({"--class"}));
+}
+
+POWSYBL_TEST(quotesWindowsArguments) {
+    POWSYBL_CHECK_EQUAL("abc", pf::quoteWindowsArgument("abc"));
+    POWSYBL_CHECK_EQUAL("a\\b", pf::quoteWindowsArgument("a\\b"));
+    POWSYBL_CHECK_EQUAL("\"\"", pf::quoteWindowsArgument(""));
+    POWSYBL_CHECK_EQUAL("\"a b\"", pf::quoteWindowsArgument("a b"));
+    POWSYBL_CHECK_EQUAL("\"a\\\"b\"", pf::quoteWindowsArgument("a\"b"));
+    POWSYBL_CHECK_EQUAL("\"C:\\my dir\\\\\"", pf::quoteWindowsArgument("C:\\my dir\\"));
+    POWSYBL_CHECK_EQUAL("\"a\\\\\\\\\\\"b\"", pf::quoteWindowsArgument("a\\\\\"b"));
+}
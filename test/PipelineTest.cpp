@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file PipelineTest.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include "Pipeline.h"
+#include "ProjectReader.h"
+#include "RecordingDataObjectHandler.h"
+#include "Test.h"
+
+namespace pf = powsybl::powerfactory;
+
+namespace {
+
+const char* const SPEC = "objects=2000;depth=4;classes=ElmTerm:2,ElmLne;vector=20;matrix=4x5;library=4";
+
+// small enough for both threads to find the buffer full or empty many times
+const size_t CAPACITY = 4;
+
+/**
+ * Fails once a given number of objects have been created.
+ */
+class FailingDataObjectHandler : public pf::test::RecordingDataObjectHandler {
+public:
+    explicit FailingDataObjectHandler(size_t objectCount)
+        : _objectCount(objectCount) {
+    }
+
+    void createObject(long id, const std::string& className, long parentId) override {
+        if (_objects.size() == _objectCount) {
+            throw std::runtime_error("Handler failure");
+        }
+        RecordingDataObjectHandler::createObject(id, className, parentId);
+    }
+
+private:
+    const size_t _objectCount;
+};
+
+void read(pf::DataObjectHandler& handler, const pf::ReadOptions& options = pf::ReadOptions()) {
+    pf::Api api(SPEC);
+    auto project = api.activateProject("test");
+    pf::SchemaCache schemaCache;
+    pf::readProject(api, schemaCache, handler, project, options);
+}
+
+void readThroughPipeline(pf::DataObjectHandler& handler, const pf::ReadOptions& options = pf::ReadOptions()) {
+    pf::Pipeline(CAPACITY).run([&options](pf::DataObjectHandler& producerHandler) {
+        read(producerHandler, options);
+    }, handler);
+}
+
+void checkSameObjects(const pf::test::RecordingDataObjectHandler& expected, const pf::test::RecordingDataObjectHandler& actual) {
+    POWSYBL_CHECK_EQUAL(expected._objects.size(), actual._objects.size());
+    POWSYBL_CHECK(expected._order == actual._order);
+    POWSYBL_CHECK(expected._attributes == actual._attributes);
+    for (const auto& e : expected._objects) {
+        const auto& object = actual._objects.at(e.first);
+        POWSYBL_CHECK_EQUAL(e.second._className, object._className);
+        POWSYBL_CHECK_EQUAL(e.second._parentId, object._parentId);
+        POWSYBL_CHECK(e.second._values == object._values);
+    }
+    POWSYBL_CHECK_EQUAL(expected._flushCount, actual._flushCount);
+}
+
+}
+
+POWSYBL_TEST(forwardsEverythingInOrder) {
+    pf::test::RecordingDataObjectHandler direct;
+    read(direct);
+
+    pf::test::RecordingDataObjectHandler pipelined;
+    readThroughPipeline(pipelined);
+
+    POWSYBL_CHECK_EQUAL(2001, pipelined._objects.size());
+    checkSameObjects(direct, pipelined);
+}
+
+POWSYBL_TEST(forwardsChunkedValues) {
+    pf::test::RecordingDataObjectHandler direct;
+    read(direct);
+
+    pf::ReadOptions options;
+    options._chunkSize = 7;
+    pf::test::ChunkedRecordingDataObjectHandler pipelined;
+    readThroughPipeline(pipelined, options);
+
+    POWSYBL_CHECK(pipelined._chunkCount > 0);
+    checkSameObjects(direct, pipelined);
+}
+
+POWSYBL_TEST(stopsReaderWhenHandlerFails) {
+    FailingDataObjectHandler handler(100);
+    POWSYBL_CHECK_THROWS(readThroughPipeline(handler));
+    POWSYBL_CHECK_EQUAL(100, handler._objects.size());
+}
+
+POWSYBL_TEST(rethrowsReaderFailure) {
+    pf::test::RecordingDataObjectHandler handler;
+    POWSYBL_CHECK_THROWS(pf::Pipeline(CAPACITY).run([](pf::DataObjectHandler& producerHandler) {
+        producerHandler.createClass("ElmTerm");
+        throw std::runtime_error("Reader failure");
+    }, handler));
+    POWSYBL_CHECK_EQUAL(1, handler._attributes.size());
+}
@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file ProjectModelTest.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include "ProjectModel.h"
+#include "ProjectReader.h"
+#include "RecordingDataObjectHandler.h"
+#include "StubEngine.h"
+#include "Test.h"
+
+namespace pf = powsybl::powerfactory;
+
+namespace {
+
+const char* const SPEC = "objects=200;depth=3;classes=ElmTerm,ElmLne;vector=3;matrix=2x2;library=8";
+
+void read(pf::Api& api, pf::ProjectModel& model, bool breadthFirst) {
+    auto project = api.activateProject("test");
+    pf::ReadOptions options;
+    options._readReferences = true;
+    options._breadthFirst = breadthFirst;
+    pf::SchemaCache schemaCache;
+    pf::readProject(api, schemaCache, model, project, options);
+}
+
+// previous model in depth first order, new one breadth first with another engine, so that ids differ between both
+pf::test::RecordingDataObjectHandler readDelta(const std::string& spec, size_t modifiedObjectIndex = 0) {
+    pf::Api previousApi(SPEC);
+    pf::ProjectModel previousModel;
+    read(previousApi, previousModel, false);
+
+    pf::Api api(spec);
+    api.activateProject("test");
+    if (modifiedObjectIndex > 0) {
+        pf::stub::modifyObject(api._api, modifiedObjectIndex);
+    }
+    pf::ProjectModel model;
+    read(api, model, true);
+    model.remapIds(previousModel);
+
+    pf::test::RecordingDataObjectHandler handler;
+    pf::test::RecordingDataObjectHandler previousHandler;
+    previousModel.replay(previousHandler);
+    for (const auto& e : previousHandler._objects) {
+        handler._external.emplace(e.first, e.second._className);
+    }
+    model.emitDelta(previousModel, handler);
+
+    // references to library objects are kept
+    pf::test::RecordingDataObjectHandler replayHandler;
+    model.replay(replayHandler);
+    for (const auto& e : replayHandler._objects) {
+        auto it = e.second._values.find("typ_id");
+        if (it != e.second._values.end() && it->second != "#-1") {
+            POWSYBL_CHECK(replayHandler._objects.count(std::stol(it->second.substr(1))) == 1);
+        }
+    }
+    return handler;
+}
+
+}
+
+POWSYBL_TEST(emitsNothingForSameProject) {
+    auto handler = readDelta(SPEC);
+    POWSYBL_CHECK_EQUAL(0, handler._calls);
+    POWSYBL_CHECK_EQUAL(1, handler._flushCount);
+}
+
+POWSYBL_TEST(emitsUpdatedObject) {
+    auto handler = readDelta(SPEC, 7);
+    // with the project, its time stamp being the one of its last modified object
+    POWSYBL_CHECK_EQUAL(2, handler._updated.size());
+    POWSYBL_CHECK(handler._deleted.empty());
+    POWSYBL_CHECK_EQUAL(2, handler._objects.size());
+    // classes declared once with their attributes, then all the values of the objects
+    POWSYBL_CHECK_EQUAL(2, handler._attributes.size());
+    POWSYBL_CHECK_EQUAL(11, handler._attributes.at("ElmTerm").size());
+    POWSYBL_CHECK_EQUAL(2, handler._attributes.at("IntPrj").size());
+}
+
+POWSYBL_TEST(emitsCreatedObjects) {
+    auto handler = readDelta("objects=210;depth=3;classes=ElmTerm,ElmLne;vector=3;matrix=2x2;library=8");
+    POWSYBL_CHECK_EQUAL(10, handler._objects.size());
+    POWSYBL_CHECK(handler._updated.empty());
+    POWSYBL_CHECK(handler._deleted.empty());
+    POWSYBL_CHECK_EQUAL(2, handler._attributes.size());
+}
+
+POWSYBL_TEST(emitsDeletedObjects) {
+    auto handler = readDelta("objects=195;depth=3;classes=ElmTerm,ElmLne;vector=3;matrix=2x2;library=8");
+    POWSYBL_CHECK_EQUAL(5, handler._deleted.size());
+    POWSYBL_CHECK(handler._updated.empty());
+    POWSYBL_CHECK(handler._objects.empty());
+}
+
+POWSYBL_TEST(emitsChangedLibraryReference) {
+    // library object referenced by project objects is modified
+    auto handler = readDelta("objects=200;depth=3;classes=ElmTerm,ElmLne;vector=3;matrix=2x2;library=7");
+    POWSYBL_CHECK(!handler._updated.empty());
+}
@@ -0,0 +1,259 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file ProjectReaderTest.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include "ProjectReader.h"
+#include "ReadProgress.h"
+#include "RecordingDataObjectHandler.h"
+#include "StubEngine.h"
+#include "Test.h"
+
+namespace pf = powsybl::powerfactory;
+
+namespace {
+
+const char* const SPEC = "objects=200;depth=3;classes=ElmTerm:2,ElmLne;vector=5;matrix=2x3;library=4";
+
+pf::test::RecordingDataObjectHandler read(const std::string& spec, const pf::ReadOptions& options = pf::ReadOptions()) {
+    pf::Api api(spec);
+    auto project = api.activateProject("test");
+    pf::SchemaCache schemaCache;
+    pf::test::RecordingDataObjectHandler handler;
+    pf::readProject(api, schemaCache, handler, project, options);
+    POWSYBL_CHECK_EQUAL(0, pf::stub::getLiveValueCount(api._api));
+    return handler;
+}
+
+const pf::test::RecordedObject& findObject(const pf::test::RecordingDataObjectHandler& handler, const std::string& name) {
+    for (const auto& e : handler._objects) {
+        if (e.second._values.at("loc_name") == name) {
+            return e.second;
+        }
+    }
+    pf::test::fail("object '" + name + "' not found", __FILE__, __LINE__);
+}
+
+int getDepth(const pf::test::RecordingDataObjectHandler& handler, long id) {
+    int depth = 0;
+    for (long parentId = handler._objects.at(id)._parentId; parentId != -1; parentId = handler._objects.at(parentId)._parentId) {
+        depth++;
+    }
+    return depth;
+}
+
+}
+
+POWSYBL_TEST(readsWholeProject) {
+    auto handler = read(SPEC);
+    POWSYBL_CHECK_EQUAL(201, handler._objects.size());
+    POWSYBL_CHECK_EQUAL(1, handler._flushCount);
+
+    std::map<std::string, int> classCounts;
+    for (const auto& e : handler._objects) {
+        classCounts[e.second._className]++;
+        POWSYBL_CHECK(getDepth(handler, e.first) <= 3);
+    }
+    POWSYBL_CHECK_EQUAL(1, classCounts["IntPrj"]);
+    POWSYBL_CHECK_EQUAL(134, classCounts["ElmTerm"]);
+    POWSYBL_CHECK_EQUAL(66, classCounts["ElmLne"]);
+
+    const auto& project = handler._objects.at(handler._order.front());
+    POWSYBL_CHECK_EQUAL("IntPrj", project._className);
+    POWSYBL_CHECK_EQUAL(-1, project._parentId);
+
+    const auto& line = findObject(handler, "ElmLne3");
+    POWSYBL_CHECK_EQUAL("3", line._values.at("nlnum"));
+    POWSYBL_CHECK_EQUAL("1.5", line._values.at("dline"));
+    POWSYBL_CHECK_EQUAL("[3,4,5,6,7]", line._values.at("ivec"));
+    POWSYBL_CHECK_EQUAL("[3,3.25,3.5,3.75,4]", line._values.at("dvec"));
+    POWSYBL_CHECK_EQUAL("[s3_0,s3_1]", line._values.at("svec"));
+    POWSYBL_CHECK_EQUAL("2x3[3,4,5,6,7,8]", line._values.at("dmat"));
+}
+
+POWSYBL_TEST(readsSameValuesCellByCell) {
+    auto whole = read(SPEC);
+    auto cellByCell = read(std::string(SPEC) + ";whole=0");
+    POWSYBL_CHECK_EQUAL(whole._objects.size(), cellByCell._objects.size());
+    for (const auto& e : whole._objects) {
+        POWSYBL_CHECK(e.second._values == cellByCell._objects.at(e.first)._values);
+    }
+}
+
+POWSYBL_TEST(keepsReadingWholeValuesAfterEmptyOnes) {
+    // one object out of four has empty vectors and matrices, returned as null values
+    const std::string spec = std::string(SPEC) + ";vector=20;empty=4";
+    auto countCalls = [](const std::string& spec) {
+        pf::Api api(spec);
+        auto project = api.activateProject("test");
+        pf::SchemaCache schemaCache;
+        pf::test::RecordingDataObjectHandler handler;
+        uint64_t callCount = pf::stub::getCallCount(api._api);
+        pf::readProject(api, schemaCache, handler, project);
+        return pf::stub::getCallCount(api._api) - callCount;
+    };
+    uint64_t wholeCallCount = countCalls(spec);
+    uint64_t cellByCellCallCount = countCalls(spec + ";whole=0");
+    POWSYBL_CHECK(wholeCallCount * 2 < cellByCellCallCount);
+
+    auto whole = read(spec);
+    auto cellByCell = read(spec + ";whole=0");
+    POWSYBL_CHECK_EQUAL(whole._objects.size(), cellByCell._objects.size());
+    for (const auto& e : whole._objects) {
+        POWSYBL_CHECK(e.second._values == cellByCell._objects.at(e.first)._values);
+    }
+    POWSYBL_CHECK_EQUAL(0, findObject(whole, "ElmTerm4")._values.count("dmat"));
+    POWSYBL_CHECK_EQUAL("2x3[3,4,5,6,7,8]", findObject(whole, "ElmLne3")._values.at("dmat"));
+}
+
+POWSYBL_TEST(readsUnmodifiedProjectFromCache) {
+    pf::Api api(SPEC);
+    auto project = api.activateProject("test");
+    pf::SchemaCache schemaCache;
+    pf::ReadOptions options;
+    options._cacheDir = POWSYBL_POWERFACTORY_CACHE_DIRECTORY;
+    auto cachedRead = [&]() {
+        pf::test::RecordingDataObjectHandler handler;
+        pf::readProject(api, schemaCache, handler, project, "test", options);
+        return handler;
+    };
+
+    auto first = cachedRead();
+    uint64_t callCount = pf::stub::getCallCount(api._api);
+    auto second = cachedRead();
+    // time stamp type and value of the project, without walking its objects
+    POWSYBL_CHECK(pf::stub::getCallCount(api._api) - callCount <= 2);
+    POWSYBL_CHECK_EQUAL(201, second._objects.size());
+    for (const auto& e : first._objects) {
+        POWSYBL_CHECK(e.second._values == second._objects.at(e.first)._values);
+    }
+
+    // a modified object deep in the project invalidates the cached snapshot
+    pf::stub::modifyObject(api._api, 150);
+    auto modified = cachedRead();
+    pf::test::RecordingDataObjectHandler direct;
+    pf::readProject(api, schemaCache, direct, project);
+    POWSYBL_CHECK(findObject(first, "ElmLne150")._values.at("nlnum") != findObject(modified, "ElmLne150")._values.at("nlnum"));
+    POWSYBL_CHECK(findObject(direct, "ElmLne150")._values == findObject(modified, "ElmLne150")._values);
+}
+
+POWSYBL_TEST(skipsReferencedObjectsOfExcludedSubtrees) {
+    pf::ReadOptions options;
+    options._readReferences = true;
+    // referenced by ElmTerm2, of which it is the previous object
+    options._excludedSubtreePatterns = {"*\\ElmTerm1.ElmTerm"};
+    auto handler = read(SPEC, options);
+
+    std::map<std::string, int> classCounts;
+    for (const auto& e : handler._objects) {
+        POWSYBL_CHECK(e.second._values.at("loc_name") != "ElmTerm1");
+        if (e.second._parentId == -1) {
+            classCounts[e.second._className]++;
+        }
+    }
+    // only the project and the library objects have no parent
+    POWSYBL_CHECK_EQUAL(2, classCounts.size());
+    POWSYBL_CHECK_EQUAL(1, classCounts["IntPrj"]);
+    POWSYBL_CHECK_EQUAL(4, classCounts["TypLne"]);
+}
+
+POWSYBL_TEST(cancelsReadOfReferencedObjects) {
+    // cancels the read as soon as the first library object has been read
+    class CancellingDataObjectHandler : public pf::test::RecordingDataObjectHandler {
+    public:
+        explicit CancellingDataObjectHandler(pf::ReadProgress& progress)
+            : _progress(progress) {
+        }
+
+        void createObject(long id, const std::string& className, long parentId) override {
+            RecordingDataObjectHandler::createObject(id, className, parentId);
+            if (className == "TypLne") {
+                _progress._cancelled = true;
+            }
+        }
+
+    private:
+        pf::ReadProgress& _progress;
+    };
+
+    pf::Api api(SPEC);
+    auto project = api.activateProject("test");
+    pf::SchemaCache schemaCache;
+    pf::ReadProgress progress;
+    pf::ReadOptions options;
+    options._readReferences = true;
+    options._progress = &progress;
+    CancellingDataObjectHandler handler(progress);
+    POWSYBL_CHECK_THROWS(pf::readProject(api, schemaCache, handler, project, options));
+    POWSYBL_CHECK_EQUAL(202, handler._objects.size());
+}
+
+POWSYBL_TEST(readsSameObjectsBreadthFirst) {
+    pf::ReadOptions options;
+    options._breadthFirst = true;
+    auto depthFirst = read(SPEC);
+    auto breadthFirst = read(SPEC, options);
+    POWSYBL_CHECK_EQUAL(depthFirst._objects.size(), breadthFirst._objects.size());
+    // ids are given in traversal order, so objects are matched by name
+    auto getParentName = [](const pf::test::RecordingDataObjectHandler& handler, const pf::test::RecordedObject& object) {
+        return object._parentId == -1 ? std::string() : handler._objects.at(object._parentId)._values.at("loc_name");
+    };
+    for (const auto& e : depthFirst._objects) {
+        const auto& other = findObject(breadthFirst, e.second._values.at("loc_name"));
+        POWSYBL_CHECK_EQUAL(getParentName(depthFirst, e.second), getParentName(breadthFirst, other));
+        for (const auto& value : e.second._values) {
+            if (value.second[0] != '#') {
+                POWSYBL_CHECK_EQUAL(value.second, other._values.at(value.first));
+            }
+        }
+    }
+}
+
+POWSYBL_TEST(resolvesAllowedAttributesOnly) {
+    pf::Api api(SPEC);
+    auto project = api.activateProject("test");
+    pf::SchemaCache schemaCache;
+    std::set<std::string> attributeNames{"loc_name", "unknown"};
+    uint64_t callCount = pf::stub::getCallCount(api._api);
+    const auto& schema = schemaCache.getClassSchema(api, *project, "IntPrj", false, &attributeNames);
+    // one type call per allowed attribute, attributes of the class not being listed
+    POWSYBL_CHECK_EQUAL(2, pf::stub::getCallCount(api._api) - callCount);
+    POWSYBL_CHECK_EQUAL(1, schema._attributes.size());
+    POWSYBL_CHECK_EQUAL("loc_name", schema._attributes[0]._name);
+
+    pf::ReadOptions options;
+    options._attributeNames["ElmLne"] = {"loc_name", "nlnum"};
+    auto handler = read(SPEC, options);
+    const auto& line = findObject(handler, "ElmLne3");
+    POWSYBL_CHECK_EQUAL(2, line._values.size());
+    POWSYBL_CHECK_EQUAL("3", line._values.at("nlnum"));
+    POWSYBL_CHECK(findObject(handler, "ElmTerm1")._values.size() > 2);
+}
+
+POWSYBL_TEST(keepsCachedAttributesWhenAddingDescriptions) {
+    pf::Api api(SPEC);
+    auto project = api.activateProject("test");
+    pf::SchemaCache schemaCache;
+    const auto* attribute = &schemaCache.getClassSchema(api, *project, "IntPrj", false)._attributes.at(0);
+    POWSYBL_CHECK(attribute->_description.empty());
+    // a reader may still hold the attributes of the schema without descriptions
+    const auto& schema = schemaCache.getClassSchema(api, *project, "IntPrj", true);
+    POWSYBL_CHECK(schema._hasDescriptions);
+    POWSYBL_CHECK(attribute == &schema._attributes.at(0));
+    POWSYBL_CHECK_EQUAL("Description of " + attribute->_name, attribute->_description);
+}
+
+POWSYBL_TEST(readsProjectWithoutObjects) {
+    auto handler = read("objects=0");
+    POWSYBL_CHECK_EQUAL(1, handler._objects.size());
+}
+
+POWSYBL_TEST(rejectsInvalidSpecification) {
+    POWSYBL_CHECK_THROWS(pf::Api("objects=ten"));
+    POWSYBL_CHECK_THROWS(pf::Api("unknown=1"));
+    POWSYBL_CHECK_THROWS(pf::Api("matrix=4"));
+}
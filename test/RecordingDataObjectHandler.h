@@ -0,0 +1,243 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file RecordingDataObjectHandler.h
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#ifndef POWSYBL_POWERFACTORY_DB_NATIVE_RECORDINGDATAOBJECTHANDLER_H
+#define POWSYBL_POWERFACTORY_DB_NATIVE_RECORDINGDATAOBJECTHANDLER_H
+
+#include <map>
+#include <set>
+#include <sstream>
+#include "DataObjectHandler.h"
+#include "Test.h"
+#include "v2/Api.hpp"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+namespace test {
+
+struct RecordedObject {
+    std::string _className;
+    long _parentId;
+    // values printed as text, vectors and matrices in brackets
+    std::map<std::string, std::string> _values;
+};
+
+/**
+ * Keeps everything it receives, to compare reads. Checks that classes and attributes are declared once and before
+ * use, and that parents are created before their children.
+ */
+class RecordingDataObjectHandler : public DataObjectHandler {
+public:
+    void createClass(const std::string& name) override {
+        _calls++;
+        POWSYBL_CHECK(_attributes.emplace(name, std::set<std::string>()).second);
+    }
+
+    void createAttribute(const std::string& className, const std::string& attributeName, int, const std::string&) override {
+        _calls++;
+        POWSYBL_CHECK(_attributes.at(className).insert(attributeName).second);
+    }
+
+    void createObject(long id, const std::string& className, long parentId) override {
+        _calls++;
+        POWSYBL_CHECK(_attributes.count(className) == 1);
+        POWSYBL_CHECK(parentId == -1 || _objects.count(parentId) == 1 || _external.count(parentId) == 1);
+        POWSYBL_CHECK(_objects.emplace(id, RecordedObject{className, parentId, {}}).second);
+        _order.push_back(id);
+    }
+
+    void setObjectParent(long id, long parentId) override {
+        _calls++;
+        _objects.at(id)._parentId = parentId;
+    }
+
+    void updateObject(long id) override {
+        _calls++;
+        auto it = _objects.find(id);
+        if (it == _objects.end()) {
+            it = _objects.emplace(id, RecordedObject{_external.at(id), -1, {}}).first;
+        }
+        it->second._values.clear();
+        _updated.insert(id);
+    }
+
+    void deleteObject(long id) override {
+        _calls++;
+        _objects.erase(id);
+        _deleted.insert(id);
+    }
+
+    void setStringAttributeValue(long objectId, const std::string& attributeName, const std::string& value) override {
+        setValue(objectId, attributeName, value);
+    }
+
+    void setIntAttributeValue(long objectId, const std::string& attributeName, int value) override {
+        setValue(objectId, attributeName, toString(value));
+    }
+
+    void setLongAttributeValue(long objectId, const std::string& attributeName, long value) override {
+        setValue(objectId, attributeName, toString(value));
+    }
+
+    void setDoubleAttributeValue(long objectId, const std::string& attributeName, double value) override {
+        setValue(objectId, attributeName, toString(value));
+    }
+
+    void setObjectAttributeValue(long objectId, const std::string& attributeName, long otherObjectId) override {
+        setValue(objectId, attributeName, "#" + toString(otherObjectId));
+    }
+
+    void setIntVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int>& value) override {
+        setValue(objectId, attributeName, toString(value));
+    }
+
+    void setLongVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& value) override {
+        setValue(objectId, attributeName, toString(value));
+    }
+
+    void setDoubleVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<double>& value) override {
+        setValue(objectId, attributeName, toString(value));
+    }
+
+    void setStringVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<std::string>& value) override {
+        setValue(objectId, attributeName, toString(value));
+    }
+
+    void setObjectVectorAttributeValue(long objectId, const std::string& attributeName, const std::vector<int64_t>& otherObjectsIds) override {
+        setValue(objectId, attributeName, "#" + toString(otherObjectsIds));
+    }
+
+    void setDoubleMatrixAttributeValue(long objectId, const std::string& attributeName, int rowCount, int columnCount, const std::vector<double>& value) override {
+        POWSYBL_CHECK((size_t) rowCount * columnCount == value.size());
+        setValue(objectId, attributeName, toString(rowCount) + "x" + toString(columnCount) + toString(value));
+    }
+
+    void flush() override {
+        _flushCount++;
+    }
+
+    // class of objects created by another handler that can be parents or updated, like library objects of a batch
+    // read or objects of a previous read
+    std::map<long, std::string> _external;
+    std::map<std::string, std::set<std::string>> _attributes;
+    std::map<long, RecordedObject> _objects;
+    // creation order
+    std::vector<long> _order;
+    std::set<long> _updated;
+    std::set<long> _deleted;
+    size_t _calls = 0;
+    int _flushCount = 0;
+
+private:
+    template<typename T>
+    static std::string toString(const T& value) {
+        std::ostringstream stream;
+        stream << value;
+        return stream.str();
+    }
+
+    template<typename T>
+    static std::string toString(const std::vector<T>& values) {
+        std::ostringstream stream;
+        stream << "[";
+        for (size_t i = 0; i < values.size(); i++) {
+            stream << (i > 0 ? "," : "") << values[i];
+        }
+        stream << "]";
+        return stream.str();
+    }
+
+    void setValue(long objectId, const std::string& attributeName, const std::string& value) {
+        _calls++;
+        auto& object = _objects.at(objectId);
+        POWSYBL_CHECK(_attributes.at(object._className).count(attributeName) == 1);
+        POWSYBL_CHECK(object._values.emplace(attributeName, value).second);
+    }
+};
+
+/**
+ * Gathers chunked values and records them as if they were set at once.
+ */
+class ChunkedRecordingDataObjectHandler : public RecordingDataObjectHandler {
+public:
+    bool isChunkedValueSupported() const override {
+        return true;
+    }
+
+    void beginAttributeValue(long objectId, const std::string& attributeName, int type, int rowCount, int columnCount) override {
+        _objectId = objectId;
+        _attributeName = attributeName;
+        _type = type;
+        _rowCount = rowCount;
+        _columnCount = columnCount;
+        _ints.clear();
+        _longs.clear();
+        _doubles.clear();
+    }
+
+    void appendIntValues(const int* values, size_t count) override {
+        _chunkCount++;
+        _ints.insert(_ints.end(), values, values + count);
+    }
+
+    void appendLongValues(const int64_t* values, size_t count) override {
+        _chunkCount++;
+        _longs.insert(_longs.end(), values, values + count);
+    }
+
+    void appendDoubleValues(const double* values, size_t count) override {
+        _chunkCount++;
+        _doubles.insert(_doubles.end(), values, values + count);
+    }
+
+    void endAttributeValue() override {
+        switch (_type) {
+            case api::v2::DataObject::AttributeType::TYPE_INTEGER_VEC:
+                setIntVectorAttributeValue(_objectId, _attributeName, _ints);
+                break;
+
+            case api::v2::DataObject::AttributeType::TYPE_INTEGER64_VEC:
+                setLongVectorAttributeValue(_objectId, _attributeName, _longs);
+                break;
+
+            case api::v2::DataObject::AttributeType::TYPE_DOUBLE_VEC:
+                setDoubleVectorAttributeValue(_objectId, _attributeName, _doubles);
+                break;
+
+            case api::v2::DataObject::AttributeType::TYPE_DOUBLE_MAT:
+                setDoubleMatrixAttributeValue(_objectId, _attributeName, _rowCount, _columnCount, _doubles);
+                break;
+
+            default:
+                fail("unexpected chunked type " + std::to_string(_type), __FILE__, __LINE__);
+        }
+    }
+
+    int _chunkCount = 0;
+
+private:
+    long _objectId = -1;
+    std::string _attributeName;
+    int _type = 0;
+    int _rowCount = 0;
+    int _columnCount = 0;
+    std::vector<int> _ints;
+    std::vector<int64_t> _longs;
+    std::vector<double> _doubles;
+};
+
+}
+
+}
+
+}
+
+#endif //POWSYBL_POWERFACTORY_DB_NATIVE_RECORDINGDATAOBJECTHANDLER_H
@@ -0,0 +1,59 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file SessionTest.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include "Session.h"
+#include "StubEngine.h"
+#include "Test.h"
+
+namespace pf = powsybl::powerfactory;
+
+namespace {
+
+const char* const SPEC = "objects=200;depth=3;classes=ElmTerm:2,ElmLne;vector=5;matrix=2x3;library=4";
+
+}
+
+POWSYBL_TEST(findsObjectsByClassFromIndex) {
+    pf::Session session(SPEC);
+    POWSYBL_CHECK_THROWS(session.findByClass("ElmLne"));
+    session.activateProject("test");
+    auto lines = session.findByClass("ElmLne");
+    POWSYBL_CHECK_EQUAL(66, lines.size());
+    for (long id : lines) {
+        POWSYBL_CHECK_EQUAL("ElmLne", session.getClassName(id));
+    }
+
+    // time stamp type and value of the project, without walking its objects again
+    uint64_t callCount = pf::stub::getCallCount(session.getApi()._api);
+    POWSYBL_CHECK_EQUAL(134, session.findByClass("ElmTerm").size());
+    POWSYBL_CHECK(session.findByClass("ElmXnet").empty());
+    POWSYBL_CHECK_EQUAL(4, pf::stub::getCallCount(session.getApi()._api) - callCount);
+
+    // a modified project is indexed again
+    pf::stub::modifyObject(session.getApi()._api, 150);
+    callCount = pf::stub::getCallCount(session.getApi()._api);
+    POWSYBL_CHECK(session.findByClass("ElmLne") == lines);
+    POWSYBL_CHECK(pf::stub::getCallCount(session.getApi()._api) - callCount > 200);
+}
+
+POWSYBL_TEST(keepsClosedSessionAliveForCallsInFlight) {
+    pf::SessionRegistry registry;
+    long handle = registry.open(SPEC);
+    POWSYBL_CHECK(registry.open(SPEC) != handle);
+    POWSYBL_CHECK_THROWS(registry.get(0));
+
+    // a call that got the session before it was closed
+    auto session = registry.get(handle);
+    registry.close(handle);
+    POWSYBL_CHECK_THROWS(registry.get(handle));
+    POWSYBL_CHECK_THROWS(registry.close(handle));
+    session->activateProject("test");
+    POWSYBL_CHECK_EQUAL(66, session->findByClass("ElmLne").size());
+    POWSYBL_CHECK_EQUAL(1, session.use_count());
+}
@@ -0,0 +1,171 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file SnapshotTest.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include "ProjectReader.h"
+#include "RecordingDataObjectHandler.h"
+#include "Snapshot.h"
+#include "Test.h"
+
+namespace pf = powsybl::powerfactory;
+
+namespace {
+
+// large enough for values of some types to span several blocks
+const char* const SPEC = "objects=2000;depth=4;classes=ElmTerm:2,ElmLne;vector=150;matrix=4x5;library=4";
+
+const char* const SNAPSHOT_FILE = "SnapshotTest.pfdb";
+
+const char* const TRUNCATED_SNAPSHOT_FILE = "SnapshotTest-truncated.pfdb";
+
+void read(pf::DataObjectHandler& handler) {
+    pf::Api api(SPEC);
+    auto project = api.activateProject("test");
+    pf::SchemaCache schemaCache;
+    pf::readProject(api, schemaCache, handler, project);
+}
+
+// written once for all tests, reading the project being what takes time
+std::string writeSnapshot() {
+    static bool written = false;
+    if (!written) {
+        pf::SnapshotWriter writer(SNAPSHOT_FILE);
+        read(writer);
+        written = true;
+    }
+    return SNAPSHOT_FILE;
+}
+
+std::string readBytes(const std::string& fileName) {
+    std::ifstream file(fileName, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void writeBytes(const std::string& fileName, const std::string& bytes) {
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    file << bytes;
+}
+
+template<typename T>
+T readRecord(const std::string& bytes, uint64_t offset) {
+    POWSYBL_CHECK(offset + sizeof(T) <= bytes.size());
+    T record;
+    std::memcpy(&record, bytes.data() + offset, sizeof(T));
+    return record;
+}
+
+}
+
+POWSYBL_TEST(replaysWhatWasWritten) {
+    pf::test::RecordingDataObjectHandler direct;
+    read(direct);
+
+    pf::test::RecordingDataObjectHandler replayed;
+    pf::SnapshotReader(writeSnapshot()).read(replayed);
+
+    POWSYBL_CHECK_EQUAL(direct._objects.size(), replayed._objects.size());
+    POWSYBL_CHECK(direct._order == replayed._order);
+    POWSYBL_CHECK(direct._attributes == replayed._attributes);
+    for (const auto& e : direct._objects) {
+        const auto& object = replayed._objects.at(e.first);
+        POWSYBL_CHECK_EQUAL(e.second._className, object._className);
+        POWSYBL_CHECK_EQUAL(e.second._parentId, object._parentId);
+        POWSYBL_CHECK(e.second._values == object._values);
+    }
+    POWSYBL_CHECK_EQUAL(1, replayed._flushCount);
+}
+
+POWSYBL_TEST(alignsSectionsAndRecords) {
+    std::string bytes = readBytes(writeSnapshot());
+
+    auto header = readRecord<pf::SnapshotHeader>(bytes, 0);
+    POWSYBL_CHECK_EQUAL(pf::SNAPSHOT_VERSION, header._version);
+    POWSYBL_CHECK_EQUAL(2001, header._objectCount);
+    for (uint64_t offset : {header._classesOffset, header._attributesOffset, header._objectsOffset, header._blocksOffset}) {
+        POWSYBL_CHECK_EQUAL(0, offset % 8);
+    }
+    POWSYBL_CHECK_EQUAL(header._objectsOffset + header._objectCount * sizeof(pf::SnapshotObject), header._blocksOffset);
+    POWSYBL_CHECK_EQUAL(header._blocksOffset + header._blockCount * sizeof(pf::SnapshotBlock), bytes.size());
+
+    // blocks follow the header back to back, so that values are written as they come
+    std::set<int> types;
+    uint64_t offset = sizeof(pf::SnapshotHeader);
+    for (uint64_t i = 0; i < header._blockCount; i++) {
+        auto block = readRecord<pf::SnapshotBlock>(bytes, header._blocksOffset + i * sizeof(pf::SnapshotBlock));
+        POWSYBL_CHECK_EQUAL(offset, block._offset);
+        POWSYBL_CHECK_EQUAL(0, block._size % 8);
+        POWSYBL_CHECK(block._size < 2 * pf::SNAPSHOT_BLOCK_SIZE);
+        types.insert(block._type);
+        offset += block._size;
+    }
+    POWSYBL_CHECK_EQUAL(header._classesOffset, offset);
+    POWSYBL_CHECK(header._blockCount > types.size());
+}
+
+POWSYBL_TEST(rejectsTruncatedSnapshot) {
+    std::string bytes = readBytes(writeSnapshot());
+    writeBytes(TRUNCATED_SNAPSHOT_FILE, bytes.substr(0, bytes.size() - 100));
+    pf::test::RecordingDataObjectHandler handler;
+    POWSYBL_CHECK_THROWS(pf::SnapshotReader(TRUNCATED_SNAPSHOT_FILE).read(handler));
+
+    // a writer that has not been flushed leaves no valid snapshot
+    {
+        pf::SnapshotWriter writer(TRUNCATED_SNAPSHOT_FILE);
+        writer.createClass("ElmTerm");
+    }
+    pf::test::RecordingDataObjectHandler handler2;
+    POWSYBL_CHECK_THROWS(pf::SnapshotReader(TRUNCATED_SNAPSHOT_FILE).read(handler2));
+    std::remove(TRUNCATED_SNAPSHOT_FILE);
+}
+
+POWSYBL_TEST(reportsProgressAndCancelsReplay) {
+    pf::ReadProgress progress;
+    pf::test::RecordingDataObjectHandler handler;
+    pf::SnapshotReader(writeSnapshot()).read(handler, &progress);
+    POWSYBL_CHECK_EQUAL(2001, progress._objectCount.load());
+    POWSYBL_CHECK(progress._attributeCount.load() > 0);
+
+    progress._cancelled = true;
+    pf::test::RecordingDataObjectHandler cancelled;
+    POWSYBL_CHECK_THROWS(pf::SnapshotReader(writeSnapshot()).read(cancelled, &progress));
+    POWSYBL_CHECK(cancelled._objects.empty());
+}
+
+POWSYBL_TEST(replaysSchemaFirstAndChunkedValues) {
+    // counts schema declarations, the default implementation forwarding them class by class
+    class SchemaRecordingDataObjectHandler : public pf::test::ChunkedRecordingDataObjectHandler {
+    public:
+        void createSchema(const std::vector<pf::ClassSchema>& schemas) override {
+            _schemaCount++;
+            ChunkedRecordingDataObjectHandler::createSchema(schemas);
+        }
+
+        int _schemaCount = 0;
+    };
+
+    pf::test::RecordingDataObjectHandler direct;
+    read(direct);
+
+    pf::ReadOptions options;
+    options._schemaFirst = true;
+    options._chunkSize = 7;
+    SchemaRecordingDataObjectHandler replayed;
+    pf::SnapshotReader(writeSnapshot()).read(replayed, options);
+
+    POWSYBL_CHECK_EQUAL(1, replayed._schemaCount);
+    POWSYBL_CHECK(replayed._chunkCount > 0);
+    POWSYBL_CHECK(direct._attributes == replayed._attributes);
+    for (const auto& e : direct._objects) {
+        POWSYBL_CHECK(e.second._values == replayed._objects.at(e.first)._values);
+    }
+}
@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file Test.h
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#ifndef POWSYBL_POWERFACTORY_DB_NATIVE_TEST_H
+#define POWSYBL_POWERFACTORY_DB_NATIVE_TEST_H
+
+#include <sstream>
+#include <string>
+
+namespace powsybl {
+
+namespace powerfactory {
+
+namespace test {
+
+typedef void (*TestFunction)();
+
+int registerTest(const char* name, TestFunction function);
+
+[[noreturn]] void fail(const std::string& message, const char* file, int line);
+
+template<typename T1, typename T2>
+void checkEqual(const T1& expected, const T2& actual, const char* expression, const char* file, int line) {
+    if (!(expected == actual)) {
+        std::ostringstream message;
+        message << expression << ": expected " << expected << " but was " << actual;
+        fail(message.str(), file, line);
+    }
+}
+
+}
+
+}
+
+}
+
+// defines a test function run by the test main of the executable
+#define POWSYBL_TEST(name) \
+    static void name(); \
+    static const int name##Registration = powsybl::powerfactory::test::registerTest(#name, name); \
+    static void name()
+
+#define POWSYBL_CHECK(condition) \
+    if (!(condition)) powsybl::powerfactory::test::fail("check failed: " #condition, __FILE__, __LINE__)
+
+#define POWSYBL_CHECK_EQUAL(expected, actual) \
+    powsybl::powerfactory::test::checkEqual(expected, actual, #actual, __FILE__, __LINE__)
+
+#define POWSYBL_CHECK_THROWS(statement) \
+    do { \
+        bool thrown = false; \
+        try { statement; } catch (const std::exception&) { thrown = true; } \
+        if (!thrown) powsybl::powerfactory::test::fail("no exception thrown by: " #statement, __FILE__, __LINE__); \
+    } while (false)
+
+#endif //POWSYBL_POWERFACTORY_DB_NATIVE_TEST_H
@@ -0,0 +1,63 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file TestMain.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "Test.h"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+namespace test {
+
+namespace {
+
+std::vector<std::pair<const char*, TestFunction>>& getTests() {
+    static std::vector<std::pair<const char*, TestFunction>> tests;
+    return tests;
+}
+
+}
+
+int registerTest(const char* name, TestFunction function) {
+    getTests().emplace_back(name, function);
+    return (int) getTests().size();
+}
+
+void fail(const std::string& message, const char* file, int line) {
+    throw std::runtime_error(std::string(file) + ":" + std::to_string(line) + ": " + message);
+}
+
+}
+
+}
+
+}
+
+// runs all the tests of the executable, or only the one given as argument
+int main(int argc, char** argv) {
+    int failureCount = 0;
+    for (const auto& test : powsybl::powerfactory::test::getTests()) {
+        if (argc > 1 && std::string(argv[1]) != test.first) {
+            continue;
+        }
+        std::cout << "[ RUN  ] " << test.first << std::endl;
+        try {
+            test.second();
+            std::cout << "[  OK  ] " << test.first << std::endl;
+        } catch (const std::exception& e) {
+            std::cout << "[ FAIL ] " << test.first << ": " << e.what() << std::endl;
+            failureCount++;
+        }
+    }
+    return failureCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,65 @@
+# Copyright (c) 2022, RTE (http://www.rte-france.com)
+# This Source Code Form is subject to the terms of the Mozilla Public
+# License, v. 2.0. If a copy of the MPL was not distributed with this
+# file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+# Reads back with pyarrow the Arrow files written by ArrowWriterTest, usage: arrow_round_trip.py <directory>
+
+import sys
+
+import pyarrow as pa
+
+BATCH_ROW_COUNT = 16
+
+
+def read(directory, class_name):
+    with pa.OSFile(directory + "/" + class_name + ".arrows", "rb") as source:
+        reader = pa.ipc.open_stream(source)
+        batches = list(reader)
+        for batch in batches:
+            assert 0 < batch.num_rows <= BATCH_ROW_COUNT, batch.num_rows
+        return pa.Table.from_batches(batches, reader.schema)
+
+
+def main(directory):
+    projects = read(directory, "IntPrj")
+    terminals = read(directory, "ElmTerm")
+    lines = read(directory, "ElmLne")
+    assert projects.num_rows == 1
+    assert projects.column("parentId").null_count == 1
+    assert terminals.num_rows == 134, terminals.num_rows
+    assert lines.num_rows == 66, lines.num_rows
+
+    assert lines.schema.field("nlnum").type == pa.int32()
+    assert lines.schema.field("tstamp").type == pa.int64()
+    assert lines.schema.field("typ_id").type == pa.int64()
+    assert lines.schema.field("svec").type == pa.list_(pa.field("item", pa.utf8(), nullable=False))
+    assert lines.schema.field("dmat").type == pa.list_(pa.field("item", pa.list_(pa.field("item", pa.float64(), nullable=False)), nullable=False))
+
+    # every object but the project has a parent, read before it
+    ids = set()
+    for table in (projects, terminals, lines):
+        ids.update(table.column("id").to_pylist())
+    assert len(ids) == 201
+    for table in (terminals, lines):
+        assert table.column("parentId").null_count == 0
+        assert set(table.column("parentId").to_pylist()) <= ids
+
+    rows = {row["loc_name"]: row for row in lines.to_pylist()}
+    line = rows["ElmLne3"]
+    assert line["nlnum"] == 3, line
+    assert line["dline"] == 1.5, line
+    assert line["ivec"] == [3, 4, 5, 6, 7], line
+    assert line["dvec"] == [3, 3.25, 3.5, 3.75, 4], line
+    assert line["svec"] == ["s3_0", "s3_1"], line
+    assert line["dmat"] == [[3, 4, 5], [6, 7, 8]], line
+    assert lines.column("typ_id").null_count > 0
+
+    batch = read(directory, "ElmBatch")
+    assert batch.num_rows == BATCH_ROW_COUNT + 1
+    assert batch.column("nlnum").to_pylist() == [0] + [None] * BATCH_ROW_COUNT
+
+
+if __name__ == "__main__":
+    main(sys.argv[1])
+    print("Arrow files of " + sys.argv[1] + " read back")
@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file benchmark.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include "ProjectReader.h"
+#include "StubEngine.h"
+
+namespace pf = powsybl::powerfactory;
+
+namespace {
+
+// only counts what it receives, so that the benchmark measures the engine side of a read
+class CountingDataObjectHandler : public pf::DataObjectHandler {
+public:
+    void createClass(const std::string&) override { _calls++; }
+
+    void createAttribute(const std::string&, const std::string&, int, const std::string&) override { _calls++; }
+
+    void createObject(long, const std::string&, long) override { _calls++; _objects++; }
+
+    void setObjectParent(long, long) override { _calls++; }
+
+    void setStringAttributeValue(long, const std::string&, const std::string&) override { countValue(); }
+
+    void setIntAttributeValue(long, const std::string&, int) override { countValue(); }
+
+    void setLongAttributeValue(long, const std::string&, long) override { countValue(); }
+
+    void setDoubleAttributeValue(long, const std::string&, double) override { countValue(); }
+
+    void setObjectAttributeValue(long, const std::string&, long) override { countValue(); }
+
+    void setIntVectorAttributeValue(long, const std::string&, const std::vector<int>&) override { countValue(); }
+
+    void setLongVectorAttributeValue(long, const std::string&, const std::vector<int64_t>&) override { countValue(); }
+
+    void setDoubleVectorAttributeValue(long, const std::string&, const std::vector<double>&) override { countValue(); }
+
+    void setStringVectorAttributeValue(long, const std::string&, const std::vector<std::string>&) override { countValue(); }
+
+    void setObjectVectorAttributeValue(long, const std::string&, const std::vector<int64_t>&) override { countValue(); }
+
+    void setDoubleMatrixAttributeValue(long, const std::string&, int, int, const std::vector<double>&) override { countValue(); }
+
+    size_t _calls = 0;
+    size_t _objects = 0;
+    size_t _values = 0;
+
+private:
+    void countValue() {
+        _calls++;
+        _values++;
+    }
+};
+
+}
+
+// reads a synthetic project, best of a number of runs, and reports throughput and engine calls per object. Shape of
+// the project is given by a stub engine specification, see StubConfig.
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: " << argv[0] << " <stub engine specification> [run count]" << std::endl;
+        return 2;
+    }
+    try {
+        int runCount = argc == 3 ? std::stoi(argv[2]) : 3;
+        double bestSeconds = -1;
+        for (int run = 0; run < runCount; run++) {
+            // a new engine per run, so that the first run does not warm up the registry of the next ones
+            pf::Api api(argv[1]);
+            auto project = api.activateProject("benchmark");
+            uint64_t startCallCount = pf::stub::getCallCount(api._api);
+
+            pf::SchemaCache schemaCache;
+            CountingDataObjectHandler handler;
+            auto start = std::chrono::steady_clock::now();
+            pf::readProject(api, schemaCache, handler, project);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            uint64_t callCount = pf::stub::getCallCount(api._api) - startCallCount;
+
+            std::cout << "run " << run << ": " << handler._objects << " objects, " << handler._values << " values, "
+                      << seconds << " s, " << (double) callCount / handler._objects << " engine calls/object, "
+                      << (double) handler._calls / handler._objects << " handler calls/object" << std::endl;
+            if (bestSeconds < 0 || seconds < bestSeconds) {
+                bestSeconds = seconds;
+            }
+            if (run == runCount - 1 && bestSeconds > 0) {
+                std::cout << "objects/s: " << handler._objects / bestSeconds << std::endl;
+                std::cout << "attribute reads/s: " << handler._values / bestSeconds << std::endl;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file registry_benchmark.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "ObjectRegistry.h"
+
+namespace pf = powsybl::powerfactory;
+
+// registers objects by batches of the given size, as children lists of a traversal, then looks them all up again.
+// Pointers are fake, the registry never dereferences them.
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <object count> <batch size>" << std::endl;
+        return 2;
+    }
+    size_t objectCount = std::stoul(argv[1]);
+    size_t batchSize = std::stoul(argv[2]);
+    std::vector<api::v2::DataObject*> objects;
+    objects.reserve(objectCount);
+    for (size_t i = 0; i < objectCount; i++) {
+        // spread over the address space like heap allocated proxies
+        objects.push_back(reinterpret_cast<api::v2::DataObject*>((uintptr_t) 0x10000000 + (uintptr_t) i * 48));
+    }
+
+    pf::ObjectRegistry registry;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<api::v2::DataObject*> batch;
+    for (auto object : objects) {
+        batch.push_back(object);
+        if (batch.size() == batchSize) {
+            registry.addAll(batch);
+            batch.clear();
+        }
+    }
+    registry.addAll(batch);
+    double addSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    long idSum = 0;
+    for (auto object : objects) {
+        idSum += registry.find(object);
+    }
+    double findSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "objects: " << registry.size() << " (" << idSum << ")" << std::endl;
+    std::cout << "add (ns/object): " << addSeconds * 1e9 / objectCount << std::endl;
+    std::cout << "find (ns/object): " << findSeconds * 1e9 / objectCount << std::endl;
+    return 0;
+}
@@ -0,0 +1,764 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file StubEngine.cpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include "StubEngine.h"
+
+namespace api {
+
+Value::Value() = default;
+
+Value::Value(const char* value)
+    : _type(STRING),
+      _string(value) {
+}
+
+Value::Value(int value)
+    : _type(INTEGER),
+      _integer(value) {
+}
+
+Value::Value(int64_t value)
+    : _type(INTEGER64),
+      _integer(value) {
+}
+
+Value::Value(double value)
+    : _type(DOUBLE),
+      _double(value) {
+}
+
+Value::Value(v2::DataObject* value)
+    : _type(DATAOBJECT),
+      _object(value) {
+}
+
+namespace {
+
+const Value& at(const std::vector<Value>& values, size_t index, int* error) {
+    static const Value UNKNOWN_VALUE;
+    if (index >= values.size()) {
+        if (error) {
+            *error = 1;
+        }
+        return UNKNOWN_VALUE;
+    }
+    return values[index];
+}
+
+}
+
+Value::Type Value::GetType() const {
+    return _type;
+}
+
+int Value::GetInteger(int*) const {
+    return (int) _integer;
+}
+
+int64_t Value::GetInteger64(int*) const {
+    return _integer;
+}
+
+double Value::GetDouble(int*) const {
+    return _double;
+}
+
+const char* Value::GetString(int*) const {
+    return _string.c_str();
+}
+
+void* Value::GetDataObject(int*) const {
+    return _object;
+}
+
+size_t Value::VecGetSize(int*) const {
+    return _vector.size();
+}
+
+Value::Type Value::VecGetType(size_t index, int* error) const {
+    return at(_vector, index, error)._type;
+}
+
+int Value::VecGetInteger(size_t index, int* error) const {
+    return at(_vector, index, error).GetInteger();
+}
+
+int64_t Value::VecGetInteger64(size_t index, int* error) const {
+    return at(_vector, index, error).GetInteger64();
+}
+
+double Value::VecGetDouble(size_t index, int* error) const {
+    return at(_vector, index, error).GetDouble();
+}
+
+const char* Value::VecGetString(size_t index, int* error) const {
+    return at(_vector, index, error).GetString();
+}
+
+void* Value::VecGetDataObject(size_t index, int* error) const {
+    return at(_vector, index, error).GetDataObject();
+}
+
+size_t Value::MatGetRowCount(int*) const {
+    return _rowCount;
+}
+
+size_t Value::MatGetColCount(int*) const {
+    return _columnCount;
+}
+
+double Value::MatGetDouble(size_t row, size_t column, int* error) const {
+    if (row >= _rowCount || column >= _columnCount) {
+        if (error) {
+            *error = 1;
+        }
+        return 0;
+    }
+    return _matrix[row * _columnCount + column];
+}
+
+}
+
+namespace powsybl {
+
+namespace powerfactory {
+
+namespace stub {
+
+namespace {
+
+typedef api::v2::DataObject DataObject;
+
+struct AttributeDefinition {
+    const char* _name;
+    int _type;
+};
+
+// attributes of objects of the configured classes
+const AttributeDefinition ELEMENT_ATTRIBUTES[] = {
+    {"loc_name", DataObject::TYPE_STRING},
+    {"tstamp", DataObject::TYPE_INTEGER64},
+    {"nlnum", DataObject::TYPE_INTEGER},
+    {"dline", DataObject::TYPE_DOUBLE},
+    {"typ_id", DataObject::TYPE_OBJECT},
+    {"ivec", DataObject::TYPE_INTEGER_VEC},
+    {"lvec", DataObject::TYPE_INTEGER64_VEC},
+    {"dvec", DataObject::TYPE_DOUBLE_VEC},
+    {"svec", DataObject::TYPE_STRING_VEC},
+    {"ovec", DataObject::TYPE_OBJECT_VEC},
+    {"dmat", DataObject::TYPE_DOUBLE_MAT},
+};
+
+// attributes of projects and folders
+const AttributeDefinition CONTAINER_ATTRIBUTES[] = {
+    {"loc_name", DataObject::TYPE_STRING},
+    {"tstamp", DataObject::TYPE_INTEGER64},
+};
+
+// attributes of library objects, each one referencing the next one so that references can be followed at any depth
+const AttributeDefinition LIBRARY_ATTRIBUTES[] = {
+    {"loc_name", DataObject::TYPE_STRING},
+    {"tstamp", DataObject::TYPE_INTEGER64},
+    {"dline", DataObject::TYPE_DOUBLE},
+    {"typ_id", DataObject::TYPE_OBJECT},
+};
+
+class StubEngine;
+
+class StubObject : public DataObject {
+public:
+    enum class Kind {
+        CONTAINER,
+        ELEMENT,
+        LIBRARY,
+    };
+
+    StubObject(StubEngine& engine, Kind kind, std::string className, std::string name, StubObject* parent, size_t index)
+        : _engine(engine),
+          _kind(kind),
+          _className(std::move(className)),
+          _name(std::move(name)),
+          _parent(parent),
+          _index(index) {
+        if (parent) {
+            parent->_children.push_back(this);
+        }
+    }
+
+    const api::Value* GetClassNameA() const override;
+    const api::Value* GetName() const override;
+    const api::Value* GetFullName(int type) const override;
+    DataObject* GetParent() const override;
+    const api::Value* GetChildren(bool recursive) const override;
+    const api::Value* GetAttributeNames() const override;
+    int GetAttributeType(const char* name) const override;
+    const api::Value* GetAttributeDescription(const char* name, bool shortDescription) const override;
+    void GetAttributeSize(const char* name, int& rowCount, int& columnCount, int* error) const override;
+    int GetAttributeInt(const char* name, int* error) const override;
+    int GetAttributeInt(const char* name, int row, int column, int* error) const override;
+    int64_t GetAttributeInt64(const char* name, int* error) const override;
+    int64_t GetAttributeInt64(const char* name, int row, int column, int* error) const override;
+    double GetAttributeDouble(const char* name, int* error) const override;
+    double GetAttributeDouble(const char* name, int row, int column, int* error) const override;
+    DataObject* GetAttributeObject(const char* name, int* error) const override;
+    DataObject* GetAttributeObject(const char* name, int index, int* error) const override;
+    const api::Value* GetAttributeString(const char* name, int* error) const override;
+    const api::Value* GetAttributeString(const char* name, int index, int* error) const override;
+    const api::Value* GetAttribute(const char* name, int* error) const override;
+
+    // the whole value of an attribute, of type UNKNOWN if the attribute does not exist
+    api::Value getValue(const char* name) const;
+
+    void addDescendants(std::vector<api::Value>& descendants, bool recursive) const;
+
+    StubEngine& _engine;
+    const Kind _kind;
+    const std::string _className;
+    const std::string _name;
+    StubObject* const _parent;
+    // index in traversal order, the project being 0, or in the library
+    const size_t _index;
+    std::vector<StubObject*> _children;
+    int64_t _timeStamp = 1;
+    int _modificationCount = 0;
+
+private:
+    std::pair<const AttributeDefinition*, size_t> getAttributes() const;
+
+    int getType(const char* name) const;
+
+    // a cell of a vector or matrix attribute
+    api::Value getCell(const char* name, int row, int column, int* error) const;
+};
+
+class StubApplication : public api::v2::Application {
+public:
+    explicit StubApplication(StubEngine& engine)
+        : _engine(engine) {
+    }
+
+    const api::Value* Execute(const char* command, const api::Value* arguments, int* error) override;
+    DataObject* GetActiveProject() override;
+    DataObject* GetCurrentUser() override;
+
+private:
+    StubEngine& _engine;
+};
+
+class StubEngine : public api::v2::Api {
+public:
+    explicit StubEngine(const StubConfig& config)
+        : _config(config),
+          _application(*this) {
+        _user = newObject(StubObject::Kind::CONTAINER, "IntUser", "stub", nullptr, 0);
+        auto library = newObject(StubObject::Kind::CONTAINER, "IntFolder", "Library", _user, 0);
+        for (size_t i = 0; i < config._libraryObjectCount; i++) {
+            _library.push_back(newObject(StubObject::Kind::LIBRARY, "TypLne", "type" + std::to_string(i), library, i));
+        }
+    }
+
+    api::v2::Application* GetApplication() override {
+        _callCount++;
+        return &_application;
+    }
+
+    void ReleaseValue(const api::Value* value) override {
+        if (value) {
+            _liveValueCount--;
+            delete value;
+        }
+    }
+
+    void ReleaseObject(const DataObject*) override {
+        // objects are owned by the engine
+    }
+
+    const api::Value* newValue(api::Value&& value) {
+        _liveValueCount++;
+        return new api::Value(std::move(value));
+    }
+
+    StubObject* newObject(StubObject::Kind kind, const std::string& className, const std::string& name, StubObject* parent,
+                          size_t index) {
+        _objects.push_back(std::make_unique<StubObject>(*this, kind, className, name, parent, index));
+        return _objects.back().get();
+    }
+
+    // projects are generated on first activation, the same name always giving the same project
+    bool activateProject(const std::string& name) {
+        if (name.empty()) {
+            return false;
+        }
+        auto it = _projects.find(name);
+        if (it == _projects.end()) {
+            it = _projects.emplace(name, generateProject(name)).first;
+        }
+        _activeProject = it->second;
+        return true;
+    }
+
+    StubObject* generateProject(const std::string& name) {
+        auto project = newObject(StubObject::Kind::CONTAINER, "IntPrj", name, _user, 0);
+        // smallest fan out that fits all objects within the maximum depth, objects being numbered breadth first
+        size_t fanOut = 1;
+        while (true) {
+            size_t capacity = 0;
+            size_t levelSize = 1;
+            for (int d = 0; d < std::max(_config._depth, 1); d++) {
+                levelSize *= fanOut;
+                capacity += levelSize;
+            }
+            if (capacity >= _config._objectCount || fanOut >= _config._objectCount) {
+                break;
+            }
+            fanOut++;
+        }
+        std::vector<StubObject*> objects{project};
+        for (size_t i = 1; i <= _config._objectCount; i++) {
+            StubObject* parent = objects[(i - 1) / fanOut];
+            const auto& className = _config._classNames[(i - 1) % _config._classNames.size()];
+            objects.push_back(newObject(StubObject::Kind::ELEMENT, className, className + std::to_string(i), parent, i));
+        }
+        _projectObjects[project] = std::move(objects);
+        return project;
+    }
+
+    const StubConfig _config;
+    StubApplication _application;
+    std::vector<std::unique_ptr<StubObject>> _objects;
+    StubObject* _user;
+    std::vector<StubObject*> _library;
+    std::map<std::string, StubObject*> _projects;
+    std::map<const StubObject*, std::vector<StubObject*>> _projectObjects;
+    StubObject* _activeProject = nullptr;
+    // objects are all created with time stamp 1
+    int64_t _lastTimeStamp = 1;
+    uint64_t _callCount = 0;
+    int64_t _liveValueCount = 0;
+};
+
+const api::Value* StubApplication::Execute(const char* command, const api::Value* arguments, int* error) {
+    _engine._callCount++;
+    if (std::strcmp(command, "ActivateProject") == 0 && arguments) {
+        return _engine.newValue(api::Value(_engine.activateProject(arguments->GetString()) ? 0 : 1));
+    }
+    if (error) {
+        *error = 1;
+    }
+    return _engine.newValue(api::Value(1));
+}
+
+DataObject* StubApplication::GetActiveProject() {
+    _engine._callCount++;
+    return _engine._activeProject;
+}
+
+DataObject* StubApplication::GetCurrentUser() {
+    _engine._callCount++;
+    return _engine._user;
+}
+
+std::pair<const AttributeDefinition*, size_t> StubObject::getAttributes() const {
+    switch (_kind) {
+        case Kind::ELEMENT:
+            return {ELEMENT_ATTRIBUTES, sizeof(ELEMENT_ATTRIBUTES) / sizeof(AttributeDefinition)};
+        case Kind::LIBRARY:
+            return {LIBRARY_ATTRIBUTES, sizeof(LIBRARY_ATTRIBUTES) / sizeof(AttributeDefinition)};
+        default:
+            return {CONTAINER_ATTRIBUTES, sizeof(CONTAINER_ATTRIBUTES) / sizeof(AttributeDefinition)};
+    }
+}
+
+int StubObject::getType(const char* name) const {
+    auto attributes = getAttributes();
+    for (size_t i = 0; i < attributes.second; i++) {
+        if (std::strcmp(attributes.first[i]._name, name) == 0) {
+            return attributes.first[i]._type;
+        }
+    }
+    return TYPE_INVALID;
+}
+
+api::Value StubObject::getValue(const char* name) const {
+    const StubConfig& config = _engine._config;
+    const auto& library = _engine._library;
+    auto i = (int64_t) _index;
+    auto objectValue = [](DataObject* object) {
+        return api::Value(object);
+    };
+    // vectors and matrices of some objects are empty
+    bool empty = config._emptyValueInterval > 0 && i % (int64_t) config._emptyValueInterval == 0;
+    auto vectorValue = [&](const std::function<api::Value(size_t)>& element, size_t size) {
+        api::Value value;
+        value._type = api::Value::VECTOR;
+        for (size_t k = 0; k < (empty ? 0 : size); k++) {
+            value._vector.push_back(element(k));
+        }
+        return value;
+    };
+
+    switch (getType(name)) {
+        case TYPE_STRING:
+            return api::Value(_name.c_str());
+
+        case TYPE_INTEGER64:
+            return api::Value(_timeStamp);
+
+        case TYPE_INTEGER:
+            return api::Value((int) (i % 7 + _modificationCount));
+
+        case TYPE_DOUBLE:
+            return api::Value(_kind == Kind::LIBRARY ? i * 1.5 : i * 0.5);
+
+        case TYPE_OBJECT:
+            if (_kind == Kind::LIBRARY) {
+                return objectValue((size_t) i + 1 < library.size() ? library[i + 1] : nullptr);
+            }
+            // some references are null
+            return objectValue(library.empty() || i % 5 == 0 ? nullptr : library[i % library.size()]);
+
+        case TYPE_INTEGER_VEC:
+            return vectorValue([&](size_t k) { return api::Value((int) (i + k)); }, config._vectorSize);
+
+        case TYPE_INTEGER64_VEC:
+            return vectorValue([&](size_t k) { return api::Value((int64_t) ((i << 32) | (int64_t) k)); }, config._vectorSize);
+
+        case TYPE_DOUBLE_VEC:
+            return vectorValue([&](size_t k) { return api::Value(i + k * 0.25); }, config._vectorSize);
+
+        case TYPE_STRING_VEC:
+            return vectorValue([&](size_t k) { return api::Value(("s" + std::to_string(i) + "_" + std::to_string(k)).c_str()); }, 2);
+
+        case TYPE_OBJECT_VEC: {
+            // parent, previous object of the project, which can be in another subtree, then a library object
+            std::vector<DataObject*> objects{_parent};
+            if (_index > 1) {
+                const StubObject* project = _parent;
+                while (project->_kind == Kind::ELEMENT) {
+                    project = project->_parent;
+                }
+                objects.push_back(_engine._projectObjects.at(project).at(_index - 1));
+            }
+            if (!library.empty()) {
+                objects.push_back(library[(i + 1) % library.size()]);
+            }
+            return vectorValue([&](size_t k) { return api::Value(objects[k]); }, objects.size());
+        }
+
+        case TYPE_DOUBLE_MAT: {
+            api::Value value;
+            value._type = api::Value::MATRIX;
+            value._rowCount = empty ? 0 : config._matrixRowCount;
+            value._columnCount = empty ? 0 : config._matrixColumnCount;
+            for (size_t k = 0; k < value._rowCount * value._columnCount; k++) {
+                value._matrix.push_back((double) (i + k));
+            }
+            return value;
+        }
+
+        default:
+            return api::Value();
+    }
+}
+
+api::Value StubObject::getCell(const char* name, int row, int column, int* error) const {
+    api::Value value = getValue(name);
+    if (value._type == api::Value::VECTOR && row >= 0 && (size_t) row < value._vector.size() && column == 0) {
+        return value._vector[row];
+    }
+    if (value._type == api::Value::MATRIX && row >= 0 && column >= 0 && (size_t) row < value._rowCount
+        && (size_t) column < value._columnCount) {
+        return api::Value(value._matrix[row * value._columnCount + column]);
+    }
+    if (error) {
+        *error = 1;
+    }
+    return api::Value();
+}
+
+const api::Value* StubObject::GetClassNameA() const {
+    _engine._callCount++;
+    return _engine.newValue(api::Value(_className.c_str()));
+}
+
+const api::Value* StubObject::GetName() const {
+    _engine._callCount++;
+    return _engine.newValue(api::Value(_name.c_str()));
+}
+
+const api::Value* StubObject::GetFullName(int) const {
+    _engine._callCount++;
+    std::string fullName = _name + "." + _className;
+    for (auto parent = _parent; parent; parent = parent->_parent) {
+        fullName = parent->_name + "." + parent->_className + "\\" + fullName;
+    }
+    return _engine.newValue(api::Value(("\\" + fullName).c_str()));
+}
+
+DataObject* StubObject::GetParent() const {
+    _engine._callCount++;
+    return _parent;
+}
+
+void StubObject::addDescendants(std::vector<api::Value>& descendants, bool recursive) const {
+    for (auto child : _children) {
+        descendants.emplace_back(static_cast<DataObject*>(child));
+        if (recursive) {
+            child->addDescendants(descendants, true);
+        }
+    }
+}
+
+const api::Value* StubObject::GetChildren(bool recursive) const {
+    _engine._callCount++;
+    api::Value value;
+    value._type = api::Value::VECTOR;
+    addDescendants(value._vector, recursive);
+    return _engine.newValue(std::move(value));
+}
+
+const api::Value* StubObject::GetAttributeNames() const {
+    _engine._callCount++;
+    api::Value value;
+    value._type = api::Value::VECTOR;
+    auto attributes = getAttributes();
+    for (size_t i = 0; i < attributes.second; i++) {
+        value._vector.emplace_back(attributes.first[i]._name);
+    }
+    return _engine.newValue(std::move(value));
+}
+
+int StubObject::GetAttributeType(const char* name) const {
+    _engine._callCount++;
+    return getType(name);
+}
+
+const api::Value* StubObject::GetAttributeDescription(const char* name, bool) const {
+    _engine._callCount++;
+    return _engine.newValue(api::Value((std::string("Description of ") + name).c_str()));
+}
+
+void StubObject::GetAttributeSize(const char* name, int& rowCount, int& columnCount, int* error) const {
+    _engine._callCount++;
+    api::Value value = getValue(name);
+    switch (value._type) {
+        case api::Value::UNKNOWN:
+            rowCount = 0;
+            columnCount = 0;
+            if (error) {
+                *error = 1;
+            }
+            break;
+        case api::Value::VECTOR:
+            rowCount = (int) value._vector.size();
+            columnCount = 1;
+            break;
+        case api::Value::MATRIX:
+            rowCount = (int) value._rowCount;
+            columnCount = (int) value._columnCount;
+            break;
+        default:
+            rowCount = 1;
+            columnCount = 1;
+            break;
+    }
+}
+
+int StubObject::GetAttributeInt(const char* name, int*) const {
+    _engine._callCount++;
+    return getValue(name).GetInteger();
+}
+
+int StubObject::GetAttributeInt(const char* name, int row, int column, int* error) const {
+    _engine._callCount++;
+    return getCell(name, row, column, error).GetInteger();
+}
+
+int64_t StubObject::GetAttributeInt64(const char* name, int*) const {
+    _engine._callCount++;
+    return getValue(name).GetInteger64();
+}
+
+int64_t StubObject::GetAttributeInt64(const char* name, int row, int column, int* error) const {
+    _engine._callCount++;
+    return getCell(name, row, column, error).GetInteger64();
+}
+
+double StubObject::GetAttributeDouble(const char* name, int*) const {
+    _engine._callCount++;
+    return getValue(name).GetDouble();
+}
+
+double StubObject::GetAttributeDouble(const char* name, int row, int column, int* error) const {
+    _engine._callCount++;
+    return getCell(name, row, column, error).GetDouble();
+}
+
+DataObject* StubObject::GetAttributeObject(const char* name, int*) const {
+    _engine._callCount++;
+    return getValue(name)._object;
+}
+
+DataObject* StubObject::GetAttributeObject(const char* name, int index, int* error) const {
+    _engine._callCount++;
+    return getCell(name, index, 0, error)._object;
+}
+
+const api::Value* StubObject::GetAttributeString(const char* name, int* error) const {
+    _engine._callCount++;
+    api::Value value = getValue(name);
+    if (value._type != api::Value::STRING) {
+        if (error) {
+            *error = 1;
+        }
+        return nullptr;
+    }
+    return _engine.newValue(std::move(value));
+}
+
+const api::Value* StubObject::GetAttributeString(const char* name, int index, int* error) const {
+    _engine._callCount++;
+    return _engine.newValue(getCell(name, index, 0, error));
+}
+
+const api::Value* StubObject::GetAttribute(const char* name, int* error) const {
+    _engine._callCount++;
+    api::Value value = getValue(name);
+    if (value._type == api::Value::UNKNOWN) {
+        if (error) {
+            *error = UNKNOWN_ATTRIBUTE_ERROR;
+        }
+        return nullptr;
+    }
+    if (value._type == api::Value::VECTOR || value._type == api::Value::MATRIX) {
+        if (!_engine._config._wholeValues) {
+            if (error) {
+                *error = UNSUPPORTED_VALUE_ERROR;
+            }
+            return nullptr;
+        }
+        // empty vectors and matrices are null values, without error
+        if (value._vector.empty() && value._matrix.empty()) {
+            return nullptr;
+        }
+    }
+    return _engine.newValue(std::move(value));
+}
+
+size_t toSize(const std::string& key, const std::string& value) {
+    try {
+        return (size_t) std::stoull(value);
+    } catch (const std::exception&) {
+        throw std::runtime_error("Invalid stub engine value '" + value + "' for '" + key + "'");
+    }
+}
+
+std::vector<std::string> split(const std::string& str, char separator) {
+    std::vector<std::string> tokens;
+    std::istringstream stream(str);
+    std::string token;
+    while (std::getline(stream, token, separator)) {
+        if (!token.empty()) {
+            tokens.push_back(token);
+        }
+    }
+    return tokens;
+}
+
+}
+
+StubConfig StubConfig::parse(const std::string& spec) {
+    StubConfig config;
+    for (const auto& entry : split(spec, ';')) {
+        size_t equal = entry.find('=');
+        if (equal == std::string::npos) {
+            throw std::runtime_error("Invalid stub engine specification '" + entry + "'");
+        }
+        std::string key = entry.substr(0, equal);
+        std::string value = entry.substr(equal + 1);
+        if (key == "objects") {
+            config._objectCount = toSize(key, value);
+        } else if (key == "depth") {
+            config._depth = (int) toSize(key, value);
+        } else if (key == "classes") {
+            config._classNames.clear();
+            for (const auto& classEntry : split(value, ',')) {
+                size_t colon = classEntry.find(':');
+                size_t weight = colon == std::string::npos ? 1 : toSize(key, classEntry.substr(colon + 1));
+                config._classNames.insert(config._classNames.end(), weight, classEntry.substr(0, colon));
+            }
+            if (config._classNames.empty()) {
+                throw std::runtime_error("No class in stub engine specification");
+            }
+        } else if (key == "vector") {
+            config._vectorSize = toSize(key, value);
+        } else if (key == "matrix") {
+            size_t x = value.find('x');
+            if (x == std::string::npos) {
+                throw std::runtime_error("Invalid stub engine matrix size '" + value + "'");
+            }
+            config._matrixRowCount = toSize(key, value.substr(0, x));
+            config._matrixColumnCount = toSize(key, value.substr(x + 1));
+        } else if (key == "library") {
+            config._libraryObjectCount = toSize(key, value);
+        } else if (key == "whole") {
+            config._wholeValues = toSize(key, value) != 0;
+        } else if (key == "empty") {
+            config._emptyValueInterval = toSize(key, value);
+        } else {
+            throw std::runtime_error("Unknown stub engine parameter '" + key + "'");
+        }
+    }
+    return config;
+}
+
+api::v2::Api* createApi(const std::string& spec) {
+    return new StubEngine(StubConfig::parse(spec));
+}
+
+void destroyApi(api::v2::Api* api) {
+    delete api;
+}
+
+uint64_t getCallCount(const api::v2::Api* api) {
+    return static_cast<const StubEngine*>(api)->_callCount;
+}
+
+int64_t getLiveValueCount(const api::v2::Api* api) {
+    return static_cast<const StubEngine*>(api)->_liveValueCount;
+}
+
+void modifyObject(api::v2::Api* api, size_t index) {
+    auto engine = static_cast<StubEngine*>(api);
+    if (!engine->_activeProject) {
+        throw std::runtime_error("No active project");
+    }
+    auto& objects = engine->_projectObjects.at(engine->_activeProject);
+    if (index >= objects.size()) {
+        throw std::runtime_error("Object " + std::to_string(index) + " not found");
+    }
+    // time stamps come from a single clock, the project one being bumped with the one of any of its objects
+    int64_t timeStamp = ++engine->_lastTimeStamp;
+    objects[index]->_modificationCount++;
+    objects[index]->_timeStamp = timeStamp;
+    engine->_activeProject->_timeStamp = timeStamp;
+}
+
+}
+
+}
+
+}
@@ -0,0 +1,74 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file StubEngine.h
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#ifndef POWSYBL_POWERFACTORY_DB_NATIVE_STUBENGINE_H
+#define POWSYBL_POWERFACTORY_DB_NATIVE_STUBENGINE_H
+
+#include <string>
+#include <vector>
+#include "v2/Api.hpp"
+
+namespace powsybl {
+
+namespace powerfactory {
+
+namespace stub {
+
+/**
+ * Shape of the synthetic projects of the stub engine. It is parsed from a 'key=value;...' specification given in
+ * place of the PowerFactory home directory, so that the JNI entry points and the worker executable can be driven
+ * by it unchanged:
+ *   objects=1000          objects of each project, the project itself excluded
+ *   depth=4               maximum depth of the project tree
+ *   classes=ElmTerm:2,... class of each object in turn, with optional weights
+ *   vector=8              size of vector attributes
+ *   matrix=4x3            size of matrix attributes
+ *   library=16            library objects, outside of projects and referenced by project objects
+ *   whole=1               vectors and matrices can be read in a single call, cell by cell only otherwise
+ *   empty=0               one object out of this number has empty vectors and matrices, read as null values
+ */
+struct StubConfig {
+    size_t _objectCount = 1000;
+    int _depth = 4;
+    std::vector<std::string> _classNames{"ElmTerm", "ElmLne", "ElmLod", "ElmTr2"};
+    size_t _vectorSize = 8;
+    size_t _matrixRowCount = 4;
+    size_t _matrixColumnCount = 3;
+    size_t _libraryObjectCount = 16;
+    bool _wholeValues = true;
+    size_t _emptyValueInterval = 0;
+
+    static StubConfig parse(const std::string& spec);
+};
+
+// errors of DataObject::GetAttribute
+const int UNKNOWN_ATTRIBUTE_ERROR = 1;
+const int UNSUPPORTED_VALUE_ERROR = 2;
+
+api::v2::Api* createApi(const std::string& spec);
+
+void destroyApi(api::v2::Api* api);
+
+// calls to data objects and application since the creation of the engine, value accessors excluded
+uint64_t getCallCount(const api::v2::Api* api);
+
+// values returned by the engine and not released yet
+int64_t getLiveValueCount(const api::v2::Api* api);
+
+// changes the value of an attribute of an object of the active project, given by its index in traversal order, and
+// its modification time stamp, as well as the one of the project that covers all its objects
+void modifyObject(api::v2::Api* api, size_t index);
+
+}
+
+}
+
+}
+
+#endif //POWSYBL_POWERFACTORY_DB_NATIVE_STUBENGINE_H
@@ -0,0 +1,161 @@
+/**
+ * Copyright (c) 2022, RTE (http://www.rte-france.com)
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * @file Api.hpp
+ * @author Geoffroy Jamgotchian <geoffroy.jamgotchian at rte-france.com>
+ */
+#ifndef POWSYBL_POWERFACTORY_DB_NATIVE_STUB_API_HPP
+#define POWSYBL_POWERFACTORY_DB_NATIVE_STUB_API_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Subset of the PowerFactory API v2 header used by the reader, with the same declarations, implemented by the
+ * synthetic engine of StubEngine.cpp. Value internals are specific to the stub.
+ */
+namespace api {
+
+namespace v2 {
+
+class DataObject;
+
+}
+
+class Value {
+public:
+    enum Type {
+        UNKNOWN,
+        INTEGER,
+        INTEGER64,
+        DOUBLE,
+        STRING,
+        DATAOBJECT,
+        VECTOR,
+        MATRIX,
+    };
+
+    Value();
+    explicit Value(const char* value);
+    explicit Value(int value);
+    explicit Value(int64_t value);
+    explicit Value(double value);
+    explicit Value(v2::DataObject* value);
+
+    Type GetType() const;
+
+    int GetInteger(int* error = nullptr) const;
+    int64_t GetInteger64(int* error = nullptr) const;
+    double GetDouble(int* error = nullptr) const;
+    const char* GetString(int* error = nullptr) const;
+    void* GetDataObject(int* error = nullptr) const;
+
+    size_t VecGetSize(int* error = nullptr) const;
+    Type VecGetType(size_t index, int* error = nullptr) const;
+    int VecGetInteger(size_t index, int* error = nullptr) const;
+    int64_t VecGetInteger64(size_t index, int* error = nullptr) const;
+    double VecGetDouble(size_t index, int* error = nullptr) const;
+    const char* VecGetString(size_t index, int* error = nullptr) const;
+    void* VecGetDataObject(size_t index, int* error = nullptr) const;
+
+    size_t MatGetRowCount(int* error = nullptr) const;
+    size_t MatGetColCount(int* error = nullptr) const;
+    double MatGetDouble(size_t row, size_t column, int* error = nullptr) const;
+
+    // stub only
+    Type _type = UNKNOWN;
+    int64_t _integer = 0;
+    double _double = 0;
+    std::string _string;
+    v2::DataObject* _object = nullptr;
+    std::vector<Value> _vector;
+    size_t _rowCount = 0;
+    size_t _columnCount = 0;
+    std::vector<double> _matrix;
+};
+
+namespace v2 {
+
+class ExitError {
+public:
+    explicit ExitError(int code)
+        : _code(code) {
+    }
+
+    int GetCode() const {
+        return _code;
+    }
+
+private:
+    int _code;
+};
+
+class DataObject {
+public:
+    enum AttributeType {
+        TYPE_INVALID = -1,
+        TYPE_INTEGER = 0,
+        TYPE_INTEGER_VEC,
+        TYPE_DOUBLE,
+        TYPE_DOUBLE_VEC,
+        TYPE_DOUBLE_MAT,
+        TYPE_OBJECT,
+        TYPE_OBJECT_VEC,
+        TYPE_STRING,
+        TYPE_STRING_VEC,
+        TYPE_INTEGER64,
+        TYPE_INTEGER64_VEC,
+    };
+
+    virtual ~DataObject() = default;
+
+    virtual const Value* GetClassNameA() const = 0;
+    virtual const Value* GetName() const = 0;
+    virtual const Value* GetFullName(int type = 0) const = 0;
+    virtual DataObject* GetParent() const = 0;
+    virtual const Value* GetChildren(bool recursive) const = 0;
+    virtual const Value* GetAttributeNames() const = 0;
+    virtual int GetAttributeType(const char* name) const = 0;
+    virtual const Value* GetAttributeDescription(const char* name, bool shortDescription = false) const = 0;
+    virtual void GetAttributeSize(const char* name, int& rowCount, int& columnCount, int* error = nullptr) const = 0;
+    virtual int GetAttributeInt(const char* name, int* error = nullptr) const = 0;
+    virtual int GetAttributeInt(const char* name, int row, int column, int* error = nullptr) const = 0;
+    virtual int64_t GetAttributeInt64(const char* name, int* error = nullptr) const = 0;
+    virtual int64_t GetAttributeInt64(const char* name, int row, int column, int* error = nullptr) const = 0;
+    virtual double GetAttributeDouble(const char* name, int* error = nullptr) const = 0;
+    virtual double GetAttributeDouble(const char* name, int row, int column, int* error = nullptr) const = 0;
+    virtual DataObject* GetAttributeObject(const char* name, int* error = nullptr) const = 0;
+    virtual DataObject* GetAttributeObject(const char* name, int index, int* error = nullptr) const = 0;
+    virtual const Value* GetAttributeString(const char* name, int* error = nullptr) const = 0;
+    virtual const Value* GetAttributeString(const char* name, int index, int* error = nullptr) const = 0;
+    virtual const Value* GetAttribute(const char* name, int* error = nullptr) const = 0;
+};
+
+class Application {
+public:
+    virtual ~Application() = default;
+
+    virtual const Value* Execute(const char* command, const Value* arguments, int* error = nullptr) = 0;
+    virtual DataObject* GetActiveProject() = 0;
+    virtual DataObject* GetCurrentUser() = 0;
+};
+
+class Api {
+public:
+    virtual ~Api() = default;
+
+    virtual Application* GetApplication() = 0;
+    virtual void ReleaseValue(const Value* value) = 0;
+    virtual void ReleaseObject(const DataObject* object) = 0;
+};
+
+}
+
+}
+
+#endif //POWSYBL_POWERFACTORY_DB_NATIVE_STUB_API_HPP